@@ -0,0 +1,269 @@
+#include "expression_evaluator.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Converts a value to another data type. Numbers are converted like static_cast and strings are parsed like type_cast.
+template <typename To, typename From>
+To convert_value(const From& value) {
+  if constexpr (std::is_same_v<To, From>) {
+    return value;
+  } else if constexpr (std::is_same_v<To, std::string>) {
+    return boost::lexical_cast<std::string>(value);
+  } else if constexpr (!std::is_same_v<From, std::string>) {
+    return static_cast<To>(value);
+  } else if constexpr (std::is_integral_v<To>) {
+    try {
+      return boost::lexical_cast<To>(value);
+    } catch (...) {
+      return boost::numeric_cast<To>(boost::lexical_cast<double>(value));
+    }
+  } else {
+    return boost::lexical_cast<To>(value);
+  }
+}
+
+template <typename To, typename From>
+pmr_vector<To> convert_values(pmr_vector<From>&& values, const PolymorphicAllocator<To>& allocator) {
+  if constexpr (std::is_same_v<To, From>) {
+    // only copies the values if they were allocated using another allocator
+    return pmr_vector<To>(std::move(values), allocator);
+  } else {
+    auto converted_values = pmr_vector<To>(allocator);
+    converted_values.reserve(values.size());
+    for (const auto& value : values) {
+      converted_values.push_back(convert_value<To>(value));
+    }
+    return converted_values;
+  }
+}
+
+// calls the functor with the comparison function object that implements the scan type
+template <typename Functor>
+void resolve_comparator(const ScanType scan_type, const Functor& functor) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      functor(std::equal_to<>{});
+      break;
+    case ScanType::OpNotEquals:
+      functor(std::not_equal_to<>{});
+      break;
+    case ScanType::OpLessThan:
+      functor(std::less<>{});
+      break;
+    case ScanType::OpLessThanEquals:
+      functor(std::less_equal<>{});
+      break;
+    case ScanType::OpGreaterThan:
+      functor(std::greater<>{});
+      break;
+    case ScanType::OpGreaterThanEquals:
+      functor(std::greater_equal<>{});
+      break;
+  }
+}
+
+// Computes lhs[i] = operation(lhs[i], rhs[i]) for all rows. Integers are computed in their unsigned type, so that an
+// overflow wraps around instead of being undefined.
+template <typename T, typename Operation>
+void apply_wrapping_operation(pmr_vector<T>& lhs, const pmr_vector<T>& rhs, const Operation& operation) {
+  const auto size = lhs.size();
+  for (auto index = size_t{0}; index < size; ++index) {
+    if constexpr (std::is_integral_v<T>) {
+      using Unsigned = std::make_unsigned_t<T>;
+      lhs[index] = static_cast<T>(operation(static_cast<Unsigned>(lhs[index]), static_cast<Unsigned>(rhs[index])));
+    } else {
+      lhs[index] = operation(lhs[index], rhs[index]);
+    }
+  }
+}
+
+// Computes lhs[i] = lhs[i] operator rhs[i] for all rows. Integer division and modulo by zero yield 0. Integer
+// overflows wrap around, e.g., the smallest integer divided by -1 stays the smallest integer.
+template <typename T>
+void apply_arithmetic_operator(const ArithmeticOperator arithmetic_operator, pmr_vector<T>& lhs,
+                               const pmr_vector<T>& rhs) {
+  const auto size = lhs.size();
+  switch (arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      apply_wrapping_operation(lhs, rhs, std::plus<>{});
+      break;
+    case ArithmeticOperator::Subtraction:
+      apply_wrapping_operation(lhs, rhs, std::minus<>{});
+      break;
+    case ArithmeticOperator::Multiplication:
+      apply_wrapping_operation(lhs, rhs, std::multiplies<>{});
+      break;
+    case ArithmeticOperator::Division:
+      for (auto index = size_t{0}; index < size; ++index) {
+        if constexpr (std::is_integral_v<T>) {
+          if (rhs[index] == 0) {
+            lhs[index] = 0;
+          } else if (rhs[index] == -1) {
+            // the division would trap for the smallest integer, the unsigned negation wraps around instead
+            lhs[index] = static_cast<T>(std::make_unsigned_t<T>{0} - static_cast<std::make_unsigned_t<T>>(lhs[index]));
+          } else {
+            lhs[index] /= rhs[index];
+          }
+        } else {
+          lhs[index] /= rhs[index];
+        }
+      }
+      break;
+    case ArithmeticOperator::Modulo:
+      for (auto index = size_t{0}; index < size; ++index) {
+        if constexpr (std::is_integral_v<T>) {
+          // x % -1 is always 0, but traps for the smallest integer like the division
+          lhs[index] = rhs[index] != 0 && rhs[index] != -1 ? lhs[index] % rhs[index] : 0;
+        } else {
+          lhs[index] = std::fmod(lhs[index], rhs[index]);
+        }
+      }
+      break;
+  }
+}
+
+}  // namespace
+
+ExpressionEvaluator::ExpressionEvaluator(const std::shared_ptr<const Table>& table, const ChunkID chunk_id)
+    : ExpressionEvaluator(table, table->get_chunk(chunk_id)) {}
+
+ExpressionEvaluator::ExpressionEvaluator(const std::shared_ptr<const Table>& table, const Chunk& chunk)
+    : _table(table), _chunk(chunk), _row_count(chunk.size()) {}
+
+template <typename T>
+pmr_vector<T> ExpressionEvaluator::evaluate(const AbstractExpression& expression,
+                                            const PolymorphicAllocator<T>& allocator) const {
+  const auto& arguments = expression.arguments();
+  auto result = pmr_vector<T>(allocator);
+
+  switch (expression.type()) {
+    case ExpressionType::Column: {
+      const auto column_id = static_cast<const ColumnExpression&>(expression).column_id();
+      const auto segment = _chunk.get_segment(column_id);
+      result.reserve(_row_count);
+      resolve_data_type(_table->column_type(column_id), [&](auto type) {
+        using ColumnType = typename decltype(type)::type;
+        segment_iterate<ColumnType>(*segment, [&](const ChunkOffset, const ColumnType& value) {
+          result.push_back(convert_value<T>(value));
+        });
+      });
+      break;
+    }
+
+    case ExpressionType::Value: {
+      const auto& value = static_cast<const ValueExpression&>(expression).value();
+      resolve_data_type(expression.data_type(*_table), [&](auto type) {
+        using ValueType = typename decltype(type)::type;
+        result.assign(_row_count, convert_value<T>(boost::get<ValueType>(value)));
+      });
+      break;
+    }
+
+    case ExpressionType::Arithmetic: {
+      // the operands are computed in the data type of the expression, which may differ from T
+      const auto arithmetic_operator = static_cast<const ArithmeticExpression&>(expression).arithmetic_operator();
+      resolve_data_type(expression.data_type(*_table), [&](auto type) {
+        using ResultType = typename decltype(type)::type;
+        if constexpr (!std::is_same_v<ResultType, std::string>) {
+          auto lhs = evaluate<ResultType>(*arguments[0]);
+          const auto rhs = evaluate<ResultType>(*arguments[1]);
+          apply_arithmetic_operator(arithmetic_operator, lhs, rhs);
+          result = convert_values<T>(std::move(lhs), allocator);
+        }
+      });
+      break;
+    }
+
+    case ExpressionType::Comparison: {
+      const auto left_type = arguments[0]->data_type(*_table);
+      const auto right_type = arguments[1]->data_type(*_table);
+      const auto comparison_type = left_type == "string" ? left_type : wider_numeric_type(left_type, right_type);
+      const auto scan_type = static_cast<const ComparisonExpression&>(expression).scan_type();
+
+      auto matches = pmr_vector<int32_t>(_row_count);
+      resolve_data_type(comparison_type, [&](auto type) {
+        using ComparisonType = typename decltype(type)::type;
+        const auto lhs = evaluate<ComparisonType>(*arguments[0]);
+        const auto rhs = evaluate<ComparisonType>(*arguments[1]);
+        resolve_comparator(scan_type, [&](auto compare) {
+          for (auto index = size_t{0}; index < _row_count; ++index) {
+            matches[index] = compare(lhs[index], rhs[index]);
+          }
+        });
+      });
+      result = convert_values<T>(std::move(matches), allocator);
+      break;
+    }
+
+    case ExpressionType::Case: {
+      // All results are computed for all rows. Going through the clauses backwards, each clause overwrites the rows
+      // that satisfy its condition, so that the first clause that holds determines the result of a row.
+      const auto clause_count = static_cast<const CaseExpression&>(expression).when_then_clause_count();
+      resolve_data_type(expression.data_type(*_table), [&](auto type) {
+        using ResultType = typename decltype(type)::type;
+        auto results = evaluate<ResultType>(*arguments.back());
+        for (auto clause_index = clause_count; clause_index-- > 0;) {
+          const auto conditions = _evaluate_condition(*arguments[clause_index * 2]);
+          auto then_results = evaluate<ResultType>(*arguments[clause_index * 2 + 1]);
+          for (auto index = size_t{0}; index < _row_count; ++index) {
+            if (conditions[index]) results[index] = std::move(then_results[index]);
+          }
+        }
+        result = convert_values<T>(std::move(results), allocator);
+      });
+      break;
+    }
+
+    case ExpressionType::Cast: {
+      resolve_data_type(expression.data_type(*_table), [&](auto type) {
+        using CastType = typename decltype(type)::type;
+        result = convert_values<T>(evaluate<CastType>(*arguments[0]), allocator);
+      });
+      break;
+    }
+  }
+
+  return result;
+}
+
+std::vector<uint8_t> ExpressionEvaluator::_evaluate_condition(const AbstractExpression& expression) const {
+  auto conditions = std::vector<uint8_t>(_row_count);
+  resolve_data_type(expression.data_type(*_table), [&](auto type) {
+    using ConditionType = typename decltype(type)::type;
+    if constexpr (std::is_same_v<ConditionType, std::string>) {
+      Fail("Conditions must be numeric, but " + expression.description(*_table) + " is a string");
+    } else {
+      const auto values = evaluate<ConditionType>(expression);
+      for (auto index = size_t{0}; index < _row_count; ++index) {
+        conditions[index] = values[index] != 0;
+      }
+    }
+  });
+  return conditions;
+}
+
+#define EXPLICITLY_INSTANTIATE_EVALUATE(r, data, type)                                                 \
+  template pmr_vector<type> ExpressionEvaluator::evaluate<type>(const AbstractExpression& expression, \
+                                                                const PolymorphicAllocator<type>& allocator) const;
+BOOST_PP_SEQ_FOR_EACH(EXPLICITLY_INSTANTIATE_EVALUATE, _, data_types_macro)
+
+}  // namespace opossum
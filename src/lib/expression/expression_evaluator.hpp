@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "expressions.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+// ExpressionEvaluator computes the values of expressions for all rows of a chunk. Each node of an expression tree is
+// evaluated for the whole chunk at once into a vector of its own data type, so that the data type is resolved once
+// per node and the loops over the rows work on plain typed vectors instead of AllTypeVariants.
+class ExpressionEvaluator {
+ public:
+  ExpressionEvaluator(const std::shared_ptr<const Table>& table, const ChunkID chunk_id);
+
+  // evaluates the expressions for a chunk that is not part of the table, but has the same columns, e.g., in a Pipeline
+  ExpressionEvaluator(const std::shared_ptr<const Table>& table, const Chunk& chunk);
+
+  // Returns the values of the expression for all rows of the chunk, converted to T if the expression has another data
+  // type. The values are allocated using the given allocator, e.g., from the arena of an output chunk.
+  template <typename T>
+  pmr_vector<T> evaluate(const AbstractExpression& expression, const PolymorphicAllocator<T>& allocator = {}) const;
+
+ protected:
+  // returns 1 for each row for which the numeric condition is not 0, and 0 otherwise
+  std::vector<uint8_t> _evaluate_condition(const AbstractExpression& expression) const;
+
+  const std::shared_ptr<const Table> _table;
+  const Chunk& _chunk;
+  const ChunkOffset _row_count;
+};
+
+}  // namespace opossum
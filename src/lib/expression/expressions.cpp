@@ -0,0 +1,196 @@
+#include "expressions.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the numeric types ordered from narrowest to widest
+const auto NUMERIC_TYPES = std::vector<std::string>{"int", "long", "float", "double"};
+
+size_t numeric_type_rank(const std::string& data_type) {
+  const auto iter = std::find(NUMERIC_TYPES.cbegin(), NUMERIC_TYPES.cend(), data_type);
+  Assert(iter != NUMERIC_TYPES.cend(), "Expected a numeric argument, got " + data_type);
+  return static_cast<size_t>(std::distance(NUMERIC_TYPES.cbegin(), iter));
+}
+
+std::string arithmetic_operator_symbol(const ArithmeticOperator arithmetic_operator) {
+  switch (arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      return "+";
+    case ArithmeticOperator::Subtraction:
+      return "-";
+    case ArithmeticOperator::Multiplication:
+      return "*";
+    case ArithmeticOperator::Division:
+      return "/";
+    case ArithmeticOperator::Modulo:
+      break;
+  }
+  return "%";
+}
+
+std::vector<std::shared_ptr<const AbstractExpression>> case_arguments(
+    const std::vector<CaseExpression::WhenThenClause>& when_then_clauses,
+    const std::shared_ptr<const AbstractExpression>& otherwise) {
+  auto arguments = std::vector<std::shared_ptr<const AbstractExpression>>{};
+  for (const auto& [when, then] : when_then_clauses) {
+    arguments.emplace_back(when);
+    arguments.emplace_back(then);
+  }
+  arguments.emplace_back(otherwise);
+  return arguments;
+}
+
+}  // namespace
+
+std::string scan_type_symbol(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return "=";
+    case ScanType::OpNotEquals:
+      return "!=";
+    case ScanType::OpLessThan:
+      return "<";
+    case ScanType::OpLessThanEquals:
+      return "<=";
+    case ScanType::OpGreaterThan:
+      return ">";
+    case ScanType::OpGreaterThanEquals:
+      break;
+  }
+  return ">=";
+}
+
+AbstractExpression::AbstractExpression(const ExpressionType type,
+                                       std::vector<std::shared_ptr<const AbstractExpression>> arguments)
+    : _type(type), _arguments(std::move(arguments)) {}
+
+ExpressionType AbstractExpression::type() const { return _type; }
+
+const std::vector<std::shared_ptr<const AbstractExpression>>& AbstractExpression::arguments() const {
+  return _arguments;
+}
+
+ColumnExpression::ColumnExpression(const ColumnID column_id)
+    : AbstractExpression(ExpressionType::Column), _column_id(column_id) {}
+
+ColumnID ColumnExpression::column_id() const { return _column_id; }
+
+std::string ColumnExpression::data_type(const Table& table) const { return table.column_type(_column_id); }
+
+std::string ColumnExpression::description(const Table& table) const { return table.column_name(_column_id); }
+
+ValueExpression::ValueExpression(const AllTypeVariant& value)
+    : AbstractExpression(ExpressionType::Value), _value(value) {}
+
+const AllTypeVariant& ValueExpression::value() const { return _value; }
+
+std::string ValueExpression::data_type(const Table&) const {
+  auto type_string = std::string{};
+  auto index = 0;
+  hana::for_each(data_types, [&](auto x) {
+    if (index++ == _value.which()) type_string = hana::first(x);
+  });
+  return type_string;
+}
+
+std::string ValueExpression::description(const Table& table) const {
+  const auto value_string = boost::lexical_cast<std::string>(_value);
+  return data_type(table) == "string" ? "'" + value_string + "'" : value_string;
+}
+
+ArithmeticExpression::ArithmeticExpression(const ArithmeticOperator arithmetic_operator,
+                                           const std::shared_ptr<const AbstractExpression>& left,
+                                           const std::shared_ptr<const AbstractExpression>& right)
+    : AbstractExpression(ExpressionType::Arithmetic, {left, right}), _arithmetic_operator(arithmetic_operator) {}
+
+ArithmeticOperator ArithmeticExpression::arithmetic_operator() const { return _arithmetic_operator; }
+
+std::string ArithmeticExpression::data_type(const Table& table) const {
+  return wider_numeric_type(_arguments[0]->data_type(table), _arguments[1]->data_type(table));
+}
+
+std::string ArithmeticExpression::description(const Table& table) const {
+  return "(" + _arguments[0]->description(table) + " " + arithmetic_operator_symbol(_arithmetic_operator) + " " +
+         _arguments[1]->description(table) + ")";
+}
+
+ComparisonExpression::ComparisonExpression(const ScanType scan_type,
+                                           const std::shared_ptr<const AbstractExpression>& left,
+                                           const std::shared_ptr<const AbstractExpression>& right)
+    : AbstractExpression(ExpressionType::Comparison, {left, right}), _scan_type(scan_type) {}
+
+ScanType ComparisonExpression::scan_type() const { return _scan_type; }
+
+std::string ComparisonExpression::data_type(const Table& table) const {
+  const auto left_type = _arguments[0]->data_type(table);
+  const auto right_type = _arguments[1]->data_type(table);
+  Assert((left_type == "string") == (right_type == "string"), "Cannot compare strings with numbers");
+  return "int";
+}
+
+std::string ComparisonExpression::description(const Table& table) const {
+  return "(" + _arguments[0]->description(table) + " " + scan_type_symbol(_scan_type) + " " +
+         _arguments[1]->description(table) + ")";
+}
+
+CaseExpression::CaseExpression(const std::vector<WhenThenClause>& when_then_clauses,
+                               const std::shared_ptr<const AbstractExpression>& otherwise)
+    : AbstractExpression(ExpressionType::Case, case_arguments(when_then_clauses, otherwise)) {
+  Assert(!when_then_clauses.empty(), "CASE needs at least one WHEN clause");
+}
+
+size_t CaseExpression::when_then_clause_count() const { return _arguments.size() / 2; }
+
+std::string CaseExpression::data_type(const Table& table) const {
+  auto result_type = _arguments.back()->data_type(table);
+  for (auto clause_index = size_t{0}; clause_index < when_then_clause_count(); ++clause_index) {
+    // conditions are numbers
+    numeric_type_rank(_arguments[clause_index * 2]->data_type(table));
+
+    const auto then_type = _arguments[clause_index * 2 + 1]->data_type(table);
+    Assert((then_type == "string") == (result_type == "string"), "CASE cannot mix string and numeric results");
+    if (result_type != "string") result_type = wider_numeric_type(result_type, then_type);
+  }
+  return result_type;
+}
+
+std::string CaseExpression::description(const Table& table) const {
+  auto description = std::string{"CASE"};
+  for (auto clause_index = size_t{0}; clause_index < when_then_clause_count(); ++clause_index) {
+    description += " WHEN " + _arguments[clause_index * 2]->description(table) + " THEN " +
+                   _arguments[clause_index * 2 + 1]->description(table);
+  }
+  return description + " ELSE " + _arguments.back()->description(table) + " END";
+}
+
+CastExpression::CastExpression(const std::shared_ptr<const AbstractExpression>& argument, const std::string& data_type)
+    : AbstractExpression(ExpressionType::Cast, {argument}), _data_type(data_type) {
+  Assert(std::find(NUMERIC_TYPES.cbegin(), NUMERIC_TYPES.cend(), data_type) != NUMERIC_TYPES.cend() ||
+             data_type == "string",
+         "Unknown data type " + data_type);
+}
+
+std::string CastExpression::data_type(const Table&) const { return _data_type; }
+
+std::string CastExpression::description(const Table& table) const {
+  return "CAST(" + _arguments[0]->description(table) + " AS " + _data_type + ")";
+}
+
+std::string wider_numeric_type(const std::string& lhs, const std::string& rhs) {
+  return NUMERIC_TYPES[std::max(numeric_type_rank(lhs), numeric_type_rank(rhs))];
+}
+
+}  // namespace opossum
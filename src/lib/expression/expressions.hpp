@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+enum class ExpressionType { Column, Value, Arithmetic, Comparison, Case, Cast };
+
+enum class ArithmeticOperator { Addition, Subtraction, Multiplication, Division, Modulo };
+
+// AbstractExpression is the super class of the nodes of an expression tree, which computes one value per row of a
+// table (see ExpressionEvaluator). Expressions do not know the table they are evaluated on, so that their data types
+// and descriptions are determined for a given table.
+//
+// There are no NULL values, thus numbers are combined with the rules of C++: arithmetic and CASE yield the widest of
+// their numeric argument types (int < long < float < double), and integer division or modulo by zero yields 0.
+// Comparisons yield an int that is 1 if they hold, a number is true in a condition if it is not 0.
+class AbstractExpression {
+ public:
+  explicit AbstractExpression(const ExpressionType type,
+                              std::vector<std::shared_ptr<const AbstractExpression>> arguments = {});
+
+  virtual ~AbstractExpression() = default;
+
+  ExpressionType type() const;
+  const std::vector<std::shared_ptr<const AbstractExpression>>& arguments() const;
+
+  // returns the type string of the values of the expression, e.g., "int"
+  virtual std::string data_type(const Table& table) const = 0;
+
+  // returns a human-readable representation, e.g., "(a + 1)", which projections use as column name
+  virtual std::string description(const Table& table) const = 0;
+
+ protected:
+  const ExpressionType _type;
+  const std::vector<std::shared_ptr<const AbstractExpression>> _arguments;
+};
+
+// the values of a column of the table
+class ColumnExpression : public AbstractExpression {
+ public:
+  explicit ColumnExpression(const ColumnID column_id);
+
+  ColumnID column_id() const;
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const ColumnID _column_id;
+};
+
+// a literal, which has the same value for all rows
+class ValueExpression : public AbstractExpression {
+ public:
+  explicit ValueExpression(const AllTypeVariant& value);
+
+  const AllTypeVariant& value() const;
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const AllTypeVariant _value;
+};
+
+// left operator right, for numeric arguments only
+class ArithmeticExpression : public AbstractExpression {
+ public:
+  ArithmeticExpression(const ArithmeticOperator arithmetic_operator,
+                       const std::shared_ptr<const AbstractExpression>& left,
+                       const std::shared_ptr<const AbstractExpression>& right);
+
+  ArithmeticOperator arithmetic_operator() const;
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const ArithmeticOperator _arithmetic_operator;
+};
+
+// Compares two numbers or two strings. Numbers of different types are compared as the wider type.
+class ComparisonExpression : public AbstractExpression {
+ public:
+  ComparisonExpression(const ScanType scan_type, const std::shared_ptr<const AbstractExpression>& left,
+                       const std::shared_ptr<const AbstractExpression>& right);
+
+  ScanType scan_type() const;
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const ScanType _scan_type;
+};
+
+// CASE WHEN condition THEN result ... ELSE otherwise END. The results either are all numbers or all strings. The
+// arguments are the conditions and results in turn, followed by the ELSE result.
+class CaseExpression : public AbstractExpression {
+ public:
+  using WhenThenClause =
+      std::pair<std::shared_ptr<const AbstractExpression>, std::shared_ptr<const AbstractExpression>>;
+
+  CaseExpression(const std::vector<WhenThenClause>& when_then_clauses,
+                 const std::shared_ptr<const AbstractExpression>& otherwise);
+
+  size_t when_then_clause_count() const;
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+};
+
+// CAST(argument AS data_type). Numbers are converted like static_cast, strings are parsed like type_cast.
+class CastExpression : public AbstractExpression {
+ public:
+  CastExpression(const std::shared_ptr<const AbstractExpression>& argument, const std::string& data_type);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const std::string _data_type;
+};
+
+// returns the wider of two numeric data types, e.g., "double" for "int" and "double"
+std::string wider_numeric_type(const std::string& lhs, const std::string& rhs);
+
+// returns the symbol of the comparison, e.g., ">=", which is also used to describe scans and joins
+std::string scan_type_symbol(const ScanType scan_type);
+
+}  // namespace opossum
@@ -0,0 +1,112 @@
+#include "abstract_join.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/expressions.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+std::string join_mode_name(const JoinMode mode) {
+  switch (mode) {
+    case JoinMode::Inner:
+      return "Inner";
+    case JoinMode::Left:
+      return "Left";
+    case JoinMode::Semi:
+      return "Semi";
+    case JoinMode::Anti:
+      break;
+  }
+  return "Anti";
+}
+
+}  // namespace
+
+AbstractJoin::AbstractJoin(const std::shared_ptr<const AbstractOperator> left,
+                           const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                           const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
+    : AbstractOperator(left, right), _mode(mode), _column_ids(column_ids), _scan_type(scan_type) {}
+
+JoinMode AbstractJoin::mode() const { return _mode; }
+
+const std::pair<ColumnID, ColumnID>& AbstractJoin::column_ids() const { return _column_ids; }
+
+ScanType AbstractJoin::scan_type() const { return _scan_type; }
+
+std::string AbstractJoin::description() const {
+  return name() + " " + join_mode_name(_mode) + " #" + std::to_string(_column_ids.first) + " " +
+         scan_type_symbol(_scan_type) + " #" + std::to_string(_column_ids.second);
+}
+
+bool AbstractJoin::is_cacheable() const { return true; }
+
+std::shared_ptr<Table> AbstractJoin::_initialize_output_table() const {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+  Assert(left_table->column_type(_column_ids.first) == right_table->column_type(_column_ids.second),
+         "Join columns must have the same type");
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < left_table->column_count(); ++column_id) {
+    output_table->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id));
+  }
+  if (_mode == JoinMode::Semi || _mode == JoinMode::Anti) return output_table;
+
+  for (auto column_id = ColumnID{0}; column_id < right_table->column_count(); ++column_id) {
+    output_table->add_column_definition(right_table->column_name(column_id), right_table->column_type(column_id));
+  }
+  return output_table;
+}
+
+void AbstractJoin::_append_output_chunk(Table& output_table, const std::shared_ptr<const PosList>& left_pos_list,
+                                        const std::shared_ptr<const PosList>& right_pos_list) const {
+  auto output_chunk = Chunk{};
+  append_reference_segments(output_chunk, _input_table_left(), left_pos_list, _arena);
+  if (_mode != JoinMode::Semi && _mode != JoinMode::Anti) {
+    DebugAssert(left_pos_list->size() == right_pos_list->size(), "Both sides of a join result must have the same size");
+    append_reference_segments(output_chunk, _input_table_right(), right_pos_list, _arena);
+  }
+  output_table.emplace_chunk(std::move(output_chunk));
+}
+
+void AbstractJoin::_append_null_key_rows(Table& output_table,
+                                         const std::vector<std::vector<RowID>>& null_key_rows) const {
+  if (_mode != JoinMode::Left && _mode != JoinMode::Anti) return;
+
+  auto null_key_row_count = size_t{0};
+  for (const auto& chunk_null_key_rows : null_key_rows) null_key_row_count += chunk_null_key_rows.size();
+  if (null_key_row_count == 0) return;
+
+  auto left_pos_list = make_pos_list(_arena);
+  left_pos_list->reserve(null_key_row_count);
+  for (const auto& chunk_null_key_rows : null_key_rows) {
+    left_pos_list->insert(left_pos_list->end(), chunk_null_key_rows.begin(), chunk_null_key_rows.end());
+  }
+
+  auto right_pos_list = make_pos_list(_arena);
+  if (_mode == JoinMode::Left) right_pos_list->resize(left_pos_list->size(), NULL_ROW_ID);
+  _append_output_chunk(output_table, left_pos_list, right_pos_list);
+}
+
+void AbstractJoin::_finalize_output_table(Table& output_table) const {
+  if (output_table.get_chunk(ChunkID{0}).column_count() == output_table.column_count()) return;
+
+  const auto empty_pos_list = std::shared_ptr<const PosList>{make_pos_list(_arena)};
+  _append_output_chunk(output_table, empty_pos_list, empty_pos_list);
+}
+
+bool AbstractJoin::_row_limit_reached(size_t& reported_row_count, const size_t produced_row_count) const {
+  if (!_row_limit) return false;
+  const auto total_row_count = _produced_row_count += produced_row_count - reported_row_count;
+  reported_row_count = produced_row_count;
+  return total_row_count >= *_row_limit;
+}
+
+}  // namespace opossum
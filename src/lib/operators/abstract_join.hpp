@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "storage/chunk.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+// a join key together with the row of the join input it was read from
+template <typename T>
+struct JoinKey {
+  T value;
+  RowID row_id;
+};
+
+// Materializes the values of a column into one vector per chunk, in parallel across chunks. Deleted rows and NULL
+// rows are left out, as they never match. The RowIDs point into the given table, even if it references other tables.
+// Chunks for which skipped_chunks is true are not materialized, e.g., because they are joined through an index. If
+// null_key_rows is given, the NULL rows are collected there per chunk, e.g., for left joins, which emit them anyway.
+template <typename T>
+std::vector<std::vector<JoinKey<T>>> materialize_join_keys(const Table& table, const ColumnID column_id,
+                                                           const std::vector<bool>& skipped_chunks = {},
+                                                           std::vector<std::vector<RowID>>* null_key_rows = nullptr) {
+  auto join_keys = std::vector<std::vector<JoinKey<T>>>(table.chunk_count());
+  if (null_key_rows) null_key_rows->assign(table.chunk_count(), {});
+
+  parallel_for(table.chunk_count(), [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto& chunk = table.get_chunk(chunk_id);
+    if (chunk.size() == 0 || (chunk_index < skipped_chunks.size() && skipped_chunks[chunk_index])) return;
+
+    const auto segment = chunk.get_segment(column_id);
+    auto& chunk_join_keys = join_keys[chunk_index];
+    chunk_join_keys.reserve(chunk.size());
+
+    if (segment->encoding_type() == EncodingType::Reference) {
+      const auto& reference_segment = static_cast<const ReferenceSegment&>(*segment);
+      const auto& pos_list = *reference_segment.pos_list();
+      const auto& referenced_table = *reference_segment.referenced_table();
+
+      auto referenced_chunk_id = NULL_ROW_ID.chunk_id;
+      auto invalidation_bitmap = std::shared_ptr<const std::vector<uint64_t>>{};
+      segment_iterate<T>(*segment, [&](const ChunkOffset chunk_offset, const T& value) {
+        const auto& referenced_row_id = pos_list[chunk_offset];
+        if (referenced_row_id == NULL_ROW_ID) {
+          if (null_key_rows) (*null_key_rows)[chunk_index].push_back(RowID{chunk_id, chunk_offset});
+          return;
+        }
+        if (referenced_row_id.chunk_id != referenced_chunk_id) {
+          referenced_chunk_id = referenced_row_id.chunk_id;
+          invalidation_bitmap = referenced_table.get_chunk(referenced_chunk_id).invalidation_bitmap();
+        }
+        if (!is_valid_in_bitmap(invalidation_bitmap.get(), referenced_row_id.chunk_offset)) return;
+        chunk_join_keys.push_back({value, RowID{chunk_id, chunk_offset}});
+      });
+    } else {
+      const auto invalidation_bitmap = chunk.invalidation_bitmap();
+      segment_iterate<T>(*segment, [&](const ChunkOffset chunk_offset, const T& value) {
+        if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) return;
+        chunk_join_keys.push_back({value, RowID{chunk_id, chunk_offset}});
+      });
+    }
+  });
+
+  return join_keys;
+}
+
+// the number of rows after which join workers check whether the row limit is reached, see AbstractJoin
+constexpr auto ROW_LIMIT_CHECK_INTERVAL = size_t{1024};
+
+// AbstractJoin is the super class of all join operators. It holds the parameters of the join and writes its output,
+// whose columns reference the joined rows of both inputs.
+class AbstractJoin : public AbstractOperator {
+ public:
+  AbstractJoin(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+               const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+
+  JoinMode mode() const;
+  const std::pair<ColumnID, ColumnID>& column_ids() const;
+  ScanType scan_type() const;
+
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  // creates an output table with the columns of both inputs, or only those of the left input for semi and anti joins
+  std::shared_ptr<Table> _initialize_output_table() const;
+
+  // Adds a chunk to the output whose columns reference the given rows of the inputs. The positions are RowIDs of the
+  // input tables. If an input references other tables, they are resolved to RowIDs of those tables, so that the output
+  // never references another reference segment. The right PosList is ignored for semi and anti joins.
+  void _append_output_chunk(Table& output_table, const std::shared_ptr<const PosList>& left_pos_list,
+                            const std::shared_ptr<const PosList>& right_pos_list) const;
+
+  // Adds the left rows whose join key is NULL (see materialize_join_keys) for left and anti joins, which emit them
+  // without a join partner, as NULL never matches.
+  void _append_null_key_rows(Table& output_table, const std::vector<std::vector<RowID>>& null_key_rows) const;
+
+  // adds an empty chunk if no chunk was added, so that empty results still have segments for all of their columns
+  void _finalize_output_table(Table& output_table) const;
+
+  // Returns whether the output has reached the row limit, if there is one (see AbstractOperator::row_limit). The
+  // workers that produce the output in parallel call this every ROW_LIMIT_CHECK_INTERVAL rows with the number of rows
+  // they produced so far, so that all of them stop once they have produced enough rows together. The output may
+  // exceed the limit by the rows that were produced since the last checks.
+  bool _row_limit_reached(size_t& reported_row_count, const size_t produced_row_count) const;
+
+  const JoinMode _mode;
+  const std::pair<ColumnID, ColumnID> _column_ids;
+  const ScanType _scan_type;
+
+  // the number of output rows reported to _row_limit_reached
+  mutable std::atomic<size_t> _produced_row_count{0};
+};
+
+}  // namespace opossum
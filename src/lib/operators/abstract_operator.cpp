@@ -1,20 +1,191 @@
 #include "abstract_operator.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "get_table.hpp"
+#include "operator_statistics.hpp"
+#include "result_cache.hpp"
+#include "scheduler/operator_task.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "storage/meta_tables.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
+#include "table_wrapper.hpp"
+#include "utils/arena.hpp"
 #include "utils/assert.hpp"
+#include "utils/cpu_timer.hpp"
+#include "utils/hardware_counters.hpp"
+#include "utils/performance_warning.hpp"
+#include "utils/tracer.hpp"
 
 namespace opossum {
 
+namespace {
+
+// holds read locks on the tables that a plan reads, so that their chunks are not replaced meanwhile
+class TableReadLocks : private Noncopyable {
+ public:
+  ~TableReadLocks() {
+    for (const auto& table : _tables) table->unlock_for_reading();
+  }
+
+  // locks the table and the tables that its ReferenceSegments reference
+  void add(const std::shared_ptr<const Table>& table) {
+    if (!_tables.emplace(table).second) return;
+    table->lock_for_reading();
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+        const auto segment = chunk.get_stored_segment(column_id);
+        if (segment->encoding_type() != EncodingType::Reference) continue;
+        add(static_cast<const ReferenceSegment&>(*segment).referenced_table());
+      }
+    }
+  }
+
+ protected:
+  std::set<std::shared_ptr<const Table>> _tables;
+};
+
+// locks the tables that the leaves of the plan that ends in the operator output and those that the outputs of already
+// executed operators of the plan reference
+void lock_read_tables(const AbstractOperator& op, TableReadLocks& read_locks) {
+  if (const auto output = op.get_output()) {
+    read_locks.add(output);
+    return;
+  }
+
+  if (const auto get_table = dynamic_cast<const GetTable*>(&op)) {
+    const auto& storage_manager = StorageManager::get();
+    const auto& table_name = get_table->table_name();
+    // meta tables are generated for each GetTable and thus never replace chunks
+    if (!MetaTables::is_meta_table(table_name) && storage_manager.has_table(table_name)) {
+      read_locks.add(storage_manager.get_table(table_name));
+    }
+  } else if (const auto table_wrapper = dynamic_cast<const TableWrapper*>(&op)) {
+    read_locks.add(table_wrapper->table());
+  }
+
+  for (const auto& input : {op.input_left(), op.input_right()}) {
+    if (input) lock_read_tables(*input, read_locks);
+  }
+}
+
+}  // namespace
+
 AbstractOperator::AbstractOperator(const std::shared_ptr<const AbstractOperator> left,
                                    const std::shared_ptr<const AbstractOperator> right)
-    : _input_left(left), _input_right(right) {}
+    : _input_left(left), _input_right(right) {
+  for (const auto& input : {_input_left, _input_right}) {
+    if (!input) continue;
+    const auto lock = std::lock_guard<std::mutex>{input->_consumers_mutex};
+    input->_consumers.emplace_back(this);
+  }
+}
+
+AbstractOperator::~AbstractOperator() {
+  for (const auto& input : {_input_left, _input_right}) {
+    if (!input) continue;
+    const auto lock = std::lock_guard<std::mutex>{input->_consumers_mutex};
+    auto& consumers = input->_consumers;
+    // an operator that takes the same input twice is registered twice
+    consumers.erase(std::find(consumers.begin(), consumers.end(), this));
+  }
+}
+
+void AbstractOperator::execute() {
+  // the inputs do not need to be executed if the output is cached
+  if (_load_cached_output(ResultCache::make_key(*this), std::chrono::steady_clock::now())) return;
+
+  {
+    // Compaction must not replace chunks while the plan reads them. Outputs that were computed before a compaction are
+    // rejected here, as their ReferenceSegments refer to outdated positions.
+    auto read_locks = TableReadLocks{};
+    lock_read_tables(*this, read_locks);
+
+    auto inputs = std::vector<std::shared_ptr<const AbstractOperator>>{};
+    for (const auto& input : {_input_left, _input_right}) {
+      if (input && !input->get_output()) inputs.emplace_back(input);
+    }
+    if (!inputs.empty()) TaskScheduler::get().schedule_and_wait(OperatorTask::make_tasks(inputs));
+
+    _execute_operator();
+  }
+
+  // e.g., evicted segments that the plan loaded, which can only be evicted again once the tables are not read anymore
+  StorageManager::get().enforce_pending_memory_budget();
+}
+
+void AbstractOperator::_execute_operator() const {
+  const auto trace_scope = TraceScope{"operator", [&] { return description(); }};
+  const auto warning_scope = PerformanceWarningScope{PerformanceWarningRegistry::get().register_operator(name())};
+  const auto start = std::chrono::steady_clock::now();
+  // the consumers are known by now, so that _on_execute only needs to check the row limit that was set
+  _row_limit = row_limit();
+  const auto cache_key = ResultCache::make_key(*this);
+  if (_load_cached_output(cache_key, start)) return;
+
+  _performance_data = OperatorPerformanceData{};
+  for (const auto& input : {_input_left, _input_right}) {
+    if (!input) continue;
+    _performance_data.input_row_count += input->get_output()->row_count();
+    _performance_data.processed_chunk_count += input->get_output()->chunk_count();
+  }
+
+  {
+    const auto cpu_timer = CpuTimer{};
+    auto hardware_counters = std::optional<HardwareCounters>{};
+    if (HardwareCounters::is_enabled()) hardware_counters.emplace();
+
+    _arena = std::make_shared<Arena>();
+    _output = _on_execute();
+    _arena = nullptr;
+
+    _performance_data.cpu_time = cpu_timer.elapsed();
+    if (hardware_counters && hardware_counters->is_available()) {
+      _performance_data.hardware_counters = hardware_counters->read();
+    }
+  }
+  _performance_data.processed_chunk_count -= _performance_data.skipped_chunk_count;
+  _record_output(start);
+
+  if (cache_key) ResultCache::get().insert(*cache_key, _output);
+}
 
-void AbstractOperator::execute() { _output = _on_execute(); }
+bool AbstractOperator::_load_cached_output(const std::optional<ResultCacheKey>& cache_key,
+                                           const std::chrono::steady_clock::time_point start) const {
+  if (!cache_key) return false;
+  _output = ResultCache::get().lookup(*cache_key);
+  if (!_output) return false;
+
+  _performance_data = OperatorPerformanceData{};
+  _performance_data.cached = true;
+  _record_output(start);
+  return true;
+}
+
+void AbstractOperator::_record_output(const std::chrono::steady_clock::time_point start) const {
+  _performance_data.output_row_count = _output->row_count();
+
+  // Stored and input tables are not intermediate results. Besides, estimating their memory usage can take as long as
+  // scanning them, e.g., for strings.
+  const auto is_input_table = (_input_left && _output == _input_left->get_output()) ||
+                              (_input_right && _output == _input_right->get_output());
+  if (_input_left && !is_input_table) _performance_data.output_bytes = _output->estimate_memory_usage();
+
+  _performance_data.walltime = std::chrono::steady_clock::now() - start;
+  OperatorStatistics::get().record(name(), _performance_data);
+}
 
 std::shared_ptr<const Table> AbstractOperator::get_output() const {
   // TODO(anyone): You should place some meaningful checks here
@@ -22,6 +193,58 @@ std::shared_ptr<const Table> AbstractOperator::get_output() const {
   return _output;
 }
 
+const OperatorPerformanceData& AbstractOperator::performance_data() const { return _performance_data; }
+
+std::shared_ptr<const AbstractOperator> AbstractOperator::input_left() const { return _input_left; }
+
+std::shared_ptr<const AbstractOperator> AbstractOperator::input_right() const { return _input_right; }
+
+std::string AbstractOperator::description() const { return name(); }
+
+bool AbstractOperator::is_cacheable() const { return false; }
+
+void AbstractOperator::set_row_limit(const size_t row_limit) const {
+  // e.g., a limit on top of another limit may need fewer rows, but never more
+  if (_row_limit && *_row_limit <= row_limit) return;
+  _row_limit = row_limit;
+}
+
+std::optional<size_t> AbstractOperator::row_limit() const {
+  auto row_limit = _row_limit;
+
+  // Other consumers may need the full output, e.g., a scan below a Limit that is joined with another table as well.
+  const auto consumer = _only_consumer();
+  if (!consumer) return row_limit;
+
+  const auto consumer_row_limit = consumer->_input_row_limit();
+  if (consumer_row_limit && (!row_limit || *consumer_row_limit < *row_limit)) row_limit = consumer_row_limit;
+  return row_limit;
+}
+
+size_t AbstractOperator::consumer_count() const {
+  const auto lock = std::lock_guard<std::mutex>{_consumers_mutex};
+  return _consumers.size();
+}
+
+std::optional<size_t> AbstractOperator::_input_row_limit() const { return std::nullopt; }
+
+const AbstractOperator* AbstractOperator::_only_consumer() const {
+  const auto lock = std::lock_guard<std::mutex>{_consumers_mutex};
+  return _consumers.size() == 1 ? _consumers.front() : nullptr;
+}
+
+void AbstractOperator::execute_after(const std::shared_ptr<const AbstractOperator>& other) const {
+  _execute_after.emplace_back(other);
+}
+
+std::vector<std::shared_ptr<const AbstractOperator>> AbstractOperator::execute_after_operators() const {
+  auto operators = std::vector<std::shared_ptr<const AbstractOperator>>{};
+  for (const auto& weak_operator : _execute_after) {
+    if (auto op = weak_operator.lock()) operators.emplace_back(std::move(op));
+  }
+  return operators;
+}
+
 std::shared_ptr<const Table> AbstractOperator::_input_table_left() const { return _input_left->get_output(); }
 
 std::shared_ptr<const Table> AbstractOperator::_input_table_right() const { return _input_right->get_output(); }
@@ -1,22 +1,54 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "types.hpp"
+#include "utils/hardware_counters.hpp"
 
 namespace opossum {
 
 class Table;
+struct ResultCacheKey;
+
+// What an operator did during its execution, e.g., to find the slow operator of a plan (see PlanPrinter)
+struct OperatorPerformanceData {
+  // whether the output was taken from the ResultCache, so that neither the operator nor its inputs were executed
+  bool cached = false;
+
+  std::chrono::nanoseconds walltime{0};
+
+  // the CPU time of the executing thread and of the parallel_for jobs of the operator (see CpuTimer)
+  std::chrono::nanoseconds cpu_time{0};
+
+  // the rows of both inputs together, including deleted rows
+  uint64_t input_row_count = 0;
+  uint64_t output_row_count = 0;
+
+  // the chunks of both inputs that were processed and those that were skipped, e.g., because of a row limit
+  size_t processed_chunk_count = 0;
+  size_t skipped_chunk_count = 0;
+
+  // the estimated memory usage of the output, which is 0 if the output is a stored table or an input table
+  size_t output_bytes = 0;
+
+  // the hardware counters of the executing thread and of the parallel_for jobs of the operator, only if they were
+  // enabled and are available (see HardwareCounters)
+  std::optional<HardwareCounterValues> hardware_counters;
+};
 
 // AbstractOperator is the abstract super class for all operators.
 // All operators have up to two input tables and one output table.
 // Their lifecycle has three phases:
 // 1. The operator is constructed. Previous operators are not guaranteed to have already executed, so operators must not
 // call get_output in their execute method
-// 2. The execute method is called from the outside (usually by the scheduler). This is where the heavy lifting is done.
-// By now, the input operators have already executed.
+// 2. The execute method is called from the outside. This is where the heavy lifting is done. Inputs that have not been
+// executed yet are executed first, as a DAG of OperatorTasks on the TaskScheduler, so that independent inputs are
+// executed concurrently. If the ResultCache holds the output of an equal plan, it is reused instead.
 // 3. The consumer (usually another operator) calls get_output. This should be very cheap. It is only guaranteed to
 // succeed if execute was called before. Otherwise, a nullptr or an empty table could be returned.
 //
@@ -29,27 +61,83 @@ class AbstractOperator : private Noncopyable {
   AbstractOperator(const std::shared_ptr<const AbstractOperator> left = nullptr,
                    const std::shared_ptr<const AbstractOperator> right = nullptr);
 
-  virtual ~AbstractOperator() = default;
+  virtual ~AbstractOperator();
 
-  // we need to explicitly set the move constructor to default when
-  // we overwrite the copy constructor
-  AbstractOperator(AbstractOperator&&) = default;
-  AbstractOperator& operator=(AbstractOperator&&) = default;
+  // consumers refer to their inputs, which are registered with them, so that operators cannot be moved
+  AbstractOperator(AbstractOperator&&) = delete;
+  AbstractOperator& operator=(AbstractOperator&&) = delete;
 
   void execute();
 
   // returns the result of the operator
   std::shared_ptr<const Table> get_output() const;
 
+  // returns what the operator did during its execution, which is empty before the operator is executed
+  const OperatorPerformanceData& performance_data() const;
+
   // Get the input operators.
   std::shared_ptr<const AbstractOperator> input_left() const;
   std::shared_ptr<const AbstractOperator> input_right() const;
 
+  // returns the name of the operator, e.g., "TableScan"
+  virtual std::string name() const = 0;
+
+  // Returns the name of the operator followed by its parameters, e.g., "TableScan #0 > 5". Columns are referred to by
+  // their ColumnIDs, as the input tables are not known before the operator is executed.
+  virtual std::string description() const;
+
+  // Returns whether the output of the operator only depends on its description and the outputs of its inputs, so that
+  // the output can be reused for an operator with the same description on the same inputs (see ResultCache).
+  virtual bool is_cacheable() const;
+
+  // Hints that only the first row_limit rows of the output will be consumed. Operators may then stop producing chunks
+  // once their output has at least that many rows. The hint must be set before the operator is executed and only if
+  // nobody needs the full output. As inputs are shared as const operators, it can be set on those.
+  void set_row_limit(const size_t row_limit) const;
+
+  // Returns the row limit that was set or, if the operator is the input of exactly one other operator, the number of
+  // rows that this consumer reads at most (e.g., the row count of a Limit), whichever is lower. Consumers that are not
+  // operators, e.g., code that calls get_output, are not known, so that the output of an operator whose only operator
+  // consumer is a Limit must only be read through that Limit.
+  std::optional<size_t> row_limit() const;
+
+  // returns how many operators take this one as an input
+  size_t consumer_count() const;
+
+  // Hints that the operator profits from being executed after the other one, e.g., a TableScan that receives a Bloom
+  // filter built from the other operator's output. Unlike inputs, the other operator is not executed for this one. The
+  // hint is only followed if both are executed as part of the same DAG and it does not lead to a cycle.
+  void execute_after(const std::shared_ptr<const AbstractOperator>& other) const;
+
+  // returns the operators that this one should be executed after, e.g., those added by execute_after
+  virtual std::vector<std::shared_ptr<const AbstractOperator>> execute_after_operators() const;
+
  protected:
+  friend class OperatorTask;
+
+  // Executes only this operator, whose inputs have been executed already. Inputs are shared as const operators, which
+  // OperatorTasks still have to execute once. Thus, executing is const and only sets the output, the performance data,
+  // and other state that is mutable for this purpose.
+  void _execute_operator() const;
+
+  // takes the output from the ResultCache if it holds it, returns whether it did
+  bool _load_cached_output(const std::optional<ResultCacheKey>& cache_key,
+                           const std::chrono::steady_clock::time_point start) const;
+
+  // records the output rows and bytes and the wall time since the start in the performance data
+  void _record_output(const std::chrono::steady_clock::time_point start) const;
+
   // abstract method to actually execute the operator
   // execute and get_output are split into two methods to allow for easier
   // asynchronous execution
-  virtual std::shared_ptr<const Table> _on_execute() = 0;
+  virtual std::shared_ptr<const Table> _on_execute() const = 0;
+
+  // Returns how many rows of its input the operator reads at most, if it knows that in advance, e.g., the row count of
+  // a Limit. Operators whose output rows are their input rows in the same order return their own row limit.
+  virtual std::optional<size_t> _input_row_limit() const;
+
+  // returns the operator that takes this one as an input if there is exactly one, or nullptr
+  const AbstractOperator* _only_consumer() const;
 
   std::shared_ptr<const Table> _input_table_left() const;
   std::shared_ptr<const Table> _input_table_right() const;
@@ -59,7 +147,25 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const AbstractOperator> _input_right;
 
   // Is nullptr until the operator is executed
-  std::shared_ptr<const Table> _output;
+  mutable std::shared_ptr<const Table> _output;
+
+  // Operators that skip chunks of their inputs report them in _on_execute. The other numbers are recorded around it.
+  mutable OperatorPerformanceData _performance_data;
+
+  // Arena for the intermediate results of the operator, e.g., the PosLists of its output (see make_pos_list()).
+  // It only exists while the operator executes. Afterwards, the results allocated from it keep it alive, so that
+  // dropping the output releases all of them in one shot.
+  mutable std::shared_ptr<MemoryResource> _arena;
+
+  // the number of output rows that will be consumed, if known (see set_row_limit)
+  mutable std::optional<size_t> _row_limit;
+
+  // the operators that take this one as an input, which unregister in their destructor
+  mutable std::vector<const AbstractOperator*> _consumers;
+  mutable std::mutex _consumers_mutex;
+
+  // see execute_after, weak so that an operator does not keep the other one alive
+  mutable std::vector<std::weak_ptr<const AbstractOperator>> _execute_after;
 };
 
 }  // namespace opossum
@@ -0,0 +1,464 @@
+#include "aggregate.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "table_scan.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto NO_GROUP = std::numeric_limits<uint32_t>::max();
+
+// Below this number of groups in all chunks, merging them is not worth the partitioning
+constexpr auto MIN_GROUPS_PER_PARTITION = size_t{4096};
+
+// the values of the group-by columns of a group
+using GroupKey = std::vector<AllTypeVariant>;
+using GroupKeyHash = boost::hash<GroupKey>;
+
+template <typename ColumnType, AggregateFunction function>
+using AggregateResultType = std::conditional_t<
+    function == AggregateFunction::Count, int64_t,
+    std::conditional_t<function == AggregateFunction::Avg, double,
+                       std::conditional_t<function == AggregateFunction::Sum,
+                                          std::conditional_t<std::is_integral_v<ColumnType>, int64_t, double>,
+                                          ColumnType>>>;
+
+std::string aggregate_function_name(const AggregateFunction function) {
+  switch (function) {
+    case AggregateFunction::Min:
+      return "MIN";
+    case AggregateFunction::Max:
+      return "MAX";
+    case AggregateFunction::Sum:
+      return "SUM";
+    case AggregateFunction::Avg:
+      return "AVG";
+    case AggregateFunction::Count:
+      break;
+  }
+  return "COUNT";
+}
+
+// Returns the PosList of a reference segment, or nullptr for other segments. NULL values only occur in reference
+// segments, e.g., in the output of a left join, where they are referenced by NULL_ROW_ID.
+const PosList* null_row_pos_list(const BaseSegment* segment) {
+  if (!segment || segment->encoding_type() != EncodingType::Reference) return nullptr;
+  return static_cast<const ReferenceSegment&>(*segment).pos_list().get();
+}
+
+bool is_null_row(const PosList* pos_list, const ChunkOffset chunk_offset) {
+  return pos_list && (*pos_list)[chunk_offset] == NULL_ROW_ID;
+}
+
+// Holds the intermediate results of an aggregate for a number of groups, e.g., the groups of a chunk or those of a
+// partition of the output
+class BaseAggregateAccumulator : private Noncopyable {
+ public:
+  virtual ~BaseAggregateAccumulator() = default;
+
+  // creates an accumulator for the same aggregate without groups
+  virtual std::unique_ptr<BaseAggregateAccumulator> create_empty() const = 0;
+
+  virtual void resize(size_t group_count) = 0;
+
+  // adds every row of the segment to its group as given by group_ids, rows with NO_GROUP and NULL rows are skipped
+  // the segment is nullptr for COUNT(*), which counts NULL rows as well
+  virtual void accumulate(const BaseSegment* segment, const std::vector<uint32_t>& group_ids) = 0;
+
+  // merges a group of another accumulator for the same aggregate into a group of this one
+  virtual void merge(uint32_t group_id, const BaseAggregateAccumulator& other, uint32_t other_group_id) = 0;
+
+  // returns a segment with the aggregate of every group
+  virtual std::shared_ptr<BaseSegment> result_segment() const = 0;
+
+  virtual std::string result_type() const = 0;
+};
+
+template <typename ColumnType, AggregateFunction function>
+class AggregateAccumulator : public BaseAggregateAccumulator {
+ public:
+  using ResultType = AggregateResultType<ColumnType, function>;
+
+  std::unique_ptr<BaseAggregateAccumulator> create_empty() const override {
+    return std::make_unique<AggregateAccumulator>();
+  }
+
+  void resize(const size_t group_count) override {
+    _values.resize(group_count);
+    _counts.resize(group_count);
+  }
+
+  void accumulate(const BaseSegment* segment, const std::vector<uint32_t>& group_ids) override {
+    const auto* const pos_list = null_row_pos_list(segment);
+    if constexpr (function == AggregateFunction::Count) {
+      // COUNT only depends on whether the values are NULL
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < group_ids.size(); ++chunk_offset) {
+        const auto group_id = group_ids[chunk_offset];
+        if (group_id != NO_GROUP && !is_null_row(pos_list, chunk_offset)) ++_counts[group_id];
+      }
+    } else {
+      // NULL rows are iterated as the default value of the type
+      segment_iterate<ColumnType>(*segment, [&](const ChunkOffset chunk_offset, const ColumnType& value) {
+        const auto group_id = group_ids[chunk_offset];
+        if (group_id != NO_GROUP && !is_null_row(pos_list, chunk_offset)) _add(group_id, value, 1);
+      });
+    }
+  }
+
+  void merge(const uint32_t group_id, const BaseAggregateAccumulator& other, const uint32_t other_group_id) override {
+    const auto& other_accumulator = static_cast<const AggregateAccumulator&>(other);
+    if (other_accumulator._counts[other_group_id] == 0) return;
+    _add(group_id, other_accumulator._values[other_group_id], other_accumulator._counts[other_group_id]);
+  }
+
+  std::shared_ptr<BaseSegment> result_segment() const override {
+    auto values = pmr_vector<ResultType>(_values.size());
+    for (auto group_id = size_t{0}; group_id < _values.size(); ++group_id) {
+      if constexpr (function == AggregateFunction::Count) {
+        values[group_id] = _counts[group_id];
+      } else if constexpr (function == AggregateFunction::Avg) {
+        values[group_id] = _counts[group_id] > 0 ? _values[group_id] / static_cast<double>(_counts[group_id]) : 0.0;
+      } else {
+        values[group_id] = _values[group_id];
+      }
+    }
+    return std::make_shared<ValueSegment<ResultType>>(std::move(values));
+  }
+
+  std::string result_type() const override { return data_type_name<ResultType>(); }
+
+ protected:
+  // adds a value that stands for count rows, i.e., a single row or a group of another accumulator
+  template <typename Value>
+  void _add(const uint32_t group_id, const Value& value, const int64_t count) {
+    auto& aggregate = _values[group_id];
+    if constexpr (function == AggregateFunction::Min) {
+      if (_counts[group_id] == 0 || value < aggregate) aggregate = value;
+    } else if constexpr (function == AggregateFunction::Max) {
+      if (_counts[group_id] == 0 || aggregate < value) aggregate = value;
+    } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+      aggregate += value;
+    }
+    _counts[group_id] += count;
+  }
+
+  // the aggregate of each group, unused for COUNT and the sum for AVG
+  std::vector<ResultType> _values;
+  std::vector<int64_t> _counts;
+};
+
+std::unique_ptr<BaseAggregateAccumulator> make_accumulator(const std::string& column_type,
+                                                           const AggregateFunction function) {
+  auto accumulator = std::unique_ptr<BaseAggregateAccumulator>{};
+  resolve_data_type(column_type, [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    switch (function) {
+      case AggregateFunction::Min:
+        accumulator = std::make_unique<AggregateAccumulator<ColumnType, AggregateFunction::Min>>();
+        break;
+      case AggregateFunction::Max:
+        accumulator = std::make_unique<AggregateAccumulator<ColumnType, AggregateFunction::Max>>();
+        break;
+      case AggregateFunction::Count:
+        accumulator = std::make_unique<AggregateAccumulator<ColumnType, AggregateFunction::Count>>();
+        break;
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+        if constexpr (std::is_same_v<ColumnType, std::string>) {
+          Fail("SUM and AVG are not defined for strings");
+        } else if (function == AggregateFunction::Sum) {
+          accumulator = std::make_unique<AggregateAccumulator<ColumnType, AggregateFunction::Sum>>();
+        } else {
+          accumulator = std::make_unique<AggregateAccumulator<ColumnType, AggregateFunction::Avg>>();
+        }
+        break;
+    }
+  });
+  return accumulator;
+}
+
+// Assigns a code to every row, so that rows have the same code if and only if they have the same value. Returns the
+// number of codes. Dictionary segments already encode their values densely, so that their ValueIDs are used.
+template <typename T>
+uint32_t encode_segment(const BaseSegment& segment, std::vector<uint32_t>& codes) {
+  if (segment.encoding_type() == EncodingType::Dictionary) {
+    const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(segment);
+    resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+      std::copy(value_ids.cbegin(), value_ids.cend(), codes.begin());
+    });
+    return static_cast<uint32_t>(dictionary_segment.unique_values_count());
+  }
+
+  auto value_codes = std::unordered_map<T, uint32_t>{};
+  segment_iterate<T>(segment, [&](const ChunkOffset chunk_offset, const T& value) {
+    codes[chunk_offset] = value_codes.try_emplace(value, static_cast<uint32_t>(value_codes.size())).first->second;
+  });
+  return static_cast<uint32_t>(value_codes.size());
+}
+
+// the groups of a chunk and their pre-aggregated values
+struct ChunkGroups {
+  std::vector<GroupKey> keys;
+  std::vector<std::unique_ptr<BaseAggregateAccumulator>> accumulators;
+  // the groups of each partition of the output
+  std::vector<std::vector<uint32_t>> partition_group_ids;
+};
+
+}  // namespace
+
+Aggregate::Aggregate(const std::shared_ptr<const AbstractOperator> in,
+                     const std::vector<AggregateColumnDefinition>& aggregates,
+                     const std::vector<ColumnID>& groupby_column_ids)
+    : AbstractOperator(in), _aggregates(aggregates), _groupby_column_ids(groupby_column_ids) {}
+
+const std::vector<AggregateColumnDefinition>& Aggregate::aggregates() const { return _aggregates; }
+
+const std::vector<ColumnID>& Aggregate::groupby_column_ids() const { return _groupby_column_ids; }
+
+std::string Aggregate::name() const { return "Aggregate"; }
+
+std::string Aggregate::description() const {
+  auto description = name();
+  for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+    const auto& aggregate = _aggregates[aggregate_index];
+    description += aggregate_index == 0 ? " " : ", ";
+    description += aggregate_function_name(aggregate.function) + "(";
+    description += aggregate.column_id ? "#" + std::to_string(*aggregate.column_id) : std::string{"*"};
+    description += ")";
+  }
+  for (auto groupby_index = size_t{0}; groupby_index < _groupby_column_ids.size(); ++groupby_index) {
+    description += groupby_index == 0 ? " GROUP BY #" : ", #";
+    description += std::to_string(_groupby_column_ids[groupby_index]);
+  }
+  return description;
+}
+
+bool Aggregate::is_cacheable() const { return true; }
+
+std::shared_ptr<const Table> Aggregate::_on_execute() const {
+  const auto input_table = _input_table_left();
+
+  // one accumulator per aggregate, from which those for the chunks and partitions are created
+  auto prototypes = std::vector<std::unique_ptr<BaseAggregateAccumulator>>{};
+  for (const auto& aggregate : _aggregates) {
+    Assert(aggregate.column_id || aggregate.function == AggregateFunction::Count, "Only COUNT can omit its column");
+    prototypes.emplace_back(make_accumulator(
+        aggregate.column_id ? input_table->column_type(*aggregate.column_id) : "long", aggregate.function));
+  }
+
+  // Assigns the rows of each chunk to groups, column by column. The group of a row is combined with the code of its
+  // value in the next column to form its new group. The groups are renumbered in the order of their first rows.
+  auto chunk_groups = std::vector<ChunkGroups>(input_table->chunk_count());
+  parallel_for(chunk_groups.size(), [&](const size_t chunk_index) {
+    const auto& chunk = input_table->get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_index)});
+    const auto row_count = chunk.size();
+
+    auto group_ids = std::vector<uint32_t>(row_count);
+    auto group_count = uint32_t{1};
+    auto codes = std::vector<uint32_t>(row_count);
+    for (auto index = size_t{0}; index < _groupby_column_ids.size(); ++index) {
+      const auto column_id = _groupby_column_ids[index];
+      auto code_count = uint32_t{0};
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        code_count = encode_segment<Type>(*chunk.get_segment(column_id), codes);
+      });
+
+      if (index == 0) {
+        std::swap(group_ids, codes);
+        group_count = code_count;
+        continue;
+      }
+
+      // Small combinations are looked up in a dense array, which is the case for low-cardinality columns
+      const auto combination_count = uint64_t{group_count} * code_count;
+      auto next_group_count = uint32_t{0};
+      if (combination_count <= 2 * uint64_t{row_count}) {
+        auto combined_group_ids = std::vector<uint32_t>(combination_count, NO_GROUP);
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+          auto& group_id = combined_group_ids[uint64_t{group_ids[chunk_offset]} * code_count + codes[chunk_offset]];
+          if (group_id == NO_GROUP) group_id = next_group_count++;
+          group_ids[chunk_offset] = group_id;
+        }
+      } else {
+        auto combined_group_ids = std::unordered_map<uint64_t, uint32_t>{};
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+          const auto combination = uint64_t{group_ids[chunk_offset]} * code_count + codes[chunk_offset];
+          group_ids[chunk_offset] = combined_group_ids.try_emplace(combination, next_group_count).first->second;
+          if (group_ids[chunk_offset] == next_group_count) ++next_group_count;
+        }
+      }
+      group_count = next_group_count;
+    }
+
+    // Deleted rows, including those deleted from the tables that reference segments refer to, are left out. Groups that
+    // consist of deleted rows only, e.g., values of a dictionary that were deleted, are dropped by the renumbering.
+    const auto invalidation_bitmap = TableScan::invalidation_bitmap(chunk);
+    // Rows whose group-by values are NULL are left out as well, as the output cannot represent NULL, and the default
+    // value that they are encoded as would merge them with the rows of that value.
+    auto null_row_pos_lists = std::vector<const PosList*>{};
+    for (const auto& column_id : _groupby_column_ids) {
+      const auto* const pos_list = null_row_pos_list(chunk.get_segment(column_id).get());
+      if (pos_list) null_row_pos_lists.push_back(pos_list);
+    }
+    const auto has_null_group_by_value = [&](const ChunkOffset chunk_offset) {
+      return std::any_of(null_row_pos_lists.cbegin(), null_row_pos_lists.cend(),
+                         [&](const PosList* pos_list) { return is_null_row(pos_list, chunk_offset); });
+    };
+
+    auto renumbered_group_ids = std::vector<uint32_t>(group_count, NO_GROUP);
+    auto first_rows = std::vector<ChunkOffset>{};
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset) || has_null_group_by_value(chunk_offset)) {
+        group_ids[chunk_offset] = NO_GROUP;
+        continue;
+      }
+      auto& group_id = renumbered_group_ids[group_ids[chunk_offset]];
+      if (group_id == NO_GROUP) {
+        group_id = static_cast<uint32_t>(first_rows.size());
+        first_rows.push_back(chunk_offset);
+      }
+      group_ids[chunk_offset] = group_id;
+    }
+
+    // the group-by values are only looked up for the first row of each group
+    auto& groups = chunk_groups[chunk_index];
+    groups.keys.resize(first_rows.size(), GroupKey(_groupby_column_ids.size()));
+    for (auto index = size_t{0}; index < _groupby_column_ids.size(); ++index) {
+      const auto column_id = _groupby_column_ids[index];
+      const auto segment = chunk.get_segment(column_id);
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        for (auto group_id = size_t{0}; group_id < first_rows.size(); ++group_id) {
+          groups.keys[group_id][index] = get_segment_value<Type>(*segment, first_rows[group_id]);
+        }
+      });
+    }
+
+    for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+      auto accumulator = prototypes[aggregate_index]->create_empty();
+      accumulator->resize(first_rows.size());
+      const auto& column_id = _aggregates[aggregate_index].column_id;
+      accumulator->accumulate(column_id ? chunk.get_segment(*column_id).get() : nullptr, group_ids);
+      groups.accumulators.emplace_back(std::move(accumulator));
+    }
+  });
+
+  // the groups of all chunks are radix-partitioned on the upper bits of their mixed hash
+  auto total_group_count = size_t{0};
+  for (const auto& groups : chunk_groups) total_group_count += groups.keys.size();
+  auto partition_bits = size_t{0};
+  const auto thread_count = TaskScheduler::get().worker_count();
+  while ((size_t{1} << partition_bits) < thread_count * 4 &&
+         (total_group_count >> partition_bits) >= MIN_GROUPS_PER_PARTITION) {
+    ++partition_bits;
+  }
+  const auto partition_count = size_t{1} << partition_bits;
+
+  parallel_for(chunk_groups.size(), [&](const size_t chunk_index) {
+    auto& groups = chunk_groups[chunk_index];
+    groups.partition_group_ids.resize(partition_count);
+    for (auto group_id = uint32_t{0}; group_id < groups.keys.size(); ++group_id) {
+      const auto hash = static_cast<uint64_t>(GroupKeyHash{}(groups.keys[group_id])) * uint64_t{0x9E3779B97F4A7C15};
+      const auto partition = partition_bits == 0 ? size_t{0} : static_cast<size_t>(hash >> (64 - partition_bits));
+      groups.partition_group_ids[partition].push_back(group_id);
+    }
+  });
+
+  auto output_table = std::make_shared<Table>();
+  for (const auto& column_id : _groupby_column_ids) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+  for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+    const auto& aggregate = _aggregates[aggregate_index];
+    const auto column_name = aggregate.column_id ? input_table->column_name(*aggregate.column_id) : "*";
+    output_table->add_column_definition(aggregate_function_name(aggregate.function) + "(" + column_name + ")",
+                                        prototypes[aggregate_index]->result_type());
+  }
+
+  // creates a chunk of the output from the group-by values and the aggregates of its groups
+  const auto make_output_chunk = [&](const std::vector<const GroupKey*>& keys,
+                                     const std::vector<std::unique_ptr<BaseAggregateAccumulator>>& accumulators) {
+    auto chunk = Chunk{};
+    for (auto index = size_t{0}; index < _groupby_column_ids.size(); ++index) {
+      resolve_data_type(output_table->column_type(ColumnID{static_cast<ColumnID::base_type>(index)}), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        auto values = pmr_vector<Type>{};
+        values.reserve(keys.size());
+        for (const auto* key : keys) values.push_back(type_cast<Type>((*key)[index]));
+        chunk.add_segment(std::make_shared<ValueSegment<Type>>(std::move(values)));
+      });
+    }
+    for (const auto& accumulator : accumulators) {
+      chunk.add_segment(accumulator->result_segment());
+    }
+    return chunk;
+  };
+
+  // merges the groups of each partition across all chunks
+  auto output_chunks = std::vector<Chunk>(partition_count);
+  auto output_group_counts = std::vector<size_t>(partition_count);
+  parallel_for(partition_count, [&](const size_t partition) {
+    auto group_ids = std::unordered_map<GroupKey, uint32_t, GroupKeyHash>{};
+    auto keys = std::vector<const GroupKey*>{};
+    auto accumulators = std::vector<std::unique_ptr<BaseAggregateAccumulator>>{};
+    for (const auto& prototype : prototypes) accumulators.emplace_back(prototype->create_empty());
+
+    for (const auto& groups : chunk_groups) {
+      for (const auto chunk_group_id : groups.partition_group_ids[partition]) {
+        const auto [entry, inserted] =
+            group_ids.try_emplace(groups.keys[chunk_group_id], static_cast<uint32_t>(keys.size()));
+        if (inserted) {
+          keys.push_back(&entry->first);
+          for (auto& accumulator : accumulators) accumulator->resize(keys.size());
+        }
+        for (auto aggregate_index = size_t{0}; aggregate_index < accumulators.size(); ++aggregate_index) {
+          accumulators[aggregate_index]->merge(entry->second, *groups.accumulators[aggregate_index], chunk_group_id);
+        }
+      }
+    }
+
+    output_chunks[partition] = make_output_chunk(keys, accumulators);
+    output_group_counts[partition] = keys.size();
+  });
+
+  for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+    if (output_group_counts[partition] > 0) output_table->emplace_chunk(std::move(output_chunks[partition]));
+  }
+
+  // Without groups, the output still has segments for all of its columns. Without group-by columns, it has one row
+  // with the aggregates of no rows.
+  if (total_group_count == 0) {
+    auto accumulators = std::vector<std::unique_ptr<BaseAggregateAccumulator>>{};
+    for (const auto& prototype : prototypes) {
+      accumulators.emplace_back(prototype->create_empty());
+      accumulators.back()->resize(_groupby_column_ids.empty() ? 1 : 0);
+    }
+    output_table->emplace_chunk(make_output_chunk({}, accumulators));
+  }
+
+  return output_table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+enum class AggregateFunction { Min, Max, Sum, Avg, Count };
+
+// An aggregate of a column, or COUNT(*) if no column is given. SUM returns a long for integral columns and a double for
+// floating-point columns, AVG returns a double, COUNT returns a long, and MIN and MAX return the type of the column.
+struct AggregateColumnDefinition {
+  std::optional<ColumnID> column_id;
+  AggregateFunction function;
+};
+
+// Aggregate groups the rows of its input by the values of the group-by columns and computes the given aggregates for
+// each group. The output consists of the group-by columns followed by one column per aggregate, in the given order.
+// Without group-by columns, all rows form one group, so that the output always has a single row. The order of the
+// groups in the output is undefined.
+//
+// NULL values, i.e., the unmatched rows of outer joins, are not aggregated, except by COUNT(*). Rows whose group-by
+// values are NULL do not belong to any group.
+//
+// Each chunk is pre-aggregated by its own thread. Rows are assigned to groups column by column. A dictionary-encoded
+// group-by column does not need a hash table, as its ValueIDs already are dense group ids. The group-by values are
+// only looked up once per group of the chunk. The groups of all chunks are then radix-partitioned by the hash of their
+// group-by values and merged in parallel across partitions. Each partition yields one chunk of the output.
+class Aggregate : public AbstractOperator {
+ public:
+  Aggregate(const std::shared_ptr<const AbstractOperator> in, const std::vector<AggregateColumnDefinition>& aggregates,
+            const std::vector<ColumnID>& groupby_column_ids);
+
+  const std::vector<AggregateColumnDefinition>& aggregates() const;
+  const std::vector<ColumnID>& groupby_column_ids() const;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  const std::vector<AggregateColumnDefinition> _aggregates;
+  const std::vector<ColumnID> _groupby_column_ids;
+};
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#include "delete.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+Delete::Delete(const std::shared_ptr<const AbstractOperator> in) : AbstractOperator(in) {}
+
+std::string Delete::name() const { return "Delete"; }
+
+std::shared_ptr<const Table> Delete::_on_execute() const {
+  const auto input_table = _input_table_left();
+  Assert(input_table->column_count() > 0, "Delete needs to know which table its input references");
+
+  // Rows are deleted per chunk, so that each chunk copies its invalidation bitmap only once.
+  auto referenced_table = std::shared_ptr<const Table>{};
+  auto chunk_offsets_by_chunk = std::map<ChunkID, std::vector<ChunkOffset>>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto& chunk = input_table->get_chunk(chunk_id);
+    if (chunk.size() == 0) continue;
+
+    const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+    Assert(segment, "Delete expects its input to reference the rows to delete");
+    Assert(!referenced_table || referenced_table == segment->referenced_table(),
+           "Delete can only delete rows from a single table");
+    referenced_table = segment->referenced_table();
+
+    for (const auto& row_id : *segment->pos_list()) {
+      if (row_id == NULL_ROW_ID) continue;
+      chunk_offsets_by_chunk[row_id.chunk_id].emplace_back(row_id.chunk_offset);
+    }
+  }
+
+  if (!referenced_table) return input_table;
+
+  // Operators only get read access to their inputs. Delete is the exception, as it has to modify the stored table.
+  const auto table = std::const_pointer_cast<Table>(referenced_table);
+  for (const auto& [chunk_id, chunk_offsets] : chunk_offsets_by_chunk) {
+    table->get_chunk(chunk_id).invalidate_rows(chunk_offsets);
+  }
+  table->mark_modified();
+
+  return input_table;
+}
+
+}  // namespace opossum
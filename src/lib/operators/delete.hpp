@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_operator.hpp"
+
+namespace opossum {
+
+// Deletes the rows that its input references, e.g., the output of a TableScan, from the table they are stored in.
+// The rows are marked as invalid in their chunks, so that subsequent scans skip them, and are removed physically when
+// the chunks are compacted (see Table::compact_chunk and BackgroundCompaction).
+// The output is the input, i.e., the deleted rows.
+class Delete : public AbstractOperator {
+ public:
+  explicit Delete(const std::shared_ptr<const AbstractOperator> in);
+
+  std::string name() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+};
+
+}  // namespace opossum
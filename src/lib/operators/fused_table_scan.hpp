@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "table_scan.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// A predicate on a column whose data type T is known at compile time. A row matches if compare(value of the row,
+// value) holds, e.g., ScanPredicate<int32_t, std::greater<>>{ColumnID{0}, 5} selects the rows whose first column is
+// greater than 5.
+template <typename T, typename Compare>
+struct ScanPredicate {
+  using Type = T;
+
+  ColumnID column_id;
+  T value;
+  Compare compare{};
+};
+
+// FusedTableScan selects the rows of its input that satisfy all of its predicates, like a chain of TableScans, but in
+// a single loop per chunk. The predicates are template parameters, so that the compiler specializes the loop for their
+// data types and for the encodings of the scanned segments: the encodings are resolved once per chunk and segment,
+// and the loop itself neither calls virtual functions nor dispatches on data types. This is meant for hot queries
+// whose predicates are known when the code is compiled, e.g.:
+//
+//   auto scan = make_fused_table_scan(in, ScanPredicate<int32_t, std::greater<>>{ColumnID{0}, 5},
+//                                     ScanPredicate<std::string, std::equal_to<>>{ColumnID{1}, "apple"});
+//
+// Each predicate adds a factor of three to the number of loop instantiations, so that the number of predicates should
+// stay small. The output is the same as that of a TableScan, including its handling of deleted rows and row limits.
+template <typename... Predicates>
+class FusedTableScan : public AbstractOperator {
+ public:
+  FusedTableScan(const std::shared_ptr<const AbstractOperator> in, const Predicates&... predicates)
+      : AbstractOperator(in), _predicates(predicates...) {
+    static_assert(sizeof...(Predicates) > 0, "FusedTableScan needs at least one predicate");
+  }
+
+  const std::tuple<Predicates...>& predicates() const { return _predicates; }
+
+  std::string name() const override { return "FusedTableScan"; }
+
+ protected:
+  using Bitmap = std::vector<uint64_t>;
+
+  std::shared_ptr<const Table> _on_execute() const override {
+    const auto input_table = _input_table_left();
+    std::apply(
+        [&](const auto&... predicates) {
+          (Assert(input_table->column_type(predicates.column_id) ==
+                      data_type_name<typename std::decay_t<decltype(predicates)>::Type>(),
+                  "Predicate does not match the data type of its column"),
+           ...);
+        },
+        _predicates);
+
+    auto output_table = std::make_shared<Table>();
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+    }
+
+    // the NULL rows of all predicates' columns are removed, e.g., those of a left join, as they never match
+    const auto scanned_column_ids = std::apply(
+        [](const auto&... predicates) { return std::vector<ColumnID>{predicates.column_id...}; }, _predicates);
+
+    const auto scan_chunk = [&](const Chunk& chunk) {
+      auto matches = Bitmap{};
+      _resolve_accessors(chunk, [&](const auto&... accessors) {
+        // one bit per row, each word is built from 64 rows without branches
+        const auto size = chunk.size();
+        matches.resize((size + 63) / 64);
+        for (auto word_index = size_t{0}; word_index < matches.size(); ++word_index) {
+          const auto begin = word_index * 64;
+          const auto end = std::min(begin + 64, size_t{size});
+          auto word = uint64_t{0};
+          for (auto index = begin; index < end; ++index) {
+            word |= static_cast<uint64_t>((accessors(index) & ...)) << (index - begin);
+          }
+          matches[word_index] = word;
+        }
+      });
+      TableScan::_remove_invalid_rows(matches, chunk, scanned_column_ids);
+      return matches;
+    };
+
+    _performance_data.skipped_chunk_count =
+        TableScan::_scan_chunks(*output_table, input_table, _row_limit, _arena, scan_chunk);
+    return output_table;
+  }
+
+  // Calls the functor with one accessor per predicate, which returns whether the predicate holds for a row of the
+  // chunk. The accessors are resolved one predicate after another.
+  template <size_t index = 0, typename Functor, typename... Accessors>
+  void _resolve_accessors(const Chunk& chunk, const Functor& functor, const Accessors&... accessors) const {
+    if constexpr (index == sizeof...(Predicates)) {
+      functor(accessors...);
+    } else {
+      _resolve_accessor(chunk, std::get<index>(_predicates), [&](const auto& accessor) {
+        _resolve_accessors<index + 1>(chunk, functor, accessors..., accessor);
+      });
+    }
+  }
+
+  // Value segments are compared directly. Dictionary segments look up whether the predicate holds for the value id,
+  // so that it is evaluated once per distinct value. Other segments, e.g., reference segments, are evaluated up front.
+  template <typename Predicate, typename Functor>
+  static void _resolve_accessor(const Chunk& chunk, const Predicate& predicate, const Functor& functor) {
+    using T = typename Predicate::Type;
+    const auto segment = chunk.get_segment(predicate.column_id);
+
+    switch (segment->encoding_type()) {
+      case EncodingType::Unencoded: {
+        const auto* const values = static_cast<const ValueSegment<T>&>(*segment).values().data();
+        functor([&](const size_t index) { return predicate.compare(values[index], predicate.value); });
+        break;
+      }
+      case EncodingType::Dictionary: {
+        const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(*segment);
+        const auto& dictionary = *dictionary_segment.dictionary();
+        auto value_id_matches = std::vector<uint8_t>(dictionary.size());
+        for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+          value_id_matches[value_id] = predicate.compare(dictionary[value_id], predicate.value);
+        }
+        const auto* const matches = value_id_matches.data();
+        resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+          functor([&](const size_t index) { return matches[static_cast<ValueID::base_type>(value_ids[index])] != 0; });
+        });
+        break;
+      }
+      default: {
+        auto row_matches = std::vector<uint8_t>(segment->size());
+        segment_iterate<T>(*segment, [&](const ChunkOffset chunk_offset, const T& value) {
+          row_matches[chunk_offset] = predicate.compare(value, predicate.value);
+        });
+        const auto* const matches = row_matches.data();
+        functor([&](const size_t index) { return matches[index] != 0; });
+      }
+    }
+  }
+
+  const std::tuple<Predicates...> _predicates;
+};
+
+template <typename... Predicates>
+std::shared_ptr<FusedTableScan<Predicates...>> make_fused_table_scan(const std::shared_ptr<const AbstractOperator>& in,
+                                                                     const Predicates&... predicates) {
+  return std::make_shared<FusedTableScan<Predicates...>>(in, predicates...);
+}
+
+}  // namespace opossum
@@ -0,0 +1,41 @@
+#include "get_table.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "storage/meta_tables.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+GetTable::GetTable(const std::string& name) : _name(name) {}
+
+const std::string& GetTable::table_name() const { return _name; }
+
+std::string GetTable::name() const { return "GetTable"; }
+
+std::string GetTable::description() const { return name() + " " + _name; }
+
+// meta tables are generated anew for every execution and thus always have a new version
+bool GetTable::is_cacheable() const { return !MetaTables::is_meta_table(_name); }
+
+std::shared_ptr<const Table> GetTable::_on_execute() const {
+  const auto table = StorageManager::get().get_table(_name);
+  if (!_row_limit) return table;
+
+  // Only the first rows are referenced, so that the table is not read beyond them. The output still refers to the
+  // stored table, e.g., for a Delete.
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    output_table->add_column_definition(table->column_name(column_id), table->column_type(column_id));
+  }
+  auto output_chunk = Chunk{};
+  append_reference_segments(output_chunk, table, first_rows_pos_list(*table, *_row_limit, _arena), _arena);
+  output_table->emplace_chunk(std::move(output_chunk));
+  return output_table;
+}
+
+}  // namespace opossum
@@ -9,13 +9,20 @@
 namespace opossum {
 
 // operator to retrieve a table from the StorageManager by specifying its name
+// With a row limit, the output only references the first rows of the table (see AbstractOperator::row_limit).
 class GetTable : public AbstractOperator {
  public:
   explicit GetTable(const std::string& name);
 
   const std::string& table_name() const;
 
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
  protected:
-  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  const std::string _name;
 };
 }  // namespace opossum
@@ -0,0 +1,237 @@
+#include "join_hash.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/table.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+#include "utils/bloom_filter.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Partitions of the build side should be small enough for their hash table to stay in the L2 cache
+constexpr auto PARTITION_CACHE_SIZE = size_t{256 * 1024};
+constexpr auto MAX_RADIX_BITS = size_t{10};
+
+// the join keys of an input, ordered by partition
+template <typename T>
+struct RadixPartitions {
+  std::vector<JoinKey<T>> join_keys;
+  // partition i consists of the join keys in [offsets[i], offsets[i + 1])
+  std::vector<size_t> offsets;
+};
+
+// Returns the partition of a value. The hash is mixed before its upper bits are taken, because std::hash is the
+// identity for integers.
+template <typename T>
+size_t partition_of(const T& value, const size_t radix_bits) {
+  if (radix_bits == 0) return 0;
+  const auto hash = static_cast<uint64_t>(std::hash<T>{}(value)) * uint64_t{0x9E3779B97F4A7C15};
+  return static_cast<size_t>(hash >> (64 - radix_bits));
+}
+
+template <typename T>
+RadixPartitions<T> radix_partition(const std::vector<std::vector<JoinKey<T>>>& chunk_join_keys,
+                                   const size_t radix_bits) {
+  const auto partition_count = size_t{1} << radix_bits;
+  const auto chunk_count = chunk_join_keys.size();
+
+  // count the join keys per chunk and partition
+  auto histograms = std::vector<std::vector<size_t>>(chunk_count, std::vector<size_t>(partition_count));
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    for (const auto& join_key : chunk_join_keys[chunk_index]) {
+      ++histograms[chunk_index][partition_of(join_key.value, radix_bits)];
+    }
+  });
+
+  // turn the histograms into the positions where each chunk writes its join keys of each partition
+  auto partitions = RadixPartitions<T>{};
+  partitions.offsets.resize(partition_count + 1);
+  auto position = size_t{0};
+  for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+    partitions.offsets[partition] = position;
+    for (auto chunk_index = size_t{0}; chunk_index < chunk_count; ++chunk_index) {
+      const auto count = histograms[chunk_index][partition];
+      histograms[chunk_index][partition] = position;
+      position += count;
+    }
+  }
+  partitions.offsets[partition_count] = position;
+
+  partitions.join_keys.resize(position);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    auto& write_positions = histograms[chunk_index];
+    for (const auto& join_key : chunk_join_keys[chunk_index]) {
+      partitions.join_keys[write_positions[partition_of(join_key.value, radix_bits)]++] = join_key;
+    }
+  });
+
+  return partitions;
+}
+
+template <typename T>
+size_t count_join_keys(const std::vector<std::vector<JoinKey<T>>>& chunk_join_keys) {
+  auto count = size_t{0};
+  for (const auto& join_keys : chunk_join_keys) count += join_keys.size();
+  return count;
+}
+
+}  // namespace
+
+JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator> left,
+                   const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                   const std::pair<ColumnID, ColumnID>& column_ids)
+    : AbstractJoin(left, right, mode, column_ids, ScanType::OpEquals) {}
+
+std::string JoinHash::name() const { return "JoinHash"; }
+
+std::shared_ptr<const Table> JoinHash::_on_execute() const {
+  auto output_table = _initialize_output_table();
+
+  resolve_data_type(_input_table_left()->column_type(_column_ids.first), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    _join<Type>(*output_table);
+  });
+
+  _finalize_output_table(*output_table);
+  return output_table;
+}
+
+bool JoinHash::_reduces_left_input() const {
+  // inner and semi joins discard the left rows without a join partner, so that the left scan can skip most of them
+  return _mode == JoinMode::Inner || _mode == JoinMode::Semi;
+}
+
+std::shared_ptr<const BloomFilter> JoinHash::build_bloom_filter() const {
+  const auto right_table = _input_right->get_output();
+  if (!right_table) return nullptr;
+
+  std::call_once(_bloom_filter_flag, [&] {
+    resolve_data_type(right_table->column_type(_column_ids.second), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      auto right_join_keys = materialize_join_keys<Type>(*right_table, _column_ids.second);
+      auto bloom_filter = std::make_shared<BloomFilter>(count_join_keys(right_join_keys));
+      for (const auto& join_keys : right_join_keys) {
+        for (const auto& join_key : join_keys) {
+          bloom_filter->insert(bloom_filter_hash(join_key.value));
+        }
+      }
+      _bloom_filter = std::move(bloom_filter);
+      _right_join_keys = std::move(right_join_keys);
+    });
+  });
+  return _bloom_filter;
+}
+
+template <typename T>
+void JoinHash::_join(Table& output_table) const {
+  auto null_key_rows = std::vector<std::vector<RowID>>{};
+  const auto left_join_keys = materialize_join_keys<T>(*_input_table_left(), _column_ids.first, {}, &null_key_rows);
+
+  // the right join keys may have been materialized for the Bloom filter of the left input already
+  auto right_join_keys = std::vector<std::vector<JoinKey<T>>>{};
+  if (auto* materialized_join_keys = std::get_if<std::vector<std::vector<JoinKey<T>>>>(&_right_join_keys)) {
+    right_join_keys = std::move(*materialized_join_keys);
+    _right_join_keys = std::monostate{};
+  } else {
+    right_join_keys = materialize_join_keys<T>(*_input_table_right(), _column_ids.second);
+  }
+  const auto left_count = count_join_keys(left_join_keys);
+  const auto right_count = count_join_keys(right_join_keys);
+
+  const auto build_left = _mode == JoinMode::Inner && left_count < right_count;
+  const auto build_count = build_left ? left_count : right_count;
+
+  auto radix_bits = size_t{0};
+  while (radix_bits < MAX_RADIX_BITS && (build_count * 2 * sizeof(JoinKey<T>) >> radix_bits) > PARTITION_CACHE_SIZE) {
+    ++radix_bits;
+  }
+
+  const auto build_partitions = radix_partition(build_left ? left_join_keys : right_join_keys, radix_bits);
+  const auto probe_partitions = radix_partition(build_left ? right_join_keys : left_join_keys, radix_bits);
+
+  const auto partition_count = size_t{1} << radix_bits;
+  auto left_pos_lists = std::vector<std::shared_ptr<PosList>>(partition_count);
+  auto right_pos_lists = std::vector<std::shared_ptr<PosList>>(partition_count);
+
+  parallel_for(partition_count, [&](const size_t partition) {
+    const auto build_begin = build_partitions.offsets[partition];
+    const auto build_end = build_partitions.offsets[partition + 1];
+    const auto probe_begin = probe_partitions.offsets[partition];
+    const auto probe_end = probe_partitions.offsets[partition + 1];
+
+    // The hash table maps each value to the most recently inserted row with that value. The other rows with that value
+    // are chained through next_row.
+    constexpr auto NO_ROW = std::numeric_limits<uint32_t>::max();
+    auto hash_table = std::unordered_map<T, uint32_t>{};
+    hash_table.reserve(build_end - build_begin);
+    auto next_row = std::vector<uint32_t>(build_end - build_begin, NO_ROW);
+    for (auto build_index = build_begin; build_index < build_end; ++build_index) {
+      const auto row = static_cast<uint32_t>(build_index - build_begin);
+      auto [entry, inserted] = hash_table.try_emplace(build_partitions.join_keys[build_index].value, row);
+      if (!inserted) {
+        next_row[row] = entry->second;
+        entry->second = row;
+      }
+    }
+
+    // Grown PosLists leave their old buffers behind in the arena. Most probe rows have at most one join partner, so
+    // that the output of the partition is reserved for one row per probe row.
+    auto left_pos_list = make_pos_list(_arena);
+    auto right_pos_list = make_pos_list(_arena);
+    left_pos_list->reserve(probe_end - probe_begin);
+    if (_mode == JoinMode::Inner || _mode == JoinMode::Left) right_pos_list->reserve(probe_end - probe_begin);
+    auto reported_row_count = size_t{0};
+    for (auto probe_index = probe_begin; probe_index < probe_end; ++probe_index) {
+      if ((probe_index - probe_begin) % ROW_LIMIT_CHECK_INTERVAL == 0 &&
+          _row_limit_reached(reported_row_count, left_pos_list->size())) {
+        break;
+      }
+
+      const auto& probe_join_key = probe_partitions.join_keys[probe_index];
+      const auto entry = hash_table.find(probe_join_key.value);
+      const auto first_row = entry == hash_table.end() ? NO_ROW : entry->second;
+
+      switch (_mode) {
+        case JoinMode::Inner:
+        case JoinMode::Left:
+          for (auto row = first_row; row != NO_ROW; row = next_row[row]) {
+            const auto& build_row_id = build_partitions.join_keys[build_begin + row].row_id;
+            left_pos_list->emplace_back(build_left ? build_row_id : probe_join_key.row_id);
+            right_pos_list->emplace_back(build_left ? probe_join_key.row_id : build_row_id);
+          }
+          if (_mode == JoinMode::Left && first_row == NO_ROW) {
+            left_pos_list->emplace_back(probe_join_key.row_id);
+            right_pos_list->emplace_back(NULL_ROW_ID);
+          }
+          break;
+        case JoinMode::Semi:
+        case JoinMode::Anti:
+          if ((first_row != NO_ROW) == (_mode == JoinMode::Semi)) left_pos_list->emplace_back(probe_join_key.row_id);
+          break;
+      }
+    }
+
+    left_pos_lists[partition] = std::move(left_pos_list);
+    right_pos_lists[partition] = std::move(right_pos_list);
+  });
+
+  for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+    if (left_pos_lists[partition]->empty()) continue;
+    _append_output_chunk(output_table, left_pos_lists[partition], right_pos_lists[partition]);
+  }
+  _append_null_key_rows(output_table, null_key_rows);
+}
+
+}  // namespace opossum
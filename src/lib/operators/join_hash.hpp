@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "abstract_join.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BloomFilter;
+class Table;
+
+// JoinHash joins two tables on the equality of one column each. Its output references the joined rows of both inputs.
+//
+// The join keys of both inputs are radix-partitioned on their hash, so that the hash table of each partition of the
+// build side fits into the cache. Materialization and partitioning run in parallel across chunks, building and
+// probing in parallel across partitions. Inner joins build on the smaller input. Left, semi, and anti joins need to
+// know which left rows have a match and thus build on the right input.
+//
+// If the left input of an inner or semi join is a TableScan that the join is the only consumer of, the scan receives a
+// Bloom filter over the join keys of the right input (semi join reduction), so that it already drops most left rows
+// without a join partner. For this, the right input has to be executed before the left one, which execute() takes
+// care of (see AbstractOperator::execute_after_operators). Otherwise, the scan runs without the filter. The join keys
+// of the right input are materialized once for the filter and the join.
+class JoinHash : public AbstractJoin {
+ public:
+  JoinHash(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+           const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids);
+
+  std::string name() const override;
+
+  // Returns a Bloom filter over the join keys of the right input, leaving out deleted rows and NULL rows, or nullptr
+  // if the right input has not been executed yet. The filter is built once, and its join keys are kept for the join.
+  std::shared_ptr<const BloomFilter> build_bloom_filter() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  template <typename T>
+  void _join(Table& output_table) const;
+
+  friend class TableScan;
+
+  // returns whether the join reduces its left input with a Bloom filter if it is the only consumer of the input
+  bool _reduces_left_input() const;
+
+  // the join keys of the right input of one of the data types, or std::monostate if there are none
+#define JOIN_KEYS_OF_TYPE(s, data, elem) std::vector<std::vector<JoinKey<elem>>>
+  using MaterializedJoinKeys =
+      std::variant<std::monostate, BOOST_PP_SEQ_ENUM(BOOST_PP_SEQ_TRANSFORM(JOIN_KEYS_OF_TYPE, _, data_types_macro))>;
+#undef JOIN_KEYS_OF_TYPE
+
+  mutable std::once_flag _bloom_filter_flag;
+  mutable std::shared_ptr<const BloomFilter> _bloom_filter;
+  // the join keys of the right input if they were materialized by build_bloom_filter and not yet taken by the join
+  mutable MaterializedJoinKeys _right_join_keys;
+};
+
+}  // namespace opossum
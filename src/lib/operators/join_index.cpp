@@ -0,0 +1,169 @@
+#include "join_index.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "storage/group_key_index.hpp"
+#include "storage/table.hpp"
+#include "utils/arena.hpp"
+#include "utils/parallel_for.hpp"
+#include "utils/parallel_sort.hpp"
+
+namespace opossum {
+
+JoinIndex::JoinIndex(const std::shared_ptr<const AbstractOperator> left,
+                     const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                     const std::pair<ColumnID, ColumnID>& column_ids)
+    : AbstractJoin(left, right, mode, column_ids, ScanType::OpEquals) {}
+
+std::string JoinIndex::name() const { return "JoinIndex"; }
+
+std::shared_ptr<const Table> JoinIndex::_on_execute() const {
+  auto output_table = _initialize_output_table();
+
+  resolve_data_type(_input_table_left()->column_type(_column_ids.first), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    _join<Type>(*output_table);
+  });
+
+  _finalize_output_table(*output_table);
+  return output_table;
+}
+
+template <typename T>
+void JoinIndex::_join(Table& output_table) const {
+  const auto& right_table = *_input_table_right();
+  const auto right_chunk_count = right_table.chunk_count();
+
+  // Indexes are only used on data tables, as the RowIDs of the output must point into the right input. The
+  // invalidation bitmaps are taken once, so that all batches see the same deletes.
+  auto indexes = std::vector<std::shared_ptr<const GroupKeyIndex<T>>>(right_chunk_count);
+  auto invalidation_bitmaps = std::vector<std::shared_ptr<const std::vector<uint64_t>>>(right_chunk_count);
+  auto indexed_chunks = std::vector<bool>(right_chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < right_chunk_count; ++chunk_id) {
+    const auto& chunk = right_table.get_chunk(chunk_id);
+    indexes[chunk_id] = std::dynamic_pointer_cast<const GroupKeyIndex<T>>(chunk.get_index(_column_ids.second));
+    invalidation_bitmaps[chunk_id] = chunk.invalidation_bitmap();
+    indexed_chunks[chunk_id] = static_cast<bool>(indexes[chunk_id]);
+  }
+
+  // the hash table for chunks without index maps each value to its most recently inserted row, see JoinHash
+  constexpr auto NO_ROW = std::numeric_limits<uint32_t>::max();
+  auto unindexed_join_keys = std::vector<JoinKey<T>>{};
+  for (auto& chunk_join_keys : materialize_join_keys<T>(right_table, _column_ids.second, indexed_chunks)) {
+    unindexed_join_keys.insert(unindexed_join_keys.end(), chunk_join_keys.cbegin(), chunk_join_keys.cend());
+  }
+  auto hash_table = std::unordered_map<T, uint32_t>{};
+  hash_table.reserve(unindexed_join_keys.size());
+  auto next_row = std::vector<uint32_t>(unindexed_join_keys.size(), NO_ROW);
+  for (auto row = uint32_t{0}; row < unindexed_join_keys.size(); ++row) {
+    auto [entry, inserted] = hash_table.try_emplace(unindexed_join_keys[row].value, row);
+    if (!inserted) {
+      next_row[row] = entry->second;
+      entry->second = row;
+    }
+  }
+
+  const auto compare = [](const JoinKey<T>& lhs, const JoinKey<T>& rhs) { return lhs.value < rhs.value; };
+  auto null_key_rows = std::vector<std::vector<RowID>>{};
+  const auto left_join_keys =
+      parallel_sort(materialize_join_keys<T>(*_input_table_left(), _column_ids.first, {}, &null_key_rows), compare);
+  const auto left_size = left_join_keys.size();
+  const auto batch_count = std::min(TaskScheduler::get().worker_count() * 4, left_size / 1024 + 1);
+  auto left_pos_lists = std::vector<std::shared_ptr<PosList>>(batch_count);
+  auto right_pos_lists = std::vector<std::shared_ptr<PosList>>(batch_count);
+
+  parallel_for(batch_count, [&](const size_t batch) {
+    const auto batch_begin = batch * left_size / batch_count;
+    const auto batch_end = (batch + 1) * left_size / batch_count;
+
+    auto left_pos_list = make_pos_list(_arena);
+    auto right_pos_list = make_pos_list(_arena);
+    // the batch is expected to produce about one output row per left row
+    left_pos_list->reserve(batch_end - batch_begin);
+    if (_mode == JoinMode::Inner || _mode == JoinMode::Left) right_pos_list->reserve(batch_end - batch_begin);
+    left_pos_lists[batch] = left_pos_list;
+    right_pos_lists[batch] = right_pos_list;
+
+    // All rows of a batch are needed to know which left rows have no match. Thus, the row limit is checked per batch.
+    auto reported_row_count = size_t{0};
+    if (_row_limit_reached(reported_row_count, 0)) return;
+
+    auto has_match = std::vector<bool>(batch_end - batch_begin);
+
+    const auto emit_match = [&](const size_t left_index, const RowID& right_row_id) {
+      has_match[left_index - batch_begin] = true;
+      if (_mode == JoinMode::Inner || _mode == JoinMode::Left) {
+        left_pos_list->emplace_back(left_join_keys[left_index].row_id);
+        right_pos_list->emplace_back(right_row_id);
+      }
+    };
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < right_chunk_count && batch_begin < batch_end; ++chunk_id) {
+      if (!indexes[chunk_id]) continue;
+      const auto& index = *indexes[chunk_id];
+      const auto& dictionary = index.dictionary();
+      const auto* invalidation_bitmap = invalidation_bitmaps[chunk_id].get();
+
+      // the left keys are sorted, so that the search for the next distinct value starts at the previous one
+      auto dictionary_position = dictionary.cbegin();
+      auto run_begin = batch_begin;
+      while (run_begin < batch_end && dictionary_position != dictionary.cend()) {
+        const auto& value = left_join_keys[run_begin].value;
+        auto run_end = run_begin + 1;
+        while (run_end < batch_end && !(value < left_join_keys[run_end].value)) ++run_end;
+
+        dictionary_position = std::lower_bound(dictionary_position, dictionary.cend(), value);
+        if (dictionary_position != dictionary.cend() && !(value < *dictionary_position)) {
+          const auto value_id = ValueID{static_cast<ValueID::base_type>(dictionary_position - dictionary.cbegin())};
+          const auto [positions_begin, positions_end] = index.positions(value_id);
+          for (auto position = positions_begin; position != positions_end; ++position) {
+            if (!is_valid_in_bitmap(invalidation_bitmap, *position)) continue;
+            for (auto left_index = run_begin; left_index < run_end; ++left_index) {
+              emit_match(left_index, RowID{chunk_id, *position});
+            }
+          }
+        }
+        run_begin = run_end;
+      }
+    }
+
+    if (!unindexed_join_keys.empty()) {
+      for (auto left_index = batch_begin; left_index < batch_end; ++left_index) {
+        const auto entry = hash_table.find(left_join_keys[left_index].value);
+        if (entry == hash_table.end()) continue;
+        for (auto row = entry->second; row != NO_ROW; row = next_row[row]) {
+          emit_match(left_index, unindexed_join_keys[row].row_id);
+        }
+      }
+    }
+
+    for (auto left_index = batch_begin; left_index < batch_end; ++left_index) {
+      const auto& left_row_id = left_join_keys[left_index].row_id;
+      const auto matched = has_match[left_index - batch_begin];
+      if (_mode == JoinMode::Left && !matched) {
+        left_pos_list->emplace_back(left_row_id);
+        right_pos_list->emplace_back(NULL_ROW_ID);
+      } else if ((_mode == JoinMode::Semi && matched) || (_mode == JoinMode::Anti && !matched)) {
+        left_pos_list->emplace_back(left_row_id);
+      }
+    }
+
+    _row_limit_reached(reported_row_count, left_pos_list->size());
+  });
+
+  for (auto batch = size_t{0}; batch < batch_count; ++batch) {
+    if (left_pos_lists[batch]->empty()) continue;
+    _append_output_chunk(output_table, left_pos_lists[batch], right_pos_lists[batch]);
+  }
+  _append_null_key_rows(output_table, null_key_rows);
+}
+
+}  // namespace opossum
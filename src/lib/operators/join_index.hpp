@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "abstract_join.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// JoinIndex joins two tables on the equality of one column each by probing the chunk indexes (see
+// Table::create_index) of the right input. It pays off if a small left input is joined with a large, indexed right
+// input, as the right input is neither materialized nor hashed.
+//
+// The left join keys are sorted and split into batches that are probed in parallel. Within a batch, the keys of each
+// indexed chunk are looked up in ascending order, so that each lookup continues the binary search in the dictionary
+// where the previous one ended and each distinct value is looked up only once. Chunks without an index, e.g., the
+// unencoded chunk that is appended to, are joined through a hash table built over their join keys.
+class JoinIndex : public AbstractJoin {
+ public:
+  JoinIndex(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+            const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids);
+
+  std::string name() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  template <typename T>
+  void _join(Table& output_table) const;
+};
+
+}  // namespace opossum
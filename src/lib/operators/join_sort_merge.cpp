@@ -0,0 +1,151 @@
+#include "join_sort_merge.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "storage/table.hpp"
+#include "utils/arena.hpp"
+#include "utils/parallel_for.hpp"
+#include "utils/parallel_sort.hpp"
+
+namespace opossum {
+
+JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator> left,
+                             const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                             const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
+    : AbstractJoin(left, right, mode, column_ids, scan_type) {}
+
+std::string JoinSortMerge::name() const { return "JoinSortMerge"; }
+
+std::shared_ptr<const Table> JoinSortMerge::_on_execute() const {
+  auto output_table = _initialize_output_table();
+
+  resolve_data_type(_input_table_left()->column_type(_column_ids.first), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    _join<Type>(*output_table);
+  });
+
+  _finalize_output_table(*output_table);
+  return output_table;
+}
+
+template <typename T>
+void JoinSortMerge::_join(Table& output_table) const {
+  const auto compare = [](const JoinKey<T>& lhs, const JoinKey<T>& rhs) { return lhs.value < rhs.value; };
+  auto null_key_rows = std::vector<std::vector<RowID>>{};
+  const auto left_join_keys =
+      parallel_sort(materialize_join_keys<T>(*_input_table_left(), _column_ids.first, {}, &null_key_rows), compare);
+  const auto right_join_keys =
+      parallel_sort(materialize_join_keys<T>(*_input_table_right(), _column_ids.second), compare);
+
+  const auto left_size = left_join_keys.size();
+  const auto right_size = right_join_keys.size();
+  const auto range_count = std::min(TaskScheduler::get().worker_count() * 4, left_size / 4096 + 1);
+  auto left_pos_lists = std::vector<std::shared_ptr<PosList>>(range_count);
+  auto right_pos_lists = std::vector<std::shared_ptr<PosList>>(range_count);
+
+  parallel_for(range_count, [&](const size_t range) {
+    const auto left_begin = range * left_size / range_count;
+    const auto left_end = (range + 1) * left_size / range_count;
+
+    auto left_pos_list = make_pos_list(_arena);
+    auto right_pos_list = make_pos_list(_arena);
+    if (left_begin == left_end) {
+      left_pos_lists[range] = std::move(left_pos_list);
+      right_pos_lists[range] = std::move(right_pos_list);
+      return;
+    }
+
+    // one output row per left row, which is exact for left, semi, and anti joins on distinct right keys
+    left_pos_list->reserve(left_end - left_begin);
+    if (_mode == JoinMode::Inner || _mode == JoinMode::Left) right_pos_list->reserve(left_end - left_begin);
+
+    // [lower, upper) are the right keys that are equal to the current left value
+    const auto first_value = JoinKey<T>{left_join_keys[left_begin].value, RowID{}};
+    auto lower = static_cast<size_t>(std::lower_bound(right_join_keys.begin(), right_join_keys.end(), first_value,
+                                                      compare) -
+                                     right_join_keys.begin());
+    auto upper = lower;
+
+    const auto emit_matches = [&](const RowID& left_row_id, const size_t begin, const size_t end) {
+      for (auto right_index = begin; right_index < end; ++right_index) {
+        left_pos_list->emplace_back(left_row_id);
+        right_pos_list->emplace_back(right_join_keys[right_index].row_id);
+      }
+    };
+
+    auto reported_row_count = size_t{0};
+    for (auto left_index = left_begin; left_index < left_end; ++left_index) {
+      if ((left_index - left_begin) % ROW_LIMIT_CHECK_INTERVAL == 0 &&
+          _row_limit_reached(reported_row_count, left_pos_list->size())) {
+        break;
+      }
+
+      const auto& left_value = left_join_keys[left_index].value;
+      while (lower < right_size && right_join_keys[lower].value < left_value) ++lower;
+      upper = std::max(upper, lower);
+      while (upper < right_size && !(left_value < right_join_keys[upper].value)) ++upper;
+
+      // the matching right rows are [first_begin, first_end) and [second_begin, second_end)
+      auto first_begin = size_t{0};
+      auto first_end = size_t{0};
+      auto second_begin = size_t{0};
+      auto second_end = size_t{0};
+      switch (_scan_type) {
+        case ScanType::OpEquals:
+          std::tie(first_begin, first_end) = std::make_pair(lower, upper);
+          break;
+        case ScanType::OpNotEquals:
+          std::tie(first_begin, first_end, second_begin, second_end) = std::make_tuple(0, lower, upper, right_size);
+          break;
+        case ScanType::OpLessThan:
+          std::tie(first_begin, first_end) = std::make_pair(upper, right_size);
+          break;
+        case ScanType::OpLessThanEquals:
+          std::tie(first_begin, first_end) = std::make_pair(lower, right_size);
+          break;
+        case ScanType::OpGreaterThan:
+          std::tie(first_begin, first_end) = std::make_pair(0, lower);
+          break;
+        case ScanType::OpGreaterThanEquals:
+          std::tie(first_begin, first_end) = std::make_pair(0, upper);
+          break;
+      }
+
+      const auto& left_row_id = left_join_keys[left_index].row_id;
+      const auto has_match = first_begin < first_end || second_begin < second_end;
+      switch (_mode) {
+        case JoinMode::Inner:
+        case JoinMode::Left:
+          emit_matches(left_row_id, first_begin, first_end);
+          emit_matches(left_row_id, second_begin, second_end);
+          if (_mode == JoinMode::Left && !has_match) {
+            left_pos_list->emplace_back(left_row_id);
+            right_pos_list->emplace_back(NULL_ROW_ID);
+          }
+          break;
+        case JoinMode::Semi:
+        case JoinMode::Anti:
+          if (has_match == (_mode == JoinMode::Semi)) left_pos_list->emplace_back(left_row_id);
+          break;
+      }
+    }
+
+    left_pos_lists[range] = std::move(left_pos_list);
+    right_pos_lists[range] = std::move(right_pos_list);
+  });
+
+  for (auto range = size_t{0}; range < range_count; ++range) {
+    if (left_pos_lists[range]->empty()) continue;
+    _append_output_chunk(output_table, left_pos_lists[range], right_pos_lists[range]);
+  }
+  _append_null_key_rows(output_table, null_key_rows);
+}
+
+}  // namespace opossum
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "abstract_join.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// JoinSortMerge joins two tables on a predicate `left_value <scan_type> right_value`, which may be any ScanType. This
+// avoids a quadratic nested loop for range predicates. All join modes are supported.
+//
+// The join keys of both inputs are sorted in parallel (sorting the keys of each chunk, then merging them in parallel,
+// see parallel_sort). The sorted left keys are cut into ranges that are joined independently and in parallel: For
+// each left value, the matching right rows form one contiguous range of the sorted right keys, or two for
+// OpNotEquals, whose bounds only move forward while the left values increase.
+class JoinSortMerge : public AbstractJoin {
+ public:
+  JoinSortMerge(const std::shared_ptr<const AbstractOperator> left,
+                const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+
+  std::string name() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  template <typename T>
+  void _join(Table& output_table) const;
+};
+
+}  // namespace opossum
@@ -0,0 +1,45 @@
+#include "limit.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+Limit::Limit(const std::shared_ptr<const AbstractOperator> in, const size_t row_count)
+    : AbstractOperator(in), _row_count(row_count) {}
+
+size_t Limit::row_count() const { return _row_count; }
+
+std::string Limit::name() const { return "Limit"; }
+
+std::string Limit::description() const { return name() + " " + std::to_string(_row_count); }
+
+bool Limit::is_cacheable() const { return true; }
+
+std::shared_ptr<const Table> Limit::_on_execute() const {
+  const auto input_table = _input_table_left();
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto output_chunk = Chunk{};
+  append_reference_segments(output_chunk, input_table, first_rows_pos_list(*input_table, _row_count, _arena), _arena);
+  output_table->emplace_chunk(std::move(output_chunk));
+  return output_table;
+}
+
+std::optional<size_t> Limit::_input_row_limit() const {
+  // a limit on top of this one may need even fewer rows
+  const auto row_limit = this->row_limit();
+  return row_limit ? std::min(*row_limit, _row_count) : _row_count;
+}
+
+}  // namespace opossum
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// Limit returns the first row_count rows of its input, or all of them if there are fewer. The output references these
+// rows. Deleted rows are skipped.
+//
+// If the Limit is the only consumer of its input, the input takes the row count as its row limit (see
+// AbstractOperator::row_limit), so that scans, joins, and GetTable stop producing chunks once they have enough rows,
+// instead of computing their full output. Inputs that other operators consume as well produce their full output.
+class Limit : public AbstractOperator {
+ public:
+  Limit(const std::shared_ptr<const AbstractOperator> in, const size_t row_count);
+
+  size_t row_count() const;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+  std::optional<size_t> _input_row_limit() const override;
+
+  const size_t _row_count;
+};
+
+}  // namespace opossum
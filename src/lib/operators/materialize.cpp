@@ -0,0 +1,137 @@
+#include "materialize.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the number of rows by which the referenced values are prefetched ahead of the gather loop
+constexpr auto PREFETCH_DISTANCE = size_t{16};
+
+// calls read(chunk_offset) for the rows [begin, end) of the PosList and stores the results, while prefetching the
+// address that prefetch_address(chunk_offset) returns for a later row
+template <typename T, typename Read, typename PrefetchAddress>
+void gather(const PosList& pos_list, const size_t begin, const size_t end, pmr_vector<T>& values, const Read& read,
+            const PrefetchAddress& prefetch_address) {
+  for (auto index = begin; index < end; ++index) {
+    if (index + PREFETCH_DISTANCE < end) {
+      __builtin_prefetch(prefetch_address(pos_list[index + PREFETCH_DISTANCE].chunk_offset));
+    }
+    values[index] = read(pos_list[index].chunk_offset);
+  }
+}
+
+// returns the values of the rows that the reference segment points to
+template <typename T>
+pmr_vector<T> gather_values(const ReferenceSegment& reference_segment, const PolymorphicAllocator<T>& allocator) {
+  const auto& pos_list = *reference_segment.pos_list();
+  const auto& referenced_table = *reference_segment.referenced_table();
+  const auto size = pos_list.size();
+
+  // NULL rows keep the default value
+  auto values = pmr_vector<T>(size, allocator);
+  auto run_begin = size_t{0};
+  while (run_begin < size) {
+    const auto chunk_id = pos_list[run_begin].chunk_id;
+    auto run_end = run_begin + 1;
+    while (run_end < size && pos_list[run_end].chunk_id == chunk_id) ++run_end;
+
+    if (chunk_id != NULL_ROW_ID.chunk_id) {
+      const auto segment =
+          referenced_table.get_chunk(chunk_id).get_segment(reference_segment.referenced_column_id());
+      switch (segment->encoding_type()) {
+        case EncodingType::Unencoded: {
+          const auto& segment_values = static_cast<const ValueSegment<T>&>(*segment).values();
+          gather(
+              pos_list, run_begin, run_end, values,
+              [&](const ChunkOffset chunk_offset) { return segment_values[chunk_offset]; },
+              [&](const ChunkOffset chunk_offset) { return &segment_values[chunk_offset]; });
+          break;
+        }
+        case EncodingType::Dictionary: {
+          const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(*segment);
+          const auto& dictionary = *dictionary_segment.dictionary();
+          resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+            gather(
+                pos_list, run_begin, run_end, values,
+                [&](const ChunkOffset chunk_offset) { return dictionary[value_ids[chunk_offset]]; },
+                [&](const ChunkOffset chunk_offset) { return &value_ids[chunk_offset]; });
+          });
+          break;
+        }
+        default:
+          Fail("Reference segments must reference value or dictionary segments");
+      }
+    }
+    run_begin = run_end;
+  }
+  return values;
+}
+
+}  // namespace
+
+Materialize::Materialize(const std::shared_ptr<const AbstractOperator> in, const EncodingType encoding_type)
+    : AbstractOperator(in), _encoding_type(encoding_type) {
+  Assert(encoding_type == EncodingType::Unencoded || encoding_type == EncodingType::Dictionary,
+         "Materialize can only produce value or dictionary segments");
+}
+
+EncodingType Materialize::encoding_type() const { return _encoding_type; }
+
+std::string Materialize::name() const { return "Materialize"; }
+
+std::string Materialize::description() const { return name() + " " + encoding_type_to_string(_encoding_type); }
+
+bool Materialize::is_cacheable() const { return true; }
+
+std::shared_ptr<const Table> Materialize::_on_execute() const {
+  const auto input_table = _input_table_left();
+  const auto& first_chunk = input_table->get_chunk(ChunkID{0});
+  if (first_chunk.column_count() == 0 ||
+      first_chunk.get_segment(ColumnID{0})->encoding_type() != EncodingType::Reference) {
+    return input_table;
+  }
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto output_chunks = std::vector<Chunk>(input_table->chunk_count());
+  parallel_for(output_chunks.size(), [&](const size_t chunk_index) {
+    const auto& input_chunk = input_table->get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_index)});
+    auto& output_chunk = output_chunks[chunk_index];
+    for (auto column_id = ColumnID{0}; column_id < input_chunk.column_count(); ++column_id) {
+      const auto& reference_segment = static_cast<const ReferenceSegment&>(*input_chunk.get_segment(column_id));
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        auto values = gather_values<Type>(reference_segment, output_chunk.get_allocator());
+        auto segment = std::shared_ptr<BaseSegment>{std::make_shared<ValueSegment<Type>>(std::move(values))};
+        if (_encoding_type == EncodingType::Dictionary) {
+          segment = std::make_shared<DictionarySegment<Type>>(segment, output_chunk.get_allocator());
+        }
+        output_chunk.add_segment(keep_memory_resource_alive(std::move(segment), output_chunk.memory_resource()));
+      });
+    }
+  });
+
+  for (auto& output_chunk : output_chunks) {
+    if (output_chunk.column_count() > 0) output_table->emplace_chunk(std::move(output_chunk));
+  }
+  return output_table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_operator.hpp"
+#include "storage/encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// Materialize turns a table that references other tables, e.g., the output of a chain of scans, into a data table
+// with the same rows. Reading the output then costs no indirection through PosLists, which pays off for operators
+// that access the same rows repeatedly. Data tables are passed through unchanged.
+//
+// Each reference segment is gathered into a ValueSegment, or a DictionarySegment if requested, with one output chunk
+// per input chunk. The PosList is processed in runs of rows from the same referenced chunk, so that the referenced
+// segment and its encoding are resolved once per run. The gather loop of a run is specialized for value and
+// dictionary segments and prefetches the referenced values a few rows ahead, as they are accessed in random order.
+class Materialize : public AbstractOperator {
+ public:
+  explicit Materialize(const std::shared_ptr<const AbstractOperator> in,
+                       const EncodingType encoding_type = EncodingType::Unencoded);
+
+  EncodingType encoding_type() const;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  const EncodingType _encoding_type;
+};
+
+}  // namespace opossum
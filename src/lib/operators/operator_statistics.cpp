@@ -0,0 +1,37 @@
+#include "operator_statistics.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "abstract_operator.hpp"
+
+namespace opossum {
+
+OperatorStatistics& OperatorStatistics::get() {
+  static OperatorStatistics instance;
+  return instance;
+}
+
+void OperatorStatistics::record(const std::string& operator_name, const OperatorPerformanceData& performance_data) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  auto& entry = _entries[operator_name];
+  ++entry.execution_count;
+  if (performance_data.cached) ++entry.cached_count;
+  entry.walltime += performance_data.walltime;
+  entry.cpu_time += performance_data.cpu_time;
+  entry.input_row_count += performance_data.input_row_count;
+  entry.output_row_count += performance_data.output_row_count;
+}
+
+std::map<std::string, OperatorStatisticsEntry> OperatorStatistics::entries() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _entries;
+}
+
+void OperatorStatistics::reset() {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  _entries.clear();
+}
+
+}  // namespace opossum
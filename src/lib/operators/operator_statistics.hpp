@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+struct OperatorPerformanceData;
+
+// the performance data of all executions of operators with the same name, summed up
+struct OperatorStatisticsEntry {
+  uint64_t execution_count = 0;
+  // the executions whose output was taken from the ResultCache
+  uint64_t cached_count = 0;
+  std::chrono::nanoseconds walltime{0};
+  std::chrono::nanoseconds cpu_time{0};
+  uint64_t input_row_count = 0;
+  uint64_t output_row_count = 0;
+};
+
+// OperatorStatistics is a singleton that sums up the performance data of every executed operator by its name, e.g., to
+// find where the time of a deployment goes via the meta_operators table (see MetaTables).
+class OperatorStatistics : private Noncopyable {
+ public:
+  static OperatorStatistics& get();
+
+  // adds an execution of the operator with the given name, called by AbstractOperator::execute
+  void record(const std::string& operator_name, const OperatorPerformanceData& performance_data);
+
+  // returns the entries of all operators that were executed, by name
+  std::map<std::string, OperatorStatisticsEntry> entries() const;
+
+  void reset();
+
+  OperatorStatistics(OperatorStatistics&&) = delete;
+
+ protected:
+  OperatorStatistics() = default;
+
+  mutable std::mutex _mutex;
+  std::map<std::string, OperatorStatisticsEntry> _entries;
+};
+
+}  // namespace opossum
@@ -0,0 +1,154 @@
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "projection.hpp"
+#include "storage/table.hpp"
+#include "table_scan.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// returns the input of the chain of operators that a Pipeline fuses
+std::shared_ptr<const AbstractOperator> pipeline_input(const std::shared_ptr<const AbstractOperator>& last_operator) {
+  auto op = last_operator;
+  if (std::dynamic_pointer_cast<const Projection>(op)) op = op->input_left();
+  while (std::dynamic_pointer_cast<const TableScan>(op)) op = op->input_left();
+  return op;
+}
+
+}  // namespace
+
+Pipeline::Pipeline(const std::shared_ptr<const AbstractOperator>& last_operator)
+    : AbstractOperator(pipeline_input(last_operator)) {
+  // The fused operators are not executed, so that only the next fused operator may consume each of them.
+  const auto assert_fusable = [&](const AbstractOperator& op) {
+    const auto expected_consumer_count = size_t{&op == last_operator.get() ? 0u : 1u};
+    Assert(op.consumer_count() == expected_consumer_count, "Fused operators must not have other consumers");
+  };
+
+  auto op = last_operator;
+  _projection = std::dynamic_pointer_cast<const Projection>(op);
+  if (_projection) {
+    assert_fusable(*op);
+    op = op->input_left();
+  }
+  while (const auto table_scan = std::dynamic_pointer_cast<const TableScan>(op)) {
+    assert_fusable(*op);
+    _table_scans.emplace_back(table_scan);
+    op = op->input_left();
+  }
+  std::reverse(_table_scans.begin(), _table_scans.end());
+  Assert(op != last_operator, "Pipelines consist of TableScans and Projections");
+}
+
+std::vector<std::shared_ptr<const AbstractOperator>> Pipeline::execute_after_operators() const {
+  auto operators = AbstractOperator::execute_after_operators();
+  // e.g., scans that receive Bloom filters from joins
+  for (const auto& table_scan : _table_scans) {
+    for (auto& other : table_scan->execute_after_operators()) operators.emplace_back(std::move(other));
+  }
+  return operators;
+}
+
+const std::vector<std::shared_ptr<const TableScan>>& Pipeline::table_scans() const { return _table_scans; }
+
+const std::shared_ptr<const Projection>& Pipeline::projection() const { return _projection; }
+
+std::string Pipeline::name() const { return "Pipeline"; }
+
+std::shared_ptr<const Table> Pipeline::_on_execute() const {
+  const auto input_table = _input_table_left();
+  const auto column_count = input_table->column_count();
+
+  auto output_table = std::make_shared<Table>();
+  auto data_types = std::vector<std::string>{};
+  if (_projection) {
+    Assert(!_projection->expressions().empty(), "Projection needs at least one expression");
+    for (const auto& expression : _projection->expressions()) {
+      data_types.emplace_back(expression->data_type(*input_table));
+      output_table->add_column_definition(expression->description(*input_table), data_types.back());
+    }
+  } else {
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+    }
+  }
+
+  auto bloom_filters = std::vector<TableScan::BloomFilters>{};
+  // the NULL rows of all scanned columns are removed, e.g., those of a left join, as they never match
+  auto scanned_column_ids = std::vector<ColumnID>{};
+  for (const auto& table_scan : _table_scans) {
+    bloom_filters.emplace_back(table_scan->_build_bloom_filters());
+    scanned_column_ids.emplace_back(table_scan->column_id());
+  }
+
+  // Returns the output chunk of an input chunk. Without matches, the output chunk is only created if keep_empty is set
+  // and has no columns otherwise.
+  const auto process_chunk = [&](const ChunkID chunk_id, const bool keep_empty) {
+    const auto& input_chunk = input_table->get_chunk(chunk_id);
+    // the only chunk of an input without rows may not have any columns
+    if (input_chunk.column_count() == 0 && input_chunk.size() == 0) return Chunk{};
+    Assert(input_chunk.column_count() == column_count, "Input chunk does not match the columns of its table");
+    if (_table_scans.empty()) return _projection->_project_chunk(input_table, input_chunk, data_types);
+
+    // all scans operate on the columns of the input chunk, as scans do not change the columns
+    auto matches = _table_scans.front()->_match_chunk(*input_table, input_chunk, bloom_filters.front());
+    TableScan::_remove_invalid_rows(matches, input_chunk, scanned_column_ids);
+    for (auto scan_index = size_t{1}; scan_index < _table_scans.size(); ++scan_index) {
+      if (TableScan::_count_matches(matches) == 0) break;
+      const auto& table_scan = *_table_scans[scan_index];
+      const auto scan_matches = table_scan._match_chunk(*input_table, input_chunk, bloom_filters[scan_index]);
+      for (auto word_index = size_t{0}; word_index < matches.size(); ++word_index) {
+        matches[word_index] &= scan_matches[word_index];
+      }
+    }
+    if (TableScan::_count_matches(matches) == 0 && !keep_empty) return Chunk{};
+
+    auto scanned_chunk = TableScan::_make_output_chunk(input_table, chunk_id, matches, _arena);
+    if (!_projection) return scanned_chunk;
+    return _projection->_project_chunk(input_table, scanned_chunk, data_types);
+  };
+
+  // Empty results still consist of one chunk, so that the output has segments for all of its columns.
+  const auto chunk_count = input_table->chunk_count();
+  auto emitted_chunk = false;
+  if (_row_limit) {
+    auto output_row_count = size_t{0};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      if (emitted_chunk && output_row_count >= *_row_limit) {
+        _performance_data.skipped_chunk_count = chunk_count - chunk_id;
+        break;
+      }
+      auto output_chunk = process_chunk(chunk_id, chunk_id + 1 == chunk_count && !emitted_chunk);
+      if (output_chunk.column_count() == 0) continue;
+      output_row_count += output_chunk.size();
+      output_table->emplace_chunk(std::move(output_chunk));
+      emitted_chunk = true;
+    }
+    return output_table;
+  }
+
+  auto output_chunks = std::vector<Chunk>(chunk_count);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    output_chunks[chunk_index] = process_chunk(chunk_id, chunk_id + 1 == chunk_count);
+  });
+
+  for (auto& output_chunk : output_chunks) {
+    if (output_chunk.column_count() == 0) continue;
+    if (output_chunk.size() == 0 && emitted_chunk) continue;
+    output_table->emplace_chunk(std::move(output_chunk));
+    emitted_chunk = true;
+  }
+  return output_table;
+}
+
+}  // namespace opossum
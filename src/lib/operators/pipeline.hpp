@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Projection;
+class Table;
+class TableScan;
+
+// Pipeline executes a chain of TableScans, optionally followed by a Projection, as one operator. Instead of
+// materializing the output of each stage as a table, it pushes each chunk of its input through all stages while the
+// chunk is still in the cache: the scans are applied to the chunk one after another, narrowing down a bitmap of
+// matches, so that only one PosList is created per chunk. The Projection then evaluates its expressions on the chunk
+// that references these matches.
+//
+// The input of the Pipeline is the input of the first scan, e.g., a pipeline breaker such as a join, an aggregate, or
+// a sort, which is executed as usual. The fused operators themselves are not executed, so that they must not have
+// other consumers. The output equals that of the last fused operator. As with TableScan, chunks are processed in
+// parallel unless a row limit is set (see AbstractOperator::row_limit).
+class Pipeline : public AbstractOperator {
+ public:
+  // fuses the operators that lead to the given one, which must be a TableScan or a Projection on top of TableScans
+  explicit Pipeline(const std::shared_ptr<const AbstractOperator>& last_operator);
+
+  // the fused scans in the order in which they are applied
+  const std::vector<std::shared_ptr<const TableScan>>& table_scans() const;
+
+  // the fused projection, if any
+  const std::shared_ptr<const Projection>& projection() const;
+
+  // includes those of the fused scans, e.g., the inputs of joins that pass Bloom filters to them
+  std::vector<std::shared_ptr<const AbstractOperator>> execute_after_operators() const override;
+
+  std::string name() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  std::vector<std::shared_ptr<const TableScan>> _table_scans;
+  std::shared_ptr<const Projection> _projection;
+};
+
+}  // namespace opossum
@@ -0,0 +1,69 @@
+#include "plan_printer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "storage/table.hpp"
+
+namespace opossum {
+
+namespace {
+
+// prints a duration in milliseconds with microsecond precision
+std::ostream& print_duration(std::ostream& out, const std::chrono::nanoseconds duration) {
+  const auto milliseconds = std::chrono::duration<double, std::milli>{duration}.count();
+  return out << std::fixed << std::setprecision(3) << milliseconds << " ms";
+}
+
+}  // namespace
+
+void PlanPrinter::print(const std::shared_ptr<const AbstractOperator>& op, std::ostream& out) {
+  _print_operator(*op, out, "", "");
+}
+
+void PlanPrinter::_print_operator(const AbstractOperator& op, std::ostream& out, const std::string& prefix,
+                                  const std::string& child_prefix) {
+  out << prefix << op.description();
+  if (op.row_limit()) out << " LIMIT " << *op.row_limit();
+  if (!op.get_output()) {
+    out << " (not executed)" << std::endl;
+  } else {
+    const auto& performance_data = op.performance_data();
+    out << " (";
+    if (performance_data.cached) out << "cached, ";
+    print_duration(out << "wall ", performance_data.walltime);
+    print_duration(out << ", cpu ", performance_data.cpu_time);
+    out << ", rows " << performance_data.input_row_count << " -> " << performance_data.output_row_count;
+    out << ", chunks " << performance_data.processed_chunk_count << " processed / "
+        << performance_data.skipped_chunk_count << " skipped";
+    out << ", output " << performance_data.output_bytes << " bytes";
+    if (performance_data.hardware_counters) {
+      // Per row means per input row, as operators spend their time on the input, or per output row for leaves.
+      const auto& counters = *performance_data.hardware_counters;
+      const auto row_count = std::max(performance_data.input_row_count ? performance_data.input_row_count
+                                                                       : performance_data.output_row_count,
+                                      uint64_t{1});
+      out << std::setprecision(2) << ", IPC " << counters.ipc() << ", LLC misses/row "
+          << static_cast<double>(counters.llc_misses) / static_cast<double>(row_count) << ", branch misses/row "
+          << static_cast<double>(counters.branch_misses) / static_cast<double>(row_count);
+    }
+    out << ")" << std::endl;
+  }
+
+  const auto left = op.input_left();
+  const auto right = op.input_right();
+  if (left) {
+    if (right) {
+      _print_operator(*left, out, child_prefix + "|- ", child_prefix + "|  ");
+    } else {
+      _print_operator(*left, out, child_prefix + "`- ", child_prefix + "   ");
+    }
+  }
+  if (right) _print_operator(*right, out, child_prefix + "`- ", child_prefix + "   ");
+}
+
+}  // namespace opossum
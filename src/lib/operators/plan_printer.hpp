@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "abstract_operator.hpp"
+
+namespace opossum {
+
+// PlanPrinter prints the operator tree of an executed plan like EXPLAIN ANALYZE, one operator per line with its
+// description and performance data (see AbstractOperator::performance_data), e.g.:
+//
+// Limit 1 (wall 0.004 ms, cpu 0.004 ms, rows 2 -> 1, chunks 1 processed / 0 skipped, output 8 bytes)
+// `- TableScan #0 >= 1234 LIMIT 1 (wall 0.021 ms, cpu 0.020 ms, rows 3 -> 2, chunks 1 processed / 1 skipped, ...)
+//    `- GetTable int_float (wall 0.002 ms, cpu 0.002 ms, rows 0 -> 3, chunks 0 processed / 0 skipped, output 0 bytes)
+//
+// The left input is printed before the right one. Operators whose output was taken from the ResultCache are marked as
+// cached, and their inputs as not executed. If HardwareCounters were enabled and are available, the instructions per
+// cycle and the LLC and branch misses per row are appended.
+class PlanPrinter {
+ public:
+  static void print(const std::shared_ptr<const AbstractOperator>& op, std::ostream& out = std::cout);
+
+ protected:
+  static void _print_operator(const AbstractOperator& op, std::ostream& out, const std::string& prefix,
+                              const std::string& child_prefix);
+};
+
+}  // namespace opossum
@@ -23,7 +23,9 @@ void Print::print(std::shared_ptr<const Table> table, std::ostream& out) {
   Print(table_wrapper, out).execute();
 }
 
-std::shared_ptr<const Table> Print::_on_execute() {
+std::string Print::name() const { return "Print"; }
+
+std::shared_ptr<const Table> Print::_on_execute() const {
   PerformanceWarningDisabler pwd;
 
   auto widths = column_string_widths(8, 20, _input_table_left());
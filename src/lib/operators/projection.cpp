@@ -0,0 +1,102 @@
+#include "projection.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/expression_evaluator.hpp"
+#include "resolve_type.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+Projection::Projection(const std::shared_ptr<const AbstractOperator> in,
+                       const std::vector<std::shared_ptr<const AbstractExpression>>& expressions)
+    : AbstractOperator(in), _expressions(expressions) {}
+
+const std::vector<std::shared_ptr<const AbstractExpression>>& Projection::expressions() const { return _expressions; }
+
+std::string Projection::name() const { return "Projection"; }
+
+std::shared_ptr<const Table> Projection::_on_execute() const {
+  Assert(!_expressions.empty(), "Projection needs at least one expression");
+  const auto input_table = _input_table_left();
+
+  auto output_table = std::make_shared<Table>();
+  auto data_types = std::vector<std::string>{};
+  for (const auto& expression : _expressions) {
+    data_types.emplace_back(expression->data_type(*input_table));
+    output_table->add_column_definition(expression->description(*input_table), data_types.back());
+  }
+
+  // with a row limit, only the chunks up to the one in which the limit is reached are evaluated
+  auto chunk_count = input_table->chunk_count();
+  if (_row_limit) {
+    auto row_count = size_t{0};
+    chunk_count = ChunkID{0};
+    while (chunk_count < input_table->chunk_count() && (chunk_count == 0 || row_count < *_row_limit)) {
+      const auto& chunk = input_table->get_chunk(chunk_count);
+      row_count += chunk.size() - chunk.invalid_row_count();
+      ++chunk_count;
+    }
+    _performance_data.skipped_chunk_count = input_table->chunk_count() - chunk_count;
+  }
+
+  auto output_chunks = std::vector<Chunk>(chunk_count);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    const auto& input_chunk = input_table->get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_index)});
+    if (input_chunk.column_count() == 0) return;
+    output_chunks[chunk_index] = _project_chunk(input_table, input_chunk, data_types);
+  });
+
+  for (auto& output_chunk : output_chunks) {
+    if (output_chunk.column_count() > 0) output_table->emplace_chunk(std::move(output_chunk));
+  }
+  return output_table;
+}
+
+Chunk Projection::_project_chunk(const std::shared_ptr<const Table>& input_table, const Chunk& input_chunk,
+                                 const std::vector<std::string>& data_types) const {
+  const auto is_reference_chunk = input_chunk.get_segment(ColumnID{0})->encoding_type() == EncodingType::Reference;
+  const auto forward_columns =
+      !is_reference_chunk || std::all_of(_expressions.cbegin(), _expressions.cend(), [](const auto& expression) {
+        return expression->type() == ExpressionType::Column;
+      });
+
+  auto output_chunk = Chunk{};
+  const auto evaluator = ExpressionEvaluator{input_table, input_chunk};
+  for (auto expression_index = size_t{0}; expression_index < _expressions.size(); ++expression_index) {
+    const auto& expression = *_expressions[expression_index];
+    if (forward_columns && expression.type() == ExpressionType::Column) {
+      output_chunk.add_segment(input_chunk.get_segment(static_cast<const ColumnExpression&>(expression).column_id()));
+      continue;
+    }
+
+    resolve_data_type(data_types[expression_index], [&](auto type) {
+      using Type = typename decltype(type)::type;
+      auto values = evaluator.evaluate<Type>(expression, output_chunk.get_allocator());
+      auto segment = std::make_shared<ValueSegment<Type>>(std::move(values));
+      output_chunk.add_segment(keep_memory_resource_alive(std::move(segment), output_chunk.memory_resource()));
+    });
+  }
+
+  if (is_reference_chunk) return output_chunk;
+  const auto invalidation_bitmap = input_chunk.invalidation_bitmap();
+  if (!invalidation_bitmap) return output_chunk;
+  auto invalid_chunk_offsets = std::vector<ChunkOffset>{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < input_chunk.size(); ++chunk_offset) {
+    if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) invalid_chunk_offsets.push_back(chunk_offset);
+  }
+  output_chunk.invalidate_rows(invalid_chunk_offsets);
+  return output_chunk;
+}
+
+std::optional<size_t> Projection::_input_row_limit() const { return row_limit(); }
+
+}  // namespace opossum
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "expression/expressions.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+// Projection computes one output column per expression, named by the description of the expression. The output has
+// one chunk per input chunk, whose columns are evaluated chunk-at-a-time by the ExpressionEvaluator.
+//
+// Columns that are plain column references forward the segments of the input instead of copying them. Chunks consist
+// either of reference segments or of data segments only, so that references of a reference chunk are only forwarded
+// if all expressions are column references. Otherwise, they are materialized like any other expression.
+// Rows that are deleted in the input are deleted in the output as well.
+//
+// The output rows are the input rows in the same order, so that a row limit (see AbstractOperator::row_limit) is
+// passed on to the input. Chunks beyond the limit are not evaluated.
+class Projection : public AbstractOperator {
+ public:
+  Projection(const std::shared_ptr<const AbstractOperator> in,
+             const std::vector<std::shared_ptr<const AbstractExpression>>& expressions);
+
+  const std::vector<std::shared_ptr<const AbstractExpression>>& expressions() const;
+
+  std::string name() const override;
+
+ protected:
+  friend class Pipeline;
+
+  std::shared_ptr<const Table> _on_execute() const override;
+  std::optional<size_t> _input_row_limit() const override;
+
+  // Returns the output chunk of a chunk that has the columns of the input table, e.g., a chunk of the input table or
+  // a chunk that a Pipeline produced from it. The data types are those of the expressions.
+  Chunk _project_chunk(const std::shared_ptr<const Table>& input_table, const Chunk& input_chunk,
+                       const std::vector<std::string>& data_types) const;
+
+  const std::vector<std::shared_ptr<const AbstractExpression>> _expressions;
+};
+
+}  // namespace opossum
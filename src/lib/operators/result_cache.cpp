@@ -0,0 +1,162 @@
+#include "result_cache.hpp"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "get_table.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+namespace {
+
+// appends the plan that ends in the operator to the key, returns false if it cannot be cached
+bool append_to_key(const AbstractOperator& op, ResultCacheKey& key) {
+  if (!op.is_cacheable()) return false;
+
+  key.plan += op.description();
+  if (op.row_limit()) key.plan += " LIMIT " + std::to_string(*op.row_limit());
+
+  if (const auto get_table = dynamic_cast<const GetTable*>(&op)) {
+    const auto& storage_manager = StorageManager::get();
+    if (!storage_manager.has_table(get_table->table_name())) return false;
+    key.table_versions.emplace_back(get_table->table_name(),
+                                    storage_manager.get_table(get_table->table_name())->version());
+  }
+
+  if (!op.input_left()) return true;
+  key.plan += " (";
+  if (!append_to_key(*op.input_left(), key)) return false;
+  if (op.input_right()) {
+    key.plan += ", ";
+    if (!append_to_key(*op.input_right(), key)) return false;
+  }
+  key.plan += ")";
+  return true;
+}
+
+}  // namespace
+
+ResultCache& ResultCache::get() {
+  static ResultCache instance;
+  return instance;
+}
+
+std::optional<ResultCacheKey> ResultCache::make_key(const AbstractOperator& op) {
+  // the output of a leaf, e.g., a GetTable, is a stored table and thus does not need to be cached
+  if (!op.input_left()) return std::nullopt;
+
+  auto key = ResultCacheKey{};
+  if (!append_to_key(op, key)) return std::nullopt;
+  return key;
+}
+
+std::shared_ptr<const Table> ResultCache::lookup(const ResultCacheKey& key) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  const auto iter = _entries.find(key.plan);
+  if (iter == _entries.end()) return nullptr;
+
+  auto& entry = iter->second;
+  if (entry.table_versions != key.table_versions) {
+    _erase(key.plan);
+    return nullptr;
+  }
+
+  _lru.splice(_lru.begin(), _lru, entry.lru_position);
+  return entry.output;
+}
+
+void ResultCache::insert(const ResultCacheKey& key, const std::shared_ptr<const Table>& output) {
+  const auto memory_usage = output->estimate_memory_usage();
+
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  if (memory_usage > _effective_memory_budget()) return;
+
+  // the same plan may have been executed concurrently
+  if (_entries.count(key.plan)) _erase(key.plan);
+
+  _lru.push_front(key.plan);
+  _entries.emplace(key.plan, Entry{output, key.table_versions, memory_usage, _lru.begin()});
+  _memory_usage += memory_usage;
+  _evict();
+}
+
+void ResultCache::invalidate(const std::string& table_name) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  auto plans = std::vector<std::string>{};
+  for (const auto& [plan, entry] : _entries) {
+    for (const auto& table_version : entry.table_versions) {
+      if (table_version.first == table_name) {
+        plans.emplace_back(plan);
+        break;
+      }
+    }
+  }
+
+  for (const auto& plan : plans) {
+    _erase(plan);
+  }
+}
+
+void ResultCache::clear() {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  _entries.clear();
+  _lru.clear();
+  _memory_usage = 0;
+}
+
+size_t ResultCache::size() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _entries.size();
+}
+
+void ResultCache::set_memory_budget(size_t bytes) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  _memory_budget = bytes;
+  _evict();
+}
+
+size_t ResultCache::memory_budget() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _memory_budget;
+}
+
+void ResultCache::set_storage_headroom(const std::optional<size_t> bytes) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  _storage_headroom = bytes;
+  _evict();
+}
+
+size_t ResultCache::memory_usage() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _memory_usage;
+}
+
+void ResultCache::_erase(const std::string& plan) {
+  const auto iter = _entries.find(plan);
+  _memory_usage -= iter->second.memory_usage;
+  _lru.erase(iter->second.lru_position);
+  _entries.erase(iter);
+}
+
+size_t ResultCache::_effective_memory_budget() const {
+  return _storage_headroom ? std::min(_memory_budget, *_storage_headroom) : _memory_budget;
+}
+
+void ResultCache::_evict() {
+  // an empty output uses no memory, so that a budget of 0 needs the check for an empty cache
+  const auto memory_budget = _effective_memory_budget();
+  while (!_lru.empty() && (_memory_usage > memory_budget || memory_budget == 0)) {
+    _erase(_lru.back());
+  }
+}
+
+}  // namespace opossum
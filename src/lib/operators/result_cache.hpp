@@ -0,0 +1,103 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class Table;
+
+// Identifies a plan, i.e., an operator and its inputs, together with the versions of the stored tables it reads
+struct ResultCacheKey {
+  // the descriptions of the operators of the plan, e.g., "TableScan #0 > 5 (GetTable t)"
+  std::string plan;
+
+  // the names of the tables that the plan reads via GetTable and their versions (see Table::version)
+  std::vector<std::pair<std::string, uint64_t>> table_versions;
+};
+
+// The ResultCache is a singleton that keeps the outputs of executed plans, so that executing an equal plan again,
+// e.g., the same scans on the same table issued by a dashboard every few seconds, returns the cached output instead
+// of recomputing it. Operators look up their plan before executing their inputs (see AbstractOperator::execute).
+//
+// Only plans whose operators are all cacheable (see AbstractOperator::is_cacheable) and whose leaves are GetTables
+// are cached. An entry becomes invalid as soon as one of the tables it reads gets a new version, e.g., by appending,
+// compressing, or deleting rows, and is removed when it is looked up again. Entries of dropped tables are removed
+// right away. The estimated memory usage of all outputs stays within a budget; the least recently used entries are
+// evicted first. If the StorageManager has a memory budget, the outputs also only use the memory that the tables leave
+// free within it, as cached outputs can be recomputed, but tables cannot.
+class ResultCache : private Noncopyable {
+ public:
+  static ResultCache& get();
+
+  // returns the key of the plan that ends in the operator, or nullopt if the plan cannot be cached
+  static std::optional<ResultCacheKey> make_key(const AbstractOperator& op);
+
+  // returns the cached output of the plan, or nullptr if it was not cached or the tables changed since
+  std::shared_ptr<const Table> lookup(const ResultCacheKey& key);
+
+  // Caches the output of the plan, evicting other entries to stay within the budget. Outputs that are larger than the
+  // budget are not cached.
+  void insert(const ResultCacheKey& key, const std::shared_ptr<const Table>& output);
+
+  // removes all entries that read the table, e.g., when it is dropped
+  void invalidate(const std::string& table_name);
+
+  void clear();
+
+  // returns the number of cached plans
+  size_t size() const;
+
+  // Sets the number of bytes that the cached outputs must not exceed and evicts entries until they fit. A budget of 0
+  // disables the cache.
+  void set_memory_budget(size_t bytes);
+  size_t memory_budget() const;
+
+  // Sets the memory that the tables leave free within the budget of the StorageManager, or nullopt if it has none,
+  // and evicts entries until the outputs fit into it as well. Called whenever the StorageManager enforces its budget.
+  void set_storage_headroom(const std::optional<size_t> bytes);
+
+  // returns the estimated memory usage of all cached outputs
+  size_t memory_usage() const;
+
+  ResultCache(ResultCache&&) = delete;
+
+ protected:
+  ResultCache() {}
+
+  struct Entry {
+    std::shared_ptr<const Table> output;
+    std::vector<std::pair<std::string, uint64_t>> table_versions;
+    size_t memory_usage;
+    // the position of the plan in _lru
+    std::list<std::string>::iterator lru_position;
+  };
+
+  // removes the entry of the plan, the mutex must be held
+  void _erase(const std::string& plan);
+
+  // returns the budget or the storage headroom, whichever is lower, the mutex must be held
+  size_t _effective_memory_budget() const;
+
+  // evicts the least recently used entries until the outputs fit into the budget, the mutex must be held
+  void _evict();
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _entries;
+  // the plans of all entries, the most recently used first
+  std::list<std::string> _lru;
+  size_t _memory_budget = 64 * 1024 * 1024;
+  std::optional<size_t> _storage_headroom;
+  size_t _memory_usage = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,301 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "table_scan.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+#include "utils/parallel_sort.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto MAX_KEY_WORDS = size_t{4};
+
+// Strings are represented by a prefix in the normalized key. Strings with equal prefixes are compared in full.
+constexpr auto STRING_PREFIX_LENGTH = size_t{16};
+
+template <size_t word_count>
+struct SortEntry {
+  // the normalized key, whose words are compared in order
+  std::array<uint64_t, word_count> key;
+  RowID row_id;
+};
+
+// a sort column that is represented by the bytes [offset, offset + width) of the normalized key
+struct NormalizedKeyColumn {
+  ColumnID column_id;
+  size_t offset;
+  size_t width;
+  bool descending;
+};
+
+template <typename T>
+constexpr size_t full_key_width() {
+  return std::is_same_v<T, std::string> ? STRING_PREFIX_LENGTH : sizeof(T);
+}
+
+// Writes the first width bytes of a binary-comparable representation of the value, i.e., comparing the bytes of two
+// keys in order yields the order of the values. Numbers are written big-endian with their sign bit flipped. Negative
+// floating-point numbers also have their other bits flipped, as they are stored as sign and magnitude.
+template <typename T>
+void write_normalized_key(const T& value, uint8_t* key, const size_t width, const bool descending) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto length = std::min(value.size(), width);
+    std::memcpy(key, value.data(), length);
+    std::memset(key + length, 0, width - length);
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr auto sign_bit = Bits{1} << (sizeof(T) * 8 - 1);
+    auto bits = Bits{};
+    std::memcpy(&bits, &value, sizeof(T));
+    if constexpr (std::is_floating_point_v<T>) {
+      bits = (bits & sign_bit) ? ~bits : bits | sign_bit;
+    } else {
+      bits ^= sign_bit;
+    }
+    for (auto byte = size_t{0}; byte < width; ++byte) {
+      key[byte] = static_cast<uint8_t>(bits >> ((sizeof(T) - 1 - byte) * 8));
+    }
+  }
+
+  if (descending) {
+    for (auto byte = size_t{0}; byte < width; ++byte) key[byte] = static_cast<uint8_t>(~key[byte]);
+  }
+}
+
+// Compares the values of a sort column for rows whose normalized keys are equal
+class BaseTieBreaker : private Noncopyable {
+ public:
+  virtual ~BaseTieBreaker() = default;
+
+  // returns a negative number if the lhs row is ordered first, a positive one if the rhs row is, and 0 otherwise
+  virtual int compare(const RowID& lhs, const RowID& rhs) const = 0;
+};
+
+template <typename T>
+class TieBreaker : public BaseTieBreaker {
+ public:
+  TieBreaker(const Table& table, const ColumnID column_id, const bool descending)
+      : _values(table.chunk_count()), _descending(descending) {
+    parallel_for(_values.size(), [&](const size_t chunk_index) {
+      const auto& chunk = table.get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_index)});
+      if (chunk.size() == 0) return;
+      _values[chunk_index].reserve(chunk.size());
+      segment_iterate<T>(*chunk.get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { _values[chunk_index].push_back(value); });
+    });
+  }
+
+  int compare(const RowID& lhs, const RowID& rhs) const override {
+    const auto& lhs_value = _values[lhs.chunk_id][lhs.chunk_offset];
+    const auto& rhs_value = _values[rhs.chunk_id][rhs.chunk_offset];
+    const auto result = lhs_value < rhs_value ? -1 : (rhs_value < lhs_value ? 1 : 0);
+    return _descending ? -result : result;
+  }
+
+ protected:
+  std::vector<std::vector<T>> _values;
+  const bool _descending;
+};
+
+// Sorts entries by a single-word key with a stable LSD radix sort. Bytes that are equal in all keys, e.g., the unused
+// low bytes of a 4-byte key, are skipped.
+void radix_sort(std::vector<SortEntry<1>>& entries) {
+  if (entries.empty()) return;
+
+  auto buffer = std::vector<SortEntry<1>>(entries.size());
+  for (auto shift = size_t{0}; shift < 64; shift += 8) {
+    auto offsets = std::array<size_t, 256>{};
+    for (const auto& entry : entries) ++offsets[(entry.key[0] >> shift) & 0xFF];
+    if (offsets[(entries.front().key[0] >> shift) & 0xFF] == entries.size()) continue;
+
+    auto offset = size_t{0};
+    for (auto& bucket_offset : offsets) {
+      offset += bucket_offset;
+      bucket_offset = offset - bucket_offset;
+    }
+    for (const auto& entry : entries) buffer[offsets[(entry.key[0] >> shift) & 0xFF]++] = entry;
+    std::swap(entries, buffer);
+  }
+}
+
+// returns the RowIDs of the valid rows of the table in sorted order
+template <size_t word_count>
+std::vector<RowID> sort_row_ids(const Table& table, const std::vector<NormalizedKeyColumn>& key_columns,
+                                const std::vector<std::unique_ptr<BaseTieBreaker>>& tie_breakers) {
+  // materializes the normalized keys of each chunk, deleted rows are left out
+  auto runs = std::vector<std::vector<SortEntry<word_count>>>(table.chunk_count());
+  parallel_for(runs.size(), [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto& chunk = table.get_chunk(chunk_id);
+    const auto row_count = chunk.size();
+    if (row_count == 0) return;
+
+    constexpr auto key_size = word_count * sizeof(uint64_t);
+    auto keys = std::vector<uint8_t>(row_count * key_size);
+    for (const auto& key_column : key_columns) {
+      resolve_data_type(table.column_type(key_column.column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        segment_iterate<Type>(*chunk.get_segment(key_column.column_id),
+                              [&](const ChunkOffset chunk_offset, const Type& value) {
+                                write_normalized_key(value, &keys[chunk_offset * key_size + key_column.offset],
+                                                     key_column.width, key_column.descending);
+                              });
+      });
+    }
+
+    const auto invalidation_bitmap = TableScan::invalidation_bitmap(chunk);
+    auto& run = runs[chunk_index];
+    run.reserve(row_count);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) continue;
+
+      // the key bytes are big-endian, so that the words compare like the bytes
+      auto entry = SortEntry<word_count>{{}, RowID{chunk_id, chunk_offset}};
+      for (auto word = size_t{0}; word < word_count; ++word) {
+        std::memcpy(&entry.key[word], &keys[chunk_offset * key_size + word * sizeof(uint64_t)], sizeof(uint64_t));
+        entry.key[word] = __builtin_bswap64(entry.key[word]);
+      }
+      run.push_back(entry);
+    }
+  });
+
+  const auto compare = [&](const SortEntry<word_count>& lhs, const SortEntry<word_count>& rhs) {
+    if (lhs.key != rhs.key) return lhs.key < rhs.key;
+    for (const auto& tie_breaker : tie_breakers) {
+      const auto result = tie_breaker->compare(lhs.row_id, rhs.row_id);
+      if (result != 0) return result < 0;
+    }
+    return false;
+  };
+
+  parallel_for(runs.size(), [&](const size_t run_index) {
+    if constexpr (word_count == 1) {
+      if (tie_breakers.empty()) {
+        radix_sort(runs[run_index]);
+        return;
+      }
+    }
+    std::stable_sort(runs[run_index].begin(), runs[run_index].end(), compare);
+  });
+  const auto sorted_entries = parallel_multiway_merge(runs, compare);
+
+  auto row_ids = std::vector<RowID>(sorted_entries.size());
+  for (auto index = size_t{0}; index < sorted_entries.size(); ++index) {
+    row_ids[index] = sorted_entries[index].row_id;
+  }
+  return row_ids;
+}
+
+}  // namespace
+
+std::string sort_definitions_description(const std::vector<SortColumnDefinition>& sort_definitions) {
+  auto description = std::string{};
+  for (const auto& sort_definition : sort_definitions) {
+    if (!description.empty()) description += ", ";
+    description += "#" + std::to_string(sort_definition.column_id);
+    description += sort_definition.order_by_mode == OrderByMode::Ascending ? " ASC" : " DESC";
+  }
+  return description;
+}
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const ChunkOffset output_chunk_size)
+    : AbstractOperator(in), _sort_definitions(sort_definitions), _output_chunk_size(output_chunk_size) {}
+
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
+
+std::string Sort::name() const { return "Sort"; }
+
+std::string Sort::description() const {
+  auto description = name() + " " + sort_definitions_description(_sort_definitions);
+  if (_output_chunk_size != std::numeric_limits<ChunkOffset>::max() - 1) {
+    description += " CHUNK SIZE " + std::to_string(_output_chunk_size);
+  }
+  return description;
+}
+
+bool Sort::is_cacheable() const { return true; }
+
+std::shared_ptr<const Table> Sort::_on_execute() const {
+  Assert(!_sort_definitions.empty(), "Sort needs at least one column to sort by");
+  Assert(_output_chunk_size > 0, "Output chunks must not be empty");
+  const auto input_table = _input_table_left();
+
+  // The normalized key holds the sort columns up to the first one that is not encoded completely, e.g., a string. That
+  // column and all following columns are compared by tie breakers.
+  auto key_columns = std::vector<NormalizedKeyColumn>{};
+  auto tie_breakers = std::vector<std::unique_ptr<BaseTieBreaker>>{};
+  auto key_size = size_t{0};
+  for (const auto& sort_definition : _sort_definitions) {
+    const auto column_id = sort_definition.column_id;
+    const auto descending = sort_definition.order_by_mode == OrderByMode::Descending;
+    resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      if (!tie_breakers.empty()) {
+        tie_breakers.emplace_back(std::make_unique<TieBreaker<Type>>(*input_table, column_id, descending));
+        return;
+      }
+
+      const auto width = std::min(full_key_width<Type>(), MAX_KEY_WORDS * sizeof(uint64_t) - key_size);
+      if (width > 0) key_columns.push_back({column_id, key_size, width, descending});
+      key_size += width;
+      if (std::is_same_v<Type, std::string> || width < full_key_width<Type>()) {
+        tie_breakers.emplace_back(std::make_unique<TieBreaker<Type>>(*input_table, column_id, descending));
+      }
+    });
+  }
+
+  auto row_ids = std::vector<RowID>{};
+  switch ((key_size + sizeof(uint64_t) - 1) / sizeof(uint64_t)) {
+    case 1:
+      row_ids = sort_row_ids<1>(*input_table, key_columns, tie_breakers);
+      break;
+    case 2:
+      row_ids = sort_row_ids<2>(*input_table, key_columns, tie_breakers);
+      break;
+    case 3:
+      row_ids = sort_row_ids<3>(*input_table, key_columns, tie_breakers);
+      break;
+    default:
+      row_ids = sort_row_ids<MAX_KEY_WORDS>(*input_table, key_columns, tie_breakers);
+  }
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  // Empty results still consist of one chunk, so that the output has segments for all of its columns.
+  const auto output_chunk_count = std::max((row_ids.size() + _output_chunk_size - 1) / _output_chunk_size, size_t{1});
+  auto output_chunks = std::vector<Chunk>(output_chunk_count);
+  parallel_for(output_chunk_count, [&](const size_t output_chunk_index) {
+    const auto begin = row_ids.cbegin() + std::min(output_chunk_index * _output_chunk_size, row_ids.size());
+    const auto end = row_ids.cbegin() + std::min((output_chunk_index + 1) * _output_chunk_size, row_ids.size());
+    auto pos_list = make_pos_list(_arena);
+    pos_list->assign(begin, end);
+    append_reference_segments(output_chunks[output_chunk_index], input_table, std::move(pos_list), _arena);
+  });
+  for (auto& output_chunk : output_chunks) {
+    output_table->emplace_chunk(std::move(output_chunk));
+  }
+
+  return output_table;
+}
+
+}  // namespace opossum
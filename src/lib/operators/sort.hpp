@@ -0,0 +1,49 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+struct SortColumnDefinition {
+  ColumnID column_id;
+  OrderByMode order_by_mode = OrderByMode::Ascending;
+};
+
+// describes the sort columns of Sort and TopK, e.g., "#0 ASC, #1 DESC"
+std::string sort_definitions_description(const std::vector<SortColumnDefinition>& sort_definitions);
+
+// Sort orders the rows of its input by one or more columns. Rows that are equal in all sort columns keep their order.
+// The output references the sorted rows in chunks of at most output_chunk_size rows.
+//
+// Each row is represented by a normalized key: the values of the sort columns are encoded so that comparing the keys
+// as unsigned integers orders the rows, including descending columns. Strings are represented by a prefix. Columns
+// that do not fit into the key, e.g., the remainder of a string, are only compared if the keys of two rows are equal.
+// The keys of each chunk are sorted in parallel, with a radix sort if they consist of a single machine word, and then
+// merged in parallel (see parallel_multiway_merge).
+class Sort : public AbstractOperator {
+ public:
+  Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const ChunkOffset output_chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const ChunkOffset _output_chunk_size;
+};
+
+}  // namespace opossum
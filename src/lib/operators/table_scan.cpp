@@ -0,0 +1,465 @@
+#include "table_scan.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expression/expressions.hpp"
+#include "join_hash.hpp"
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/arena.hpp"
+#include "utils/bloom_filter.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// one bit per row of a chunk, bit (i % 64) of word (i / 64) belongs to row i
+using Bitmap = std::vector<uint64_t>;
+
+// calls the functor with the comparison function object that implements the scan type
+template <typename Functor>
+void resolve_scan_type(const ScanType scan_type, const Functor& functor) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      functor(std::equal_to<>{});
+      break;
+    case ScanType::OpNotEquals:
+      functor(std::not_equal_to<>{});
+      break;
+    case ScanType::OpLessThan:
+      functor(std::less<>{});
+      break;
+    case ScanType::OpLessThanEquals:
+      functor(std::less_equal<>{});
+      break;
+    case ScanType::OpGreaterThan:
+      functor(std::greater<>{});
+      break;
+    case ScanType::OpGreaterThanEquals:
+      functor(std::greater_equal<>{});
+      break;
+  }
+}
+
+// returns a bitmap in which bit i is set if the predicate holds for values[i]
+template <typename Values, typename Predicate>
+Bitmap scan_into_bitmap(const Values& values, const Predicate& predicate) {
+  const auto size = values.size();
+  auto bitmap = Bitmap((size + 63) / 64);
+  for (auto word_index = size_t{0}; word_index < bitmap.size(); ++word_index) {
+    const auto begin = word_index * 64;
+    const auto end = std::min(begin + 64, size);
+
+    // each word is built from 64 comparisons without branches
+    auto word = uint64_t{0};
+    for (auto index = begin; index < end; ++index) {
+      word |= uint64_t{predicate(values[index])} << (index - begin);
+    }
+    bitmap[word_index] = word;
+  }
+  return bitmap;
+}
+
+// Returns the matches in a segment of type T. Dictionary segments are scanned on their value ids: the search value is
+// translated into a value id bound once, so that the comparisons operate on small integers.
+template <typename T>
+Bitmap scan_segment(const BaseSegment& segment, const ScanType scan_type, const T& search_value) {
+  auto matches = Bitmap{};
+
+  switch (segment.encoding_type()) {
+    case EncodingType::Unencoded: {
+      const auto& values = static_cast<const ValueSegment<T>&>(segment).values();
+      resolve_scan_type(scan_type, [&](auto compare) {
+        matches = scan_into_bitmap(values, [&](const T& value) { return compare(value, search_value); });
+      });
+      break;
+    }
+    case EncodingType::Dictionary: {
+      const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(segment);
+
+      // INVALID_VALUE_ID is larger than all value ids, so that it also works as a bound for the comparisons below
+      auto value_id_scan_type = scan_type;
+      auto bound = ValueID{0};
+      switch (scan_type) {
+        case ScanType::OpEquals:
+        case ScanType::OpNotEquals: {
+          bound = dictionary_segment.lower_bound(search_value);
+          if (bound != INVALID_VALUE_ID && dictionary_segment.value_by_value_id(bound) != search_value) {
+            bound = INVALID_VALUE_ID;
+          }
+          break;
+        }
+        case ScanType::OpLessThan:
+          bound = dictionary_segment.lower_bound(search_value);
+          break;
+        case ScanType::OpLessThanEquals:
+          value_id_scan_type = ScanType::OpLessThan;
+          bound = dictionary_segment.upper_bound(search_value);
+          break;
+        case ScanType::OpGreaterThan:
+          value_id_scan_type = ScanType::OpGreaterThanEquals;
+          bound = dictionary_segment.upper_bound(search_value);
+          break;
+        case ScanType::OpGreaterThanEquals:
+          bound = dictionary_segment.lower_bound(search_value);
+          break;
+      }
+
+      const auto raw_bound = static_cast<ValueID::base_type>(bound);
+      resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+        resolve_scan_type(value_id_scan_type, [&](auto compare) {
+          matches = scan_into_bitmap(value_ids, [&](const auto value_id) {
+            return compare(static_cast<ValueID::base_type>(value_id), raw_bound);
+          });
+        });
+      });
+      break;
+    }
+    default: {
+      matches.resize((segment.size() + 63) / 64);
+      resolve_scan_type(scan_type, [&](auto compare) {
+        segment_iterate<T>(segment, [&](const ChunkOffset chunk_offset, const T& value) {
+          matches[chunk_offset / 64] |= uint64_t{compare(value, search_value)} << (chunk_offset % 64);
+        });
+      });
+    }
+  }
+
+  return matches;
+}
+
+// removes the deleted rows of a chunk from its matches
+void remove_invalid_rows(Bitmap& matches, const Chunk& chunk) {
+  const auto invalidation_bitmap = chunk.invalidation_bitmap();
+  if (!invalidation_bitmap) return;
+
+  const auto word_count = std::min(matches.size(), invalidation_bitmap->size());
+  const auto* const invalid_words = invalidation_bitmap->data();
+  auto* const match_words = matches.data();
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    match_words[word_index] &= ~invalid_words[word_index];
+  }
+}
+
+// Removes the matches that reference deleted rows, which might have been deleted after the input was computed. NULL
+// rows never match the predicate on the scanned column, but are valid in the other columns, e.g., after a left join.
+void remove_invalid_rows(Bitmap& matches, const ReferenceSegment& segment, const bool remove_null_rows) {
+  const auto& pos_list = *segment.pos_list();
+  const auto& referenced_table = *segment.referenced_table();
+
+  // the invalidation bitmap is only fetched again when the referenced chunk changes
+  auto referenced_chunk_id = NULL_ROW_ID.chunk_id;
+  auto invalidation_bitmap = std::shared_ptr<const std::vector<uint64_t>>{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < pos_list.size(); ++chunk_offset) {
+    const auto& row_id = pos_list[chunk_offset];
+    if (row_id == NULL_ROW_ID) {
+      matches[chunk_offset / 64] &= ~(uint64_t{remove_null_rows} << (chunk_offset % 64));
+      continue;
+    }
+    if (row_id.chunk_id != referenced_chunk_id) {
+      referenced_chunk_id = row_id.chunk_id;
+      invalidation_bitmap = referenced_table.get_chunk(referenced_chunk_id).invalidation_bitmap();
+    }
+    const auto is_valid = is_valid_in_bitmap(invalidation_bitmap.get(), row_id.chunk_offset);
+    matches[chunk_offset / 64] &= ~(uint64_t{!is_valid} << (chunk_offset % 64));
+  }
+}
+
+// removes the matches whose value in a segment of type T is not contained in the Bloom filter
+template <typename T>
+void remove_filtered_rows(Bitmap& matches, const BaseSegment& segment, const BloomFilter& bloom_filter) {
+  auto contained = Bitmap{};
+
+  switch (segment.encoding_type()) {
+    case EncodingType::Unencoded: {
+      const auto& values = static_cast<const ValueSegment<T>&>(segment).values();
+      contained =
+          scan_into_bitmap(values, [&](const T& value) { return bloom_filter.contains(bloom_filter_hash(value)); });
+      break;
+    }
+    case EncodingType::Dictionary: {
+      // each distinct value is only looked up once
+      const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(segment);
+      const auto& dictionary = *dictionary_segment.dictionary();
+      auto contained_value_ids = std::vector<uint8_t>(dictionary.size());
+      for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+        contained_value_ids[value_id] = bloom_filter.contains(bloom_filter_hash(dictionary[value_id]));
+      }
+      resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+        contained = scan_into_bitmap(value_ids, [&](const auto value_id) {
+          return contained_value_ids[static_cast<ValueID::base_type>(value_id)];
+        });
+      });
+      break;
+    }
+    default: {
+      contained.resize((segment.size() + 63) / 64);
+      segment_iterate<T>(segment, [&](const ChunkOffset chunk_offset, const T& value) {
+        const auto is_contained = bloom_filter.contains(bloom_filter_hash(value));
+        contained[chunk_offset / 64] |= uint64_t{is_contained} << (chunk_offset % 64);
+      });
+    }
+  }
+
+  for (auto word_index = size_t{0}; word_index < matches.size(); ++word_index) {
+    matches[word_index] &= contained[word_index];
+  }
+}
+
+// calls the functor with the offset of every set bit
+template <typename Functor>
+void for_each_match(const Bitmap& matches, const Functor& functor) {
+  for (auto word_index = size_t{0}; word_index < matches.size(); ++word_index) {
+    auto word = matches[word_index];
+    while (word != 0) {
+      functor(static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(word)));
+      word &= word - 1;
+    }
+  }
+}
+
+size_t count_matches(const Bitmap& matches) {
+  auto count = size_t{0};
+  for (const auto word : matches) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+}  // namespace
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id, const ScanType scan_type,
+                     const AllTypeVariant search_value)
+    : AbstractOperator(in), _column_id(column_id), _scan_type(scan_type), _search_value(search_value) {}
+
+TableScan::~TableScan() = default;
+
+ColumnID TableScan::column_id() const { return _column_id; }
+
+ScanType TableScan::scan_type() const { return _scan_type; }
+
+const AllTypeVariant& TableScan::search_value() const { return _search_value; }
+
+void TableScan::add_bloom_filter(const ColumnID column_id, const BloomFilterBuilder& bloom_filter_builder) const {
+  _bloom_filter_builders.emplace_back(column_id, bloom_filter_builder);
+}
+
+std::vector<std::shared_ptr<const AbstractOperator>> TableScan::execute_after_operators() const {
+  auto operators = AbstractOperator::execute_after_operators();
+  // the Bloom filter of a join is built from its right input
+  if (const auto join = _reducing_join()) operators.emplace_back(join->input_right());
+  return operators;
+}
+
+std::string TableScan::name() const { return "TableScan"; }
+
+std::string TableScan::description() const {
+  const auto value = type_cast<std::string>(_search_value);
+  const auto is_string = _search_value.type() == typeid(std::string);
+  return name() + " #" + std::to_string(_column_id) + " " + scan_type_symbol(_scan_type) + " " +
+         (is_string ? "'" + value + "'" : value);
+}
+
+// Bloom filters remove rows depending on the output of another operator, which is not part of the description
+bool TableScan::is_cacheable() const { return _bloom_filter_builders.empty() && !_reducing_join(); }
+
+std::shared_ptr<const Table> TableScan::_on_execute() const {
+  const auto input_table = _input_table_left();
+  const auto column_count = input_table->column_count();
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  const auto bloom_filters = _build_bloom_filters();
+  const auto scan_chunk = [&](const Chunk& chunk) {
+    auto matches = _match_chunk(*input_table, chunk, bloom_filters);
+    _remove_invalid_rows(matches, chunk, {_column_id});
+    return matches;
+  };
+  _performance_data.skipped_chunk_count = _scan_chunks(*output_table, input_table, _row_limit, _arena, scan_chunk);
+  return output_table;
+}
+
+size_t TableScan::_scan_chunks(Table& output_table, const std::shared_ptr<const Table>& input_table,
+                               const std::optional<size_t> row_limit, const std::shared_ptr<MemoryResource>& arena,
+                               const std::function<Bitmap(const Chunk&)>& scan_chunk) {
+  const auto column_count = input_table->column_count();
+
+  // Empty results still consist of one chunk, so that the output has segments for all of its columns. Thus, the last
+  // chunk is emitted even without matches if no chunk was emitted before.
+  const auto chunk_count = input_table->chunk_count();
+  auto emitted_chunk = false;
+  if (row_limit) {
+    auto output_row_count = size_t{0};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      // the remaining chunks are not scanned if the consumer of the output does not need more rows
+      if (emitted_chunk && output_row_count >= *row_limit) return chunk_count - chunk_id;
+
+      const auto& chunk = input_table->get_chunk(chunk_id);
+      if (chunk.column_count() != column_count) continue;
+
+      const auto matches = scan_chunk(chunk);
+      const auto match_count = count_matches(matches);
+      const auto is_last_chunk = chunk_id + 1 == chunk_count;
+      if (match_count > 0 || (is_last_chunk && !emitted_chunk)) {
+        output_table.emplace_chunk(_make_output_chunk(input_table, chunk_id, matches, arena));
+        emitted_chunk = true;
+        output_row_count += match_count;
+      }
+    }
+    return 0;
+  }
+
+  auto output_chunks = std::vector<Chunk>(chunk_count);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto& chunk = input_table->get_chunk(chunk_id);
+    if (chunk.column_count() != column_count) return;
+
+    const auto matches = scan_chunk(chunk);
+    const auto is_last_chunk = chunk_id + 1 == chunk_count;
+    if (count_matches(matches) > 0 || is_last_chunk) {
+      output_chunks[chunk_index] = _make_output_chunk(input_table, chunk_id, matches, arena);
+    }
+  });
+
+  for (auto& output_chunk : output_chunks) {
+    if (output_chunk.column_count() == 0) continue;
+    if (output_chunk.size() == 0 && emitted_chunk) continue;
+    output_table.emplace_chunk(std::move(output_chunk));
+    emitted_chunk = true;
+  }
+  return 0;
+}
+
+TableScan::BloomFilters TableScan::_build_bloom_filters() const {
+  auto bloom_filters = BloomFilters{};
+  for (const auto& [column_id, bloom_filter_builder] : _bloom_filter_builders) {
+    if (auto bloom_filter = bloom_filter_builder()) bloom_filters.emplace_back(column_id, std::move(bloom_filter));
+  }
+  if (const auto join = _reducing_join()) {
+    if (auto bloom_filter = join->build_bloom_filter()) {
+      bloom_filters.emplace_back(join->column_ids().first, std::move(bloom_filter));
+    }
+  }
+  return bloom_filters;
+}
+
+const JoinHash* TableScan::_reducing_join() const {
+  // the filtered output is only private to the join if no other operator consumes the scan
+  const auto join = dynamic_cast<const JoinHash*>(_only_consumer());
+  if (!join || join->input_left().get() != this || !join->_reduces_left_input()) return nullptr;
+  return join;
+}
+
+TableScan::Bitmap TableScan::_match_chunk(const Table& input_table, const Chunk& chunk,
+                                          const BloomFilters& bloom_filters) const {
+  auto matches = Bitmap{};
+  resolve_data_type(input_table.column_type(_column_id), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    matches = scan_segment<Type>(*chunk.get_segment(_column_id), _scan_type, type_cast<Type>(_search_value));
+  });
+  if (bloom_filters.empty() || _count_matches(matches) == 0) return matches;
+
+  for (const auto& [column_id, bloom_filter] : bloom_filters) {
+    resolve_data_type(input_table.column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      remove_filtered_rows<Type>(matches, *chunk.get_segment(column_id), *bloom_filter);
+    });
+  }
+  return matches;
+}
+
+std::shared_ptr<const std::vector<uint64_t>> TableScan::invalidation_bitmap(const Chunk& chunk) {
+  if (chunk.column_count() == 0 || chunk.get_segment(ColumnID{0})->encoding_type() != EncodingType::Reference) {
+    return chunk.invalidation_bitmap();
+  }
+
+  auto valid_rows = Bitmap((chunk.size() + 63) / 64, ~uint64_t{0});
+  _remove_invalid_rows(valid_rows, chunk, {});
+  auto has_invalid_rows = false;
+  for (auto& word : valid_rows) {
+    word = ~word;
+    has_invalid_rows |= word != 0;
+  }
+  if (!has_invalid_rows) return nullptr;
+  return std::make_shared<const std::vector<uint64_t>>(std::move(valid_rows));
+}
+
+void TableScan::_remove_invalid_rows(Bitmap& matches, const Chunk& chunk, const std::vector<ColumnID>& column_ids) {
+  // the segments of a chunk are either all reference segments or none
+  if (chunk.get_segment(ColumnID{0})->encoding_type() != EncodingType::Reference) {
+    remove_invalid_rows(matches, chunk);
+    return;
+  }
+
+  // The columns may reference several tables, e.g., those of both inputs of a join, whose rows might have been deleted
+  // as well. Each PosList is only checked once per referenced table.
+  auto checked_pos_lists = std::set<std::pair<const PosList*, const Table*>>{};
+  const auto check_segment = [&](const ColumnID column_id, const bool remove_null_rows) {
+    const auto& segment = static_cast<const ReferenceSegment&>(*chunk.get_segment(column_id));
+    const auto pos_list_key = std::make_pair(segment.pos_list().get(), segment.referenced_table().get());
+    if (checked_pos_lists.emplace(pos_list_key).second) remove_invalid_rows(matches, segment, remove_null_rows);
+  };
+  // the scanned columns come first, so that their NULL rows are removed even if other columns share their PosLists
+  for (const auto& column_id : column_ids) check_segment(column_id, true);
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) check_segment(column_id, false);
+}
+
+size_t TableScan::_count_matches(const Bitmap& matches) { return count_matches(matches); }
+
+Chunk TableScan::_make_output_chunk(const std::shared_ptr<const Table>& input_table, const ChunkID chunk_id,
+                                    const Bitmap& matches, const std::shared_ptr<MemoryResource>& arena) {
+  const auto& input_chunk = input_table->get_chunk(chunk_id);
+  const auto column_count = input_table->column_count();
+  const auto match_count = count_matches(matches);
+  auto output_chunk = Chunk{};
+
+  if (input_chunk.get_segment(ColumnID{0})->encoding_type() != EncodingType::Reference) {
+    auto pos_list = make_pos_list(arena);
+    pos_list->reserve(match_count);
+    for_each_match(matches,
+                   [&](const ChunkOffset chunk_offset) { pos_list->emplace_back(RowID{chunk_id, chunk_offset}); });
+
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      output_chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id, pos_list));
+    }
+  } else {
+    // The input references other tables. We filter its PosLists, which are usually shared by all of its columns.
+    auto filtered_pos_lists = std::unordered_map<std::shared_ptr<const PosList>, std::shared_ptr<const PosList>>{};
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      const auto& input_segment = static_cast<const ReferenceSegment&>(*input_chunk.get_segment(column_id));
+      auto& filtered_pos_list = filtered_pos_lists[input_segment.pos_list()];
+      if (!filtered_pos_list) {
+        const auto& input_pos_list = *input_segment.pos_list();
+        auto pos_list = make_pos_list(arena);
+        pos_list->reserve(match_count);
+        for_each_match(matches,
+                       [&](const ChunkOffset chunk_offset) { pos_list->emplace_back(input_pos_list[chunk_offset]); });
+        filtered_pos_list = std::move(pos_list);
+      }
+
+      output_chunk.add_segment(std::make_shared<ReferenceSegment>(
+          input_segment.referenced_table(), input_segment.referenced_column_id(), filtered_pos_list));
+    }
+  }
+
+  return output_chunk;
+}
+
+}  // namespace opossum
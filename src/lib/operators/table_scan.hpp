@@ -1,8 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_operator.hpp"
@@ -13,8 +15,27 @@
 namespace opossum {
 
 class BaseTableScanImpl;
+class BloomFilter;
+class JoinHash;
+class Chunk;
 class Table;
 
+// Selects the rows of its input whose value in the given column satisfies the predicate. The output references the
+// selected rows, i.e., it consists of ReferenceSegments. Deleted rows are skipped.
+//
+// Each chunk is scanned into a bitmap of matches, with one bit per row. Deleted rows are removed from it by ANDing it
+// word-wise with the chunk's invalidation bitmap, before the positions of the remaining bits are collected. The loops
+// over the bitmaps are free of branches, so that the compiler can vectorize them.
+//
+// Chunks are the morsels of the scan: they are scanned in parallel by jobs of the TaskScheduler (see parallel_for), and
+// the output chunks are assembled in the order of the input chunks. With a row limit (see
+// AbstractOperator::row_limit), chunks are scanned one after another instead, stopping after the chunk in which
+// the limit is reached.
+//
+// A JoinHash that is the only consumer of the scan passes a Bloom filter over the join keys of its build input to the
+// scan, which is executed after the build input for this (see JoinHash). Further filters can be added with
+// add_bloom_filter. Rows whose join key is not contained in a filter are removed from the matches chunk by chunk, so
+// that most rows without a join partner never reach the join.
 class TableScan : public AbstractOperator {
  public:
   TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id, const ScanType scan_type,
@@ -26,8 +47,72 @@ class TableScan : public AbstractOperator {
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
 
+  // Returns a Bloom filter over the hashes (see bloom_filter_hash()) of the values that the consumer of the output
+  // needs in a column, or nullptr if it is not known yet.
+  using BloomFilterBuilder = std::function<std::shared_ptr<const BloomFilter>()>;
+
+  // Only selects rows whose value in the column may be contained in the Bloom filter. The filter is built when the
+  // scan executes, e.g., after the build input of a join has executed. If the builder returns nullptr, the rows are
+  // not filtered. As for set_row_limit, the filter must be added before the scan is executed and only if nobody needs
+  // the full output.
+  void add_bloom_filter(const ColumnID column_id, const BloomFilterBuilder& bloom_filter_builder) const;
+
+  std::vector<std::shared_ptr<const AbstractOperator>> execute_after_operators() const override;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+  // Returns the deleted rows of a chunk like Chunk::invalidation_bitmap(). The rows of chunks with reference segments
+  // are deleted if a row that they reference is, as rows might be deleted after the references were created. NULL rows
+  // are not deleted.
+  static std::shared_ptr<const std::vector<uint64_t>> invalidation_bitmap(const Chunk& chunk);
+
  protected:
-  std::shared_ptr<const Table> _on_execute() override;
+  friend class Pipeline;
+  template <typename... Predicates>
+  friend class FusedTableScan;
+
+  // one bit per row of a chunk, bit (i % 64) of word (i / 64) belongs to row i
+  using Bitmap = std::vector<uint64_t>;
+  using BloomFilters = std::vector<std::pair<ColumnID, std::shared_ptr<const BloomFilter>>>;
+
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  // The following steps of a scan are also used by Pipelines and FusedTableScans, which apply several predicates to a
+  // chunk of their input.
+
+  // Adds the output chunks to the output table, using scan_chunk to get the matching rows of each input chunk,
+  // without deleted rows. Chunks are scanned in parallel and added in order. With a row limit, chunks are scanned one
+  // after another until the limit is reached. Returns the number of chunks that were not scanned because of the limit.
+  static size_t _scan_chunks(Table& output_table, const std::shared_ptr<const Table>& input_table,
+                           const std::optional<size_t> row_limit, const std::shared_ptr<MemoryResource>& arena,
+                           const std::function<Bitmap(const Chunk&)>& scan_chunk);
+
+  // returns the Bloom filters that are known by now
+  BloomFilters _build_bloom_filters() const;
+
+  // returns the JoinHash that passes a Bloom filter to the scan, or nullptr if there is none
+  const JoinHash* _reducing_join() const;
+
+  // returns the rows of a chunk of the input table that satisfy the predicate and are contained in the Bloom filters
+  Bitmap _match_chunk(const Table& input_table, const Chunk& chunk, const BloomFilters& bloom_filters) const;
+
+  // Removes the deleted rows from the matches, which are checked through all tables that the columns of a chunk with
+  // reference segments refer to. The NULL rows of the scanned columns are removed as well.
+  static void _remove_invalid_rows(Bitmap& matches, const Chunk& chunk, const std::vector<ColumnID>& column_ids);
+
+  static size_t _count_matches(const Bitmap& matches);
+
+  // returns a chunk that references the matching rows of a chunk of the input table
+  static Chunk _make_output_chunk(const std::shared_ptr<const Table>& input_table, const ChunkID chunk_id,
+                                  const Bitmap& matches, const std::shared_ptr<MemoryResource>& arena);
+
+  const ColumnID _column_id;
+  const ScanType _scan_type;
+  const AllTypeVariant _search_value;
+
+  mutable std::vector<std::pair<ColumnID, BloomFilterBuilder>> _bloom_filter_builders;
 };
 
 }  // namespace opossum
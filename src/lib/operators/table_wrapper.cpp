@@ -8,5 +8,9 @@ namespace opossum {
 
 TableWrapper::TableWrapper(const std::shared_ptr<const Table> table) : _table(table) {}
 
-std::shared_ptr<const Table> TableWrapper::_on_execute() { return _table; }
+const std::shared_ptr<const Table>& TableWrapper::table() const { return _table; }
+
+std::string TableWrapper::name() const { return "TableWrapper"; }
+
+std::shared_ptr<const Table> TableWrapper::_on_execute() const { return _table; }
 }  // namespace opossum
@@ -16,8 +16,12 @@ class TableWrapper : public AbstractOperator {
  public:
   explicit TableWrapper(const std::shared_ptr<const Table> table);
 
+  const std::shared_ptr<const Table>& table() const;
+
+  std::string name() const override;
+
  protected:
-  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<const Table> _on_execute() const override;
 
   // Table to retrieve
   const std::shared_ptr<const Table> _table;
@@ -0,0 +1,204 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "table_scan.hpp"
+#include "utils/arena.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A candidate row. The values of the sort columns after the first one are only read for rows that make it into a heap.
+template <typename T>
+struct TopKEntry {
+  T first_value;
+  std::vector<AllTypeVariant> other_values;
+  RowID row_id;
+};
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t k)
+    : AbstractOperator(in), _sort_definitions(sort_definitions), _k(k) {}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+size_t TopK::k() const { return _k; }
+
+size_t TopK::skipped_chunk_count() const { return _skipped_chunk_count; }
+
+std::string TopK::name() const { return "TopK"; }
+
+std::string TopK::description() const {
+  return name() + " " + std::to_string(_k) + " BY " + sort_definitions_description(_sort_definitions);
+}
+
+bool TopK::is_cacheable() const { return true; }
+
+std::shared_ptr<const Table> TopK::_on_execute() const {
+  Assert(!_sort_definitions.empty(), "TopK needs at least one column to sort by");
+  const auto input_table = _input_table_left();
+
+  auto row_ids = std::vector<RowID>{};
+  if (_k > 0) {
+    resolve_data_type(input_table->column_type(_sort_definitions.front().column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      row_ids = _top_k_row_ids<Type>();
+    });
+  }
+
+  auto output_table = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+  auto pos_list = make_pos_list(_arena);
+  pos_list->assign(row_ids.cbegin(), row_ids.cend());
+  auto output_chunk = Chunk{};
+  append_reference_segments(output_chunk, input_table, std::move(pos_list), _arena);
+  output_table->emplace_chunk(std::move(output_chunk));
+  _performance_data.skipped_chunk_count = _skipped_chunk_count;
+  return output_table;
+}
+
+template <typename T>
+std::vector<RowID> TopK::_top_k_row_ids() const {
+  const auto input_table = _input_table_left();
+  const auto first_column_id = _sort_definitions.front().column_id;
+  const auto first_descending = _sort_definitions.front().order_by_mode == OrderByMode::Descending;
+
+  // returns whether a value of the first sort column is ordered before another one
+  const auto first_precedes = [&](const T& lhs, const T& rhs) { return first_descending ? rhs < lhs : lhs < rhs; };
+
+  // orders the rows like Sort, i.e., rows with equal values keep their order
+  const auto precedes = [&](const TopKEntry<T>& lhs, const TopKEntry<T>& rhs) {
+    if (first_precedes(lhs.first_value, rhs.first_value)) return true;
+    if (first_precedes(rhs.first_value, lhs.first_value)) return false;
+    for (auto index = size_t{0}; index < lhs.other_values.size(); ++index) {
+      const auto& lhs_value = lhs.other_values[index];
+      const auto& rhs_value = rhs.other_values[index];
+      if (lhs_value == rhs_value) continue;
+      const auto descending = _sort_definitions[index + 1].order_by_mode == OrderByMode::Descending;
+      return descending ? rhs_value < lhs_value : lhs_value < rhs_value;
+    }
+    return lhs.row_id < rhs.row_id;
+  };
+
+  // The best value of the first sort column in each dictionary-encoded chunk. Chunks without bounds are processed
+  // first, as they can never be skipped, followed by the chunks with the best bounds.
+  const auto chunk_count = input_table->chunk_count();
+  auto bounds = std::vector<std::optional<T>>(chunk_count);
+  auto chunk_order = std::vector<ChunkID>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& chunk = input_table->get_chunk(chunk_id);
+    if (chunk.size() == 0) continue;
+    chunk_order.push_back(chunk_id);
+
+    const auto segment = chunk.get_segment(first_column_id);
+    if (segment->encoding_type() != EncodingType::Dictionary) continue;
+    const auto& dictionary = *static_cast<const DictionarySegment<T>&>(*segment).dictionary();
+    bounds[chunk_id] = first_descending ? dictionary.back() : dictionary.front();
+  }
+  std::stable_sort(chunk_order.begin(), chunk_order.end(), [&](const ChunkID lhs, const ChunkID rhs) {
+    if (!bounds[lhs] || !bounds[rhs]) return !bounds[lhs] && bounds[rhs];
+    return first_precedes(*bounds[lhs], *bounds[rhs]);
+  });
+
+  // the worst value of the first sort column among the best k rows found so far by any thread
+  auto shared_threshold = std::optional<T>{};
+  auto threshold_mutex = std::mutex{};
+
+  const auto thread_count = std::min(TaskScheduler::get().worker_count(), chunk_order.size());
+  auto heaps = std::vector<std::vector<TopKEntry<T>>>(thread_count);
+  auto next_chunk = std::atomic<size_t>{0};
+  parallel_for(thread_count, [&](const size_t thread_index) {
+    // the top of the heap is the worst of the best k rows of this thread
+    auto heap = std::priority_queue<TopKEntry<T>, std::vector<TopKEntry<T>>, decltype(precedes)>{precedes};
+
+    for (auto order_index = next_chunk++; order_index < chunk_order.size(); order_index = next_chunk++) {
+      const auto chunk_id = chunk_order[order_index];
+      const auto& chunk = input_table->get_chunk(chunk_id);
+
+      auto threshold = std::optional<T>{};
+      {
+        std::lock_guard<std::mutex> lock(threshold_mutex);
+        threshold = shared_threshold;
+      }
+      if (heap.size() == _k && (!threshold || first_precedes(heap.top().first_value, *threshold))) {
+        threshold = heap.top().first_value;
+      }
+      if (threshold && bounds[chunk_id] && first_precedes(*threshold, *bounds[chunk_id])) {
+        ++_skipped_chunk_count;
+        continue;
+      }
+
+      const auto invalidation_bitmap = TableScan::invalidation_bitmap(chunk);
+      segment_iterate<T>(*chunk.get_segment(first_column_id), [&](const ChunkOffset chunk_offset, const T& value) {
+        if (threshold && first_precedes(*threshold, value)) return;
+        if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) return;
+
+        auto entry = TopKEntry<T>{value, {}, RowID{chunk_id, chunk_offset}};
+        for (auto index = size_t{1}; index < _sort_definitions.size(); ++index) {
+          const auto segment = chunk.get_segment(_sort_definitions[index].column_id);
+          resolve_data_type(input_table->column_type(_sort_definitions[index].column_id), [&](auto type) {
+            using Type = typename decltype(type)::type;
+            entry.other_values.emplace_back(get_segment_value<Type>(*segment, chunk_offset));
+          });
+        }
+        if (heap.size() == _k && !precedes(entry, heap.top())) return;
+
+        heap.push(std::move(entry));
+        if (heap.size() > _k) heap.pop();
+        if (heap.size() == _k && (!threshold || first_precedes(heap.top().first_value, *threshold))) {
+          threshold = heap.top().first_value;
+        }
+      });
+
+      if (heap.size() == _k) {
+        std::lock_guard<std::mutex> lock(threshold_mutex);
+        if (!shared_threshold || first_precedes(heap.top().first_value, *shared_threshold)) {
+          shared_threshold = heap.top().first_value;
+        }
+      }
+    }
+
+    auto& entries = heaps[thread_index];
+    entries.reserve(heap.size());
+    while (!heap.empty()) {
+      entries.push_back(heap.top());
+      heap.pop();
+    }
+  });
+
+  auto entries = std::vector<TopKEntry<T>>{};
+  for (auto& heap : heaps) {
+    std::move(heap.begin(), heap.end(), std::back_inserter(entries));
+  }
+  const auto result_size = std::min(entries.size(), _k);
+  std::partial_sort(entries.begin(), entries.begin() + result_size, entries.end(), precedes);
+
+  auto row_ids = std::vector<RowID>(result_size);
+  for (auto index = size_t{0}; index < result_size; ++index) {
+    row_ids[index] = entries[index].row_id;
+  }
+  return row_ids;
+}
+
+}  // namespace opossum
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+// TopK returns the first k rows of its input in the order given by the sort columns, i.e., the same rows as a Sort
+// followed by a limit, without sorting the whole input. The output references the rows in sorted order.
+//
+// Each thread keeps a heap of the best k rows of the chunks it processed. Once a heap is full, its worst value of the
+// first sort column is a threshold: Rows whose value is worse cannot be among the first k rows. The thresholds of all
+// threads are shared, so that rows are skipped after comparing a single value. Dictionary-encoded chunks are skipped
+// altogether if their best dictionary value is worse than the threshold. They are processed in the order of their best
+// values, so that the threshold is found early and most chunks can be skipped. Finally, the heaps are merged.
+class TopK : public AbstractOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t k);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  size_t k() const;
+
+  // returns the number of chunks that were skipped because of their dictionary bounds
+  size_t skipped_chunk_count() const;
+
+  std::string name() const override;
+  std::string description() const override;
+  bool is_cacheable() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() const override;
+
+  template <typename T>
+  std::vector<RowID> _top_k_row_ids() const;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const size_t _k;
+  mutable std::atomic<size_t> _skipped_chunk_count{0};
+};
+
+}  // namespace opossum
@@ -129,4 +129,15 @@ void resolve_data_type(const std::string& type_string, const Functor& func) {
   });
 }
 
+// returns the type string of a data type, e.g., "long" for int64_t. This is the inverse of resolve_data_type.
+template <typename T>
+std::string data_type_name() {
+  auto type_string = std::string{};
+  hana::for_each(data_types, [&](auto x) {
+    if (hana::second(x) == hana::type_c<T>) type_string = hana::first(x);
+  });
+  DebugAssert(!type_string.empty(), "Not a data type");
+  return type_string;
+}
+
 }  // namespace opossum
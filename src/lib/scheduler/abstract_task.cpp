@@ -0,0 +1,20 @@
+#include "abstract_task.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void AbstractTask::set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor) {
+  Assert(!_is_scheduled && !successor->_is_scheduled, "Dependencies must be set before the tasks are scheduled");
+  _successors.emplace_back(successor);
+  ++successor->_pending_predecessor_count;
+}
+
+const std::vector<std::shared_ptr<AbstractTask>>& AbstractTask::successors() const { return _successors; }
+
+bool AbstractTask::is_done() const { return _is_done; }
+
+}  // namespace opossum
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractTask is the super class of the units of work that the TaskScheduler runs. Tasks form a DAG: a task only
+// runs once all of its predecessors are done. If a task throws, its successors are not run, but fail with the same
+// exception.
+class AbstractTask : private Noncopyable {
+ public:
+  virtual ~AbstractTask() = default;
+
+  // Makes the successor wait for this task. Both tasks must not have been scheduled yet.
+  void set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor);
+
+  const std::vector<std::shared_ptr<AbstractTask>>& successors() const;
+
+  bool is_done() const;
+
+ protected:
+  friend class TaskScheduler;
+
+  virtual void _on_execute() = 0;
+
+  std::vector<std::shared_ptr<AbstractTask>> _successors;
+  std::atomic<size_t> _pending_predecessor_count{0};
+  std::atomic<bool> _is_scheduled{false};
+  std::atomic<bool> _is_done{false};
+
+  // the exception thrown by the task or by one of its predecessors
+  std::exception_ptr _exception;
+
+  // the number of tasks of the same TaskScheduler::schedule_and_wait call that are not done yet
+  std::shared_ptr<std::atomic<size_t>> _pending_task_count;
+};
+
+}  // namespace opossum
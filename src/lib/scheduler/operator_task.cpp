@@ -0,0 +1,76 @@
+#include "operator_task.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "operators/abstract_operator.hpp"
+
+namespace opossum {
+
+namespace {
+
+// returns whether the operator is executed before the other one because of its inputs or execute_after hints
+bool precedes(const AbstractOperator& op, const AbstractOperator& other,
+              std::unordered_set<const AbstractOperator*>& visited_operators) {
+  if (&op == &other) return true;
+  if (!visited_operators.emplace(&other).second) return false;
+
+  for (const auto& predecessor : other.execute_after_operators()) {
+    if (precedes(op, *predecessor, visited_operators)) return true;
+  }
+  for (const auto& input : {other.input_left(), other.input_right()}) {
+    if (input && precedes(op, *input, visited_operators)) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+OperatorTask::OperatorTask(const std::shared_ptr<const AbstractOperator>& op) : _operator(op) {}
+
+std::vector<std::shared_ptr<AbstractTask>> OperatorTask::make_tasks(
+    const std::vector<std::shared_ptr<const AbstractOperator>>& operators) {
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto task_by_operator = std::unordered_map<const AbstractOperator*, std::shared_ptr<OperatorTask>>{};
+
+  // creates the tasks of an operator and its inputs, returns nullptr if the operator has been executed already
+  const auto make_task = [&](const auto& self, const std::shared_ptr<const AbstractOperator>& op) {
+    if (op->get_output()) return std::shared_ptr<OperatorTask>{};
+    auto& task = task_by_operator[op.get()];
+    if (task) return task;
+
+    task = std::make_shared<OperatorTask>(op);
+    auto new_task = task;
+    for (const auto& input : {op->input_left(), op->input_right()}) {
+      if (!input) continue;
+      if (const auto input_task = self(self, input)) input_task->set_as_predecessor_of(new_task);
+    }
+    tasks.emplace_back(new_task);
+    return new_task;
+  };
+  for (const auto& op : operators) make_task(make_task, op);
+
+  // The execute_after hints are only followed between operators of the DAGs and if they do not lead to a cycle
+  for (const auto& [op, task] : task_by_operator) {
+    for (const auto& predecessor : op->execute_after_operators()) {
+      const auto predecessor_task = task_by_operator.find(predecessor.get());
+      if (predecessor_task == task_by_operator.end()) continue;
+      auto visited_operators = std::unordered_set<const AbstractOperator*>{};
+      if (precedes(*op, *predecessor, visited_operators)) continue;
+      predecessor_task->second->set_as_predecessor_of(task);
+    }
+  }
+
+  return tasks;
+}
+
+const std::shared_ptr<const AbstractOperator>& OperatorTask::get_operator() const { return _operator; }
+
+void OperatorTask::_on_execute() {
+  // the inputs of the operator are done by now
+  _operator->_execute_operator();
+}
+
+}  // namespace opossum
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_task.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+
+// a task that executes an operator, whose inputs are executed by its predecessors
+class OperatorTask : public AbstractTask {
+ public:
+  explicit OperatorTask(const std::shared_ptr<const AbstractOperator>& op);
+
+  // Returns one task for each operator in the DAGs of the given operators that has not been executed yet, including
+  // the given ones. Each task is the successor of the tasks of the operator's inputs and of the operators that it
+  // should be executed after (see AbstractOperator::execute_after). Inputs shared by several operators are executed
+  // once.
+  static std::vector<std::shared_ptr<AbstractTask>> make_tasks(
+      const std::vector<std::shared_ptr<const AbstractOperator>>& operators);
+
+  const std::shared_ptr<const AbstractOperator>& get_operator() const;
+
+ protected:
+  void _on_execute() override;
+
+  const std::shared_ptr<const AbstractOperator> _operator;
+};
+
+}  // namespace opossum
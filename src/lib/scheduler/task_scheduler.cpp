@@ -0,0 +1,159 @@
+#include "task_scheduler.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the scheduler and the index of the worker that the current thread runs, if any
+thread_local const TaskScheduler* current_scheduler = nullptr;
+thread_local size_t current_worker_index = 0;
+
+}  // namespace
+
+TaskScheduler& TaskScheduler::get() {
+  static auto scheduler = TaskScheduler{std::max(std::thread::hardware_concurrency(), 1u)};
+  return scheduler;
+}
+
+TaskScheduler::TaskScheduler(const size_t worker_count) {
+  Assert(worker_count > 0, "The scheduler needs at least one worker");
+  for (auto worker_index = size_t{0}; worker_index < worker_count; ++worker_index) {
+    _workers.emplace_back(std::make_unique<Worker>());
+  }
+  for (auto worker_index = size_t{0}; worker_index < worker_count; ++worker_index) {
+    _threads.emplace_back([this, worker_index]() { _work(worker_index); });
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown_requested = true;
+  }
+  _condition.notify_all();
+  for (auto& thread : _threads) thread.join();
+}
+
+void TaskScheduler::schedule_and_wait(const std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  if (tasks.empty()) return;
+
+  auto pending_task_count = std::make_shared<std::atomic<size_t>>(tasks.size());
+  for (const auto& task : tasks) {
+    Assert(!task->_is_scheduled.exchange(true), "Tasks must only be scheduled once");
+    task->_pending_task_count = pending_task_count;
+  }
+
+  // The tasks without predecessors are determined before any task runs, as running tasks schedule their successors.
+  auto ready_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (const auto& task : tasks) {
+    for ([[maybe_unused]] const auto& successor : task->successors()) {
+      DebugAssert(successor->_pending_task_count == pending_task_count, "Successors must be scheduled with the task");
+    }
+    if (task->_pending_predecessor_count == 0) ready_tasks.emplace_back(task);
+  }
+  Assert(!ready_tasks.empty(), "The tasks must not depend on each other in a cycle");
+  for (const auto& task : ready_tasks) _schedule(task);
+
+  const auto worker_index =
+      current_scheduler == this ? current_worker_index : _next_worker_index++ % _workers.size();
+  while (*pending_task_count > 0) {
+    if (const auto task = _take_task(worker_index)) {
+      _run(*task);
+      continue;
+    }
+    auto lock = std::unique_lock<std::mutex>{_mutex};
+    _condition.wait(lock, [&]() { return *pending_task_count == 0 || _queued_task_count > 0; });
+  }
+
+  for (const auto& task : tasks) {
+    if (task->_exception) std::rethrow_exception(task->_exception);
+  }
+}
+
+size_t TaskScheduler::worker_count() const { return _workers.size(); }
+
+void TaskScheduler::_schedule(const std::shared_ptr<AbstractTask>& task) {
+  const auto worker_index =
+      current_scheduler == this ? current_worker_index : _next_worker_index++ % _workers.size();
+  {
+    auto& worker = *_workers[worker_index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.emplace_back(task);
+  }
+  ++_queued_task_count;
+
+  // the lock makes sure that sleeping threads either see the task or are woken up
+  { std::lock_guard<std::mutex> lock(_mutex); }
+  _condition.notify_one();
+}
+
+std::shared_ptr<AbstractTask> TaskScheduler::_take_task(const size_t worker_index) {
+  const auto worker_count = _workers.size();
+  for (auto offset = size_t{0}; offset < worker_count && _queued_task_count > 0; ++offset) {
+    auto& worker = *_workers[(worker_index + offset) % worker_count];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) continue;
+
+    auto task = std::shared_ptr<AbstractTask>{};
+    if (offset == 0) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    } else {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+    }
+    --_queued_task_count;
+    return task;
+  }
+  return nullptr;
+}
+
+void TaskScheduler::_run(AbstractTask& task) {
+  if (!task._exception) {
+    try {
+      task._on_execute();
+    } catch (...) {
+      task._exception = std::current_exception();
+    }
+  }
+
+  for (const auto& successor : task._successors) {
+    if (task._exception) {
+      std::lock_guard<std::mutex> lock(_exception_mutex);
+      if (!successor->_exception) successor->_exception = task._exception;
+    }
+    if (--successor->_pending_predecessor_count == 0) _schedule(successor);
+  }
+
+  task._is_done = true;
+  if (--*task._pending_task_count == 0) {
+    { std::lock_guard<std::mutex> lock(_mutex); }
+    _condition.notify_all();
+  }
+}
+
+void TaskScheduler::_work(const size_t worker_index) {
+  current_scheduler = this;
+  current_worker_index = worker_index;
+
+  while (true) {
+    if (const auto task = _take_task(worker_index)) {
+      _run(*task);
+      continue;
+    }
+    auto lock = std::unique_lock<std::mutex>{_mutex};
+    if (_shutdown_requested && _queued_task_count == 0) return;
+    _condition.wait(lock, [&]() { return _shutdown_requested || _queued_task_count > 0; });
+  }
+}
+
+}  // namespace opossum
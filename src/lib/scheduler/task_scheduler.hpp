@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+
+// The TaskScheduler runs tasks on one worker thread per core. Each worker has a deque of tasks that are ready to run.
+// Workers take the task they queued most recently from the back of their own deque, which is likely still in their
+// cache, and steal the oldest task from the front of the deque of another worker once their own deque is empty.
+//
+// Tasks that become ready because their last predecessor finished are queued on the worker that finished it, so that
+// a chain of dependent tasks tends to stay on one core while independent chains spread over the workers.
+class TaskScheduler : private Noncopyable {
+ public:
+  // the scheduler with one worker per core that operators use
+  static TaskScheduler& get();
+
+  explicit TaskScheduler(const size_t worker_count);
+
+  // waits for the workers to finish their queued tasks
+  ~TaskScheduler();
+
+  // Runs the tasks, which must include all of their successors, and returns once all of them are done. The calling
+  // thread runs tasks as well while it waits. Rethrows the first exception thrown by a task.
+  void schedule_and_wait(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
+
+  // the number of worker threads, by which operators size their parallel work, e.g., the number of partitions
+  size_t worker_count() const;
+
+ protected:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<AbstractTask>> tasks;
+  };
+
+  // queues a task whose predecessors are done
+  void _schedule(const std::shared_ptr<AbstractTask>& task);
+
+  // takes a task from the back of the worker's deque or steals one from the front of another deque
+  std::shared_ptr<AbstractTask> _take_task(const size_t worker_index);
+
+  // runs a task and schedules its successors that became ready
+  void _run(AbstractTask& task);
+
+  void _work(const size_t worker_index);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::thread> _threads;
+
+  // the number of tasks in all deques, which wakes up sleeping workers
+  std::atomic<size_t> _queued_task_count{0};
+  // spreads the tasks scheduled from threads other than the workers
+  std::atomic<size_t> _next_worker_index{0};
+
+  // workers and waiting threads sleep on the condition if no task is queued
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _shutdown_requested{false};
+
+  // protects the exceptions that failed tasks pass on to their successors
+  std::mutex _exception_mutex;
+};
+
+}  // namespace opossum
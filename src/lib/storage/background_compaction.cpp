@@ -0,0 +1,63 @@
+#include "background_compaction.hpp"
+
+#include <chrono>
+#include <mutex>
+
+#include "storage_manager.hpp"
+#include "table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BackgroundCompaction::BackgroundCompaction(double deleted_row_ratio, std::chrono::milliseconds interval)
+    : _deleted_row_ratio(deleted_row_ratio), _interval(interval) {
+  Assert(deleted_row_ratio > 0.0 && deleted_row_ratio <= 1.0, "Deleted row ratio must be in (0, 1]");
+}
+
+BackgroundCompaction::~BackgroundCompaction() { stop(); }
+
+void BackgroundCompaction::start() {
+  Assert(!_thread.joinable(), "Background compaction is already running");
+  _stop_requested = false;
+  _thread = std::thread([this]() {
+    auto lock = std::unique_lock<std::mutex>{_mutex};
+    while (!_stop_condition.wait_for(lock, _interval, [this]() { return _stop_requested; })) {
+      compact();
+    }
+  });
+}
+
+void BackgroundCompaction::stop() {
+  if (!_thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop_requested = true;
+  }
+  _stop_condition.notify_one();
+  _thread.join();
+}
+
+size_t BackgroundCompaction::compact() {
+  auto& storage_manager = StorageManager::get();
+  auto compacted_chunk_count = size_t{0};
+
+  // the tables are taken under the lock of the StorageManager, so that tables can be added and dropped meanwhile
+  for (const auto& [table_name, table] : storage_manager.stored_tables()) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      if (chunk.size() == 0) continue;
+
+      const auto deleted_row_ratio = static_cast<double>(chunk.invalid_row_count()) / chunk.size();
+      if (deleted_row_ratio < _deleted_row_ratio) continue;
+
+      table->compact_chunk(chunk_id);
+      ++compacted_chunk_count;
+    }
+  }
+
+  return compacted_chunk_count;
+}
+
+double BackgroundCompaction::deleted_row_ratio() const { return _deleted_row_ratio; }
+
+}  // namespace opossum
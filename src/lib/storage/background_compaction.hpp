@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// The BackgroundCompaction periodically compacts the chunks of the tables in the StorageManager whose share of
+// deleted rows exceeds the given ratio (see Table::compact_chunk). This physically removes deleted rows without
+// rebuilding the whole table.
+//
+// Compaction replaces chunks in place. It waits until no operator reads the affected table (see
+// Table::lock_for_reading). Results that were computed before reference outdated positions and are rejected by
+// subsequent operators, e.g., a Delete, instead of deleting other rows.
+class BackgroundCompaction : private Noncopyable {
+ public:
+  explicit BackgroundCompaction(double deleted_row_ratio = 0.5,
+                                std::chrono::milliseconds interval = std::chrono::milliseconds{1000});
+
+  // stops the background thread if it is running
+  ~BackgroundCompaction();
+
+  // starts or stops a thread that calls compact() once per interval
+  void start();
+  void stop();
+
+  // compacts all chunks that exceed the deleted row ratio and returns how many chunks were compacted
+  size_t compact();
+
+  double deleted_row_ratio() const;
+
+ protected:
+  const double _deleted_row_ratio;
+  const std::chrono::milliseconds _interval;
+
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _stop_condition;
+  bool _stop_requested{false};
+};
+
+}  // namespace opossum
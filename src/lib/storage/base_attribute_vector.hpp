@@ -27,5 +27,8 @@ class BaseAttributeVector : private Noncopyable {
 
   // returns the width of biggest value id in bytes
   virtual AttributeVectorWidth width() const = 0;
+
+  // returns a pointer to the value ids, which are stored contiguously with width() bytes each
+  virtual const void* data() const = 0;
 };
 }  // namespace opossum
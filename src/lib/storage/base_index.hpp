@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// BaseIndex is the abstract super class for all chunk indexes, e.g., GroupKeyIndex.
+// An index covers one segment and yields the offsets of the rows in the order of their values.
+class BaseIndex : private Noncopyable {
+ public:
+  using Iterator = std::vector<ChunkOffset>::const_iterator;
+
+  BaseIndex() = default;
+  virtual ~BaseIndex() = default;
+
+  // returns an iterator to the first offset whose value is >= the search value
+  virtual Iterator lower_bound(const AllTypeVariant& value) const = 0;
+
+  // returns an iterator to the first offset whose value is > the search value
+  virtual Iterator upper_bound(const AllTypeVariant& value) const = 0;
+
+  // returns an iterator to the offset of the smallest value
+  virtual Iterator cbegin() const = 0;
+
+  // returns an iterator past the offset of the largest value
+  virtual Iterator cend() const = 0;
+
+  // returns the calculated memory usage
+  virtual size_t estimate_memory_usage() const = 0;
+};
+}  // namespace opossum
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "all_type_variant.hpp"
+#include "encoding_type.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -28,5 +29,8 @@ class BaseSegment : private Noncopyable {
 
   // returns the calculated memory usage
   virtual size_t estimate_memory_usage() const = 0;
+
+  // returns how the segment stores its values
+  virtual EncodingType encoding_type() const = 0;
 };
 }  // namespace opossum
@@ -1,3 +1,6 @@
+#include <boost/container/pmr/synchronized_pool_resource.hpp>
+
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <limits>
@@ -7,13 +10,36 @@
 #include <utility>
 #include <vector>
 
+#include "base_index.hpp"
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "proxy_segment.hpp"
 
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+Chunk::Chunk() : _memory_resource(std::make_shared<boost::container::pmr::synchronized_pool_resource>()) {}
+
+Chunk::Chunk(MemoryResource* upstream_memory_resource)
+    : _memory_resource(std::make_shared<boost::container::pmr::synchronized_pool_resource>(upstream_memory_resource)) {}
+
+Chunk::Chunk(Chunk&& other)
+    : column_segments(std::move(other.column_segments)),
+      _indexes(std::move(other._indexes)),
+      _memory_resource(std::move(other._memory_resource)),
+      _accessed(other._accessed.load()),
+      _invalidation_bitmap(std::atomic_load(&other._invalidation_bitmap)) {}
+
+Chunk& Chunk::operator=(Chunk&& other) {
+  column_segments = std::move(other.column_segments);
+  _indexes = std::move(other._indexes);
+  _memory_resource = std::move(other._memory_resource);
+  _accessed = other._accessed.load();
+  std::atomic_store(&_invalidation_bitmap, std::atomic_load(&other._invalidation_bitmap));
+  return *this;
+}
+
 void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) { column_segments.push_back(segment); }
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
@@ -26,10 +52,98 @@ void Chunk::append(const std::vector<AllTypeVariant>& values) {
   }
 }
 
-std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const { return column_segments.at((int)column_id); }
+std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const {
+  _accessed.store(true, std::memory_order_relaxed);
+
+  const auto& segment = column_segments.at(column_id);
+  if (segment->encoding_type() == EncodingType::Proxy) {
+    return static_cast<const ProxySegment&>(*segment).load();
+  }
+  return segment;
+}
+
+std::shared_ptr<BaseSegment> Chunk::get_stored_segment(ColumnID column_id) const {
+  return column_segments.at(column_id);
+}
+
+void Chunk::replace_segment(ColumnID column_id, std::shared_ptr<BaseSegment> segment) {
+  DebugAssert(segment->size() == column_segments.at(column_id)->size(), "Replacement segment has a different size");
+  column_segments.at(column_id) = std::move(segment);
+  if (column_id < _indexes.size()) _indexes[column_id] = nullptr;
+}
+
+void Chunk::add_index(ColumnID column_id, std::shared_ptr<BaseIndex> index) {
+  DebugAssert(column_id < column_count(), "Cannot index a column that does not exist");
+  _indexes.resize(column_count());
+  _indexes[column_id] = std::move(index);
+}
+
+std::shared_ptr<BaseIndex> Chunk::get_index(ColumnID column_id) const {
+  const auto& segment = column_segments.at(column_id);
+  if (segment->encoding_type() == EncodingType::Proxy) {
+    _accessed.store(true, std::memory_order_relaxed);
+    return static_cast<const ProxySegment&>(*segment).index();
+  }
+  return column_id < _indexes.size() ? _indexes[column_id] : nullptr;
+}
+
+PolymorphicAllocator<size_t> Chunk::get_allocator() const {
+  return PolymorphicAllocator<size_t>{_memory_resource.get()};
+}
+
+const std::shared_ptr<MemoryResource>& Chunk::memory_resource() const { return _memory_resource; }
+
+bool Chunk::reset_access_flag() { return _accessed.exchange(false, std::memory_order_relaxed); }
+
+void Chunk::invalidate_rows(const std::vector<ChunkOffset>& chunk_offsets) {
+  std::lock_guard<std::mutex> lock(_invalidation_mutex);
+
+  const auto previous_bitmap = std::atomic_load(&_invalidation_bitmap);
+  auto bitmap = previous_bitmap ? std::make_shared<std::vector<uint64_t>>(*previous_bitmap)
+                                : std::make_shared<std::vector<uint64_t>>();
+  bitmap->resize(std::max(bitmap->size(), (size_t{size()} + 63) / 64));
+
+  for (const auto chunk_offset : chunk_offsets) {
+    DebugAssert(chunk_offset < size(), "Cannot invalidate a row that does not exist");
+    (*bitmap)[chunk_offset / 64] |= uint64_t{1} << (chunk_offset % 64);
+  }
+
+  std::atomic_store(&_invalidation_bitmap, std::shared_ptr<const std::vector<uint64_t>>{std::move(bitmap)});
+}
+
+bool Chunk::is_valid(ChunkOffset chunk_offset) const {
+  const auto bitmap = std::atomic_load(&_invalidation_bitmap);
+  return is_valid_in_bitmap(bitmap.get(), chunk_offset);
+}
+
+uint32_t Chunk::invalid_row_count() const {
+  const auto bitmap = std::atomic_load(&_invalidation_bitmap);
+  if (!bitmap) return 0;
+
+  auto invalid_row_count = uint32_t{0};
+  for (const auto word : *bitmap) {
+    invalid_row_count += static_cast<uint32_t>(__builtin_popcountll(word));
+  }
+  return invalid_row_count;
+}
+
+std::shared_ptr<const std::vector<uint64_t>> Chunk::invalidation_bitmap() const {
+  return std::atomic_load(&_invalidation_bitmap);
+}
 
 uint16_t Chunk::column_count() const { return column_segments.size(); }
 
 uint32_t Chunk::size() const { return column_segments.size() != 0 ? column_segments.front().get()->size() : 0; }
 
+size_t Chunk::estimate_memory_usage() const {
+  auto memory_usage = size_t{0};
+  for (const auto& segment : column_segments) {
+    memory_usage += segment->estimate_memory_usage();
+  }
+  for (const auto& index : _indexes) {
+    if (index) memory_usage += index->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
 }  // namespace opossum
@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -20,14 +21,20 @@ class BaseSegment;
 // For each column in the table, it holds one segment. The segments across all chunks constitute the column.
 //
 // Find more information about this in our wiki: https://github.com/hyrise/hyrise/wiki/chunk-concept
+//
+// Each chunk owns an arena from which its segments should be allocated (see get_allocator()). This keeps the segments
+// of a chunk close together and frees their memory in one go when the chunk is dropped.
 class Chunk : private Noncopyable {
  public:
-  Chunk() = default;
+  Chunk();
+
+  // creates a chunk whose arena requests its memory from the given resource, e.g., the HugePageMemoryResource
+  explicit Chunk(MemoryResource* upstream_memory_resource);
 
-  // we need to explicitly set the move constructor to default when
-  // we overwrite the copy constructor
-  Chunk(Chunk&&) = default;
-  Chunk& operator=(Chunk&&) = default;
+  // we need to explicitly define the move constructor when
+  // we overwrite the copy constructor (std::atomic is not movable)
+  Chunk(Chunk&& other);
+  Chunk& operator=(Chunk&& other);
 
   // adds a segment to the "right" of the chunk
   void add_segment(std::shared_ptr<BaseSegment> segment);
@@ -43,10 +50,72 @@ class Chunk : private Noncopyable {
   void append(const std::vector<AllTypeVariant>& values);
 
   // Returns the segment at a given position
+  // Evicted segments are read back from disk, i.e., this never returns a ProxySegment. Marks the chunk as accessed.
   std::shared_ptr<BaseSegment> get_segment(ColumnID column_id) const;
 
+  // Returns the segment at a given position as it is stored, possibly as ProxySegment.
+  // Does not load evicted segments and does not count as an access.
+  std::shared_ptr<BaseSegment> get_stored_segment(ColumnID column_id) const;
+
+  // replaces the segment at a given position, e.g., by a ProxySegment when the chunk is evicted
+  // the index on the column is dropped, as it was built on the replaced segment and keeps parts of it alive, but a
+  // ProxySegment rebuilds it when it is loaded
+  // note this is not thread-safe and must not be called while operators read the chunk, see Table::evict_chunk
+  void replace_segment(ColumnID column_id, std::shared_ptr<BaseSegment> segment);
+
+  // adds an index on the given column, replacing a previous index on that column
+  // note this is not thread-safe and must not be called while operators read the chunk
+  void add_index(ColumnID column_id, std::shared_ptr<BaseIndex> index);
+
+  // Returns the index on the given column, or nullptr if the column is not indexed in this chunk. The index of an
+  // evicted segment is rebuilt when the segment is read back from disk, which marks the chunk as accessed.
+  std::shared_ptr<BaseIndex> get_index(ColumnID column_id) const;
+
+  // returns whether the chunk was accessed through get_segment since the last call and resets the access flag
+  // this serves as the reference bit for the eviction policy
+  bool reset_access_flag();
+
+  // Marks the rows at the given offsets as deleted. They remain in the segments until the chunk is compacted (see
+  // Table::compact_chunk), but scans skip them.
+  void invalidate_rows(const std::vector<ChunkOffset>& chunk_offsets);
+
+  // returns whether the row at the given offset has not been deleted
+  bool is_valid(ChunkOffset chunk_offset) const;
+
+  // returns the number of deleted rows
+  uint32_t invalid_row_count() const;
+
+  // Returns the invalidation bitmap, in which bit (i % 64) of word (i / 64) is set if row i was deleted, or nullptr if
+  // no row was deleted. Rows beyond the end of the bitmap are valid. The bitmap is never modified once it is returned,
+  // later deletes work on a copy. Thus, operators can use it without synchronization.
+  std::shared_ptr<const std::vector<uint64_t>> invalidation_bitmap() const;
+
+  // returns the calculated memory usage of all segments and indexes
+  size_t estimate_memory_usage() const;
+
+  // returns an allocator that allocates from the chunk's arena
+  // segments using it must keep the arena alive, see keep_memory_resource_alive()
+  PolymorphicAllocator<size_t> get_allocator() const;
+
+  const std::shared_ptr<MemoryResource>& memory_resource() const;
+
  protected:
   std::vector<std::shared_ptr<BaseSegment>> column_segments;
+  // one entry per column, nullptr for columns without index
+  std::vector<std::shared_ptr<BaseIndex>> _indexes;
+  std::shared_ptr<MemoryResource> _memory_resource;
+  mutable std::atomic<bool> _accessed{false};
+
+  // only accessed with std::atomic_load and std::atomic_store
+  std::shared_ptr<const std::vector<uint64_t>> _invalidation_bitmap;
+  // serializes concurrent deletes, which copy and replace the bitmap
+  std::mutex _invalidation_mutex;
 };
 
+// returns whether a row is valid according to an invalidation bitmap as returned by Chunk::invalidation_bitmap()
+inline bool is_valid_in_bitmap(const std::vector<uint64_t>* invalidation_bitmap, const ChunkOffset chunk_offset) {
+  if (!invalidation_bitmap || chunk_offset / 64 >= invalidation_bitmap->size()) return true;
+  return ((*invalidation_bitmap)[chunk_offset / 64] & (uint64_t{1} << (chunk_offset % 64))) == 0;
+}
+
 }  // namespace opossum
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <set>
@@ -11,8 +13,10 @@
 #include "all_type_variant.hpp"
 #include "base_attribute_vector.hpp"
 #include "fixed_size_attribute_vector.hpp"
-#include "value_segment.hpp"
 #include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
@@ -29,45 +33,50 @@ class DictionarySegment : public BaseSegment {
  public:
   /**
    * Creates a Dictionary segment from a given value segment.
+   * The dictionary and the attribute vector are allocated using the given allocator.
    */
-  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment) {
-    _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint16_t>>(FixedSizeAttributeVector<uint16_t>());
-
+  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment,
+                             const PolymorphicAllocator<T>& allocator = {}) {
     std::set<T> set_dict = std::set<T>();
 
     const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    Assert(value_segment, "DictionarySegment can only be created from a ValueSegment of the same type");
 
-    const auto values = value_segment->values();
+    const auto& values = value_segment->values();
     //Insert values in set to delete duplicates
-    for (auto value : values) {
+    for (const auto& value : values) {
       set_dict.emplace(value);
     }
 
     // Convert set to vector to create the dictionary
-    const auto dict = std::vector<T>(set_dict.begin(), set_dict.end());
-
-    // Create pointer for new dict
-    _dictionary = std::make_shared<std::vector<T>>(dict);
+    _dictionary = std::make_shared<pmr_vector<T>>(set_dict.begin(), set_dict.end(), allocator);
 
-    const auto entropy = ((int)std::log2(_dictionary->size())) + 1;
+    const auto entropy = _dictionary->size() > 1 ? static_cast<int>(std::log2(_dictionary->size())) + 1 : 1;
     if (entropy <= 8) {
-      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint8_t>>(FixedSizeAttributeVector<uint8_t>());
+      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint8_t>>(allocator);
     } else if (entropy <= 16) {
-      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint16_t>>(FixedSizeAttributeVector<uint16_t>());
+      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint16_t>>(allocator);
     } else if (entropy <= 32) {
-      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint32_t>>(FixedSizeAttributeVector<uint32_t>());
+      _attribute_vector = std::make_shared<FixedSizeAttributeVector<uint32_t>>(allocator);
     } else {
       throw std::runtime_error(std::string("Not enough memory"));
     }
 
     for (size_t i = 0; i < values.size(); i++) {
-      //Get index of value from dict
-      const auto it = std::find(_dictionary->begin(), _dictionary->end(), values[i]);
-      const ValueID index = static_cast<ValueID>(std::distance(_dictionary->begin(), it));
+      //Get index of value from dict, which is sorted
+      const auto it = std::lower_bound(_dictionary->cbegin(), _dictionary->cend(), values[i]);
+      const ValueID index = static_cast<ValueID>(std::distance(_dictionary->cbegin(), it));
       _attribute_vector->set(i, index);
     }
   }
 
+  /**
+   * Creates a Dictionary segment from an already sorted dictionary and the matching attribute vector, e.g., when
+   * reading a segment back from disk.
+   */
+  DictionarySegment(std::shared_ptr<pmr_vector<T>> dictionary, std::shared_ptr<BaseAttributeVector> attribute_vector)
+      : _dictionary(std::move(dictionary)), _attribute_vector(std::move(attribute_vector)) {}
+
   // SEMINAR INFORMATION: Since most of these methods depend on the template parameter, you will have to implement
   // the DictionarySegment in this file. Replace the method signatures with actual implementations.
 
@@ -85,7 +94,7 @@ class DictionarySegment : public BaseSegment {
   }
 
   // returns an underlying dictionary
-  std::shared_ptr<const std::vector<T>> dictionary() const { return _dictionary; }
+  std::shared_ptr<const pmr_vector<T>> dictionary() const { return _dictionary; }
 
   // returns an underlying data structure
   std::shared_ptr<const BaseAttributeVector> attribute_vector() const { return _attribute_vector; }
@@ -130,15 +139,17 @@ class DictionarySegment : public BaseSegment {
   // return the number of entries
   size_t size() const override { return _attribute_vector->size(); }
 
-  // returns the calculated memory usage
+  // returns the calculated memory usage, including heap-allocated payloads of the dictionary values
   size_t estimate_memory_usage() const final {
     const auto memory_usage =
-        (_attribute_vector->size()) * _attribute_vector->width() + _dictionary->size() * sizeof(T);
+        (_attribute_vector->size()) * _attribute_vector->width() + opossum::estimate_memory_usage(*_dictionary);
     return memory_usage;
   }
 
+  EncodingType encoding_type() const final { return EncodingType::Dictionary; }
+
  protected:
-  std::shared_ptr<std::vector<T>> _dictionary;
+  std::shared_ptr<pmr_vector<T>> _dictionary;
   std::shared_ptr<BaseAttributeVector> _attribute_vector;
 };
 
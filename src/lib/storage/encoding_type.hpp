@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Describes how a segment stores its values. Reference segments do not store values themselves but point into
+// another table. Proxy segments stand in for segments that were evicted to disk.
+enum class EncodingType { Unencoded, Dictionary, Reference, Proxy };
+
+inline std::string encoding_type_to_string(const EncodingType encoding_type) {
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return "Unencoded";
+    case EncodingType::Dictionary:
+      return "Dictionary";
+    case EncodingType::Reference:
+      return "Reference";
+    case EncodingType::Proxy:
+      return "Proxy";
+  }
+  Fail("Unknown encoding type");
+  return "";
+}
+
+}  // namespace opossum
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "base_attribute_vector.hpp"
 #include "types.hpp"
 
@@ -8,7 +11,10 @@ namespace opossum {
 template <typename T>
 class FixedSizeAttributeVector : public BaseAttributeVector {
  public:
-  FixedSizeAttributeVector() { _vector = std::vector<T>(); }
+  explicit FixedSizeAttributeVector(const PolymorphicAllocator<T>& allocator = {}) : _vector(allocator) {}
+
+  // creates an attribute vector from already computed value ids
+  explicit FixedSizeAttributeVector(pmr_vector<T> values) : _vector(std::move(values)) {}
 
   ~FixedSizeAttributeVector() = default;
 
@@ -31,7 +37,29 @@ class FixedSizeAttributeVector : public BaseAttributeVector {
   // returns the width of biggest value id in bytes
   AttributeVectorWidth width() const override { return sizeof(T); };
 
+  // returns a pointer to the value ids
+  const void* data() const override { return _vector.data(); }
+
+  // returns all value ids, which allows operators to loop over them without a virtual call per value id
+  const pmr_vector<T>& values() const { return _vector; }
+
  protected:
-  std::vector<T> _vector;
+  pmr_vector<T> _vector;
 };
+
+// Calls the functor with the value ids of the given attribute vector, i.e., with a pmr_vector of uint8_t, uint16_t, or
+// uint32_t depending on its width
+template <typename Functor>
+void resolve_attribute_vector(const BaseAttributeVector& attribute_vector, const Functor& functor) {
+  switch (attribute_vector.width()) {
+    case 1:
+      functor(static_cast<const FixedSizeAttributeVector<uint8_t>&>(attribute_vector).values());
+      break;
+    case 2:
+      functor(static_cast<const FixedSizeAttributeVector<uint16_t>&>(attribute_vector).values());
+      break;
+    default:
+      functor(static_cast<const FixedSizeAttributeVector<uint32_t>&>(attribute_vector).values());
+  }
+}
 }  // namespace opossum
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_index.hpp"
+#include "dictionary_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
+#include "type_cast.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// GroupKeyIndex indexes a DictionarySegment. It groups the offsets of the segment by their ValueID, so that the offsets
+// of the i-th dictionary value are _positions[_value_start_offsets[i]] to _positions[_value_start_offsets[i + 1]].
+// As the dictionary is sorted, a lookup is a binary search in the dictionary and no separate tree is needed.
+template <typename T>
+class GroupKeyIndex : public BaseIndex {
+ public:
+  explicit GroupKeyIndex(const DictionarySegment<T>& segment)
+      : _dictionary(segment.dictionary()), _value_start_offsets(_dictionary->size() + 1), _positions(segment.size()) {
+    // counting sort of the offsets by their ValueID
+    resolve_attribute_vector(*segment.attribute_vector(), [&](const auto& value_ids) {
+      for (const auto value_id : value_ids) {
+        ++_value_start_offsets[value_id + 1];
+      }
+      for (auto value_id = size_t{1}; value_id < _value_start_offsets.size(); ++value_id) {
+        _value_start_offsets[value_id] += _value_start_offsets[value_id - 1];
+      }
+
+      auto next_positions = std::vector<ChunkOffset>(_value_start_offsets.cbegin(), _value_start_offsets.cend() - 1);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_ids.size(); ++chunk_offset) {
+        _positions[next_positions[value_ids[chunk_offset]]++] = chunk_offset;
+      }
+    });
+  }
+
+  Iterator lower_bound(const AllTypeVariant& value) const override { return lower_bound(type_cast<T>(value)); }
+
+  Iterator upper_bound(const AllTypeVariant& value) const override { return upper_bound(type_cast<T>(value)); }
+
+  // same as lower_bound(const AllTypeVariant&), but accepts a T
+  Iterator lower_bound(const T& value) const {
+    const auto value_id = std::lower_bound(_dictionary->cbegin(), _dictionary->cend(), value) - _dictionary->cbegin();
+    return _positions.cbegin() + _value_start_offsets[value_id];
+  }
+
+  // same as upper_bound(const AllTypeVariant&), but accepts a T
+  Iterator upper_bound(const T& value) const {
+    const auto value_id = std::upper_bound(_dictionary->cbegin(), _dictionary->cend(), value) - _dictionary->cbegin();
+    return _positions.cbegin() + _value_start_offsets[value_id];
+  }
+
+  Iterator cbegin() const override { return _positions.cbegin(); }
+
+  Iterator cend() const override { return _positions.cend(); }
+
+  // returns the offsets of the rows whose value is the dictionary value with the given ValueID
+  std::pair<Iterator, Iterator> positions(const ValueID value_id) const {
+    return {_positions.cbegin() + _value_start_offsets[value_id],
+            _positions.cbegin() + _value_start_offsets[value_id + 1]};
+  }
+
+  // returns the dictionary of the indexed segment, to which the ValueIDs refer
+  const pmr_vector<T>& dictionary() const { return *_dictionary; }
+
+  // the dictionary is shared with the segment and thus not counted, the chunk drops the index when it evicts the
+  // segment (see Chunk::replace_segment)
+  size_t estimate_memory_usage() const override {
+    return (_value_start_offsets.size() + _positions.size()) * sizeof(ChunkOffset);
+  }
+
+ protected:
+  std::shared_ptr<const pmr_vector<T>> _dictionary;
+  std::vector<ChunkOffset> _value_start_offsets;
+  std::vector<ChunkOffset> _positions;
+};
+
+}  // namespace opossum
@@ -0,0 +1,79 @@
+#include "memory_report.hpp"
+
+#include <iomanip>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+void MemoryReport::add_segment(SegmentMemoryUsage segment_memory_usage) {
+  _segments.emplace_back(std::move(segment_memory_usage));
+}
+
+const std::vector<SegmentMemoryUsage>& MemoryReport::segments() const { return _segments; }
+
+size_t MemoryReport::total_bytes() const {
+  auto total_bytes = size_t{0};
+  for (const auto& segment : _segments) {
+    total_bytes += segment.bytes;
+  }
+  return total_bytes;
+}
+
+std::map<std::string, size_t> MemoryReport::bytes_by_table() const {
+  auto bytes = std::map<std::string, size_t>{};
+  for (const auto& segment : _segments) {
+    bytes[segment.table_name] += segment.bytes;
+  }
+  return bytes;
+}
+
+std::map<ChunkID, size_t> MemoryReport::bytes_by_chunk(const std::string& table_name) const {
+  auto bytes = std::map<ChunkID, size_t>{};
+  for (const auto& segment : _segments) {
+    if (segment.table_name == table_name) bytes[segment.chunk_id] += segment.bytes;
+  }
+  return bytes;
+}
+
+std::map<std::string, size_t> MemoryReport::bytes_by_column(const std::string& table_name) const {
+  auto bytes = std::map<std::string, size_t>{};
+  for (const auto& segment : _segments) {
+    if (segment.table_name == table_name) bytes[segment.column_name] += segment.bytes;
+  }
+  return bytes;
+}
+
+std::map<EncodingType, size_t> MemoryReport::bytes_by_encoding() const {
+  auto bytes = std::map<EncodingType, size_t>{};
+  for (const auto& segment : _segments) {
+    bytes[segment.encoding_type] += segment.bytes;
+  }
+  return bytes;
+}
+
+size_t MemoryReport::huge_page_bytes() const {
+  auto bytes = size_t{0};
+  for (const auto& segment : _segments) {
+    if (segment.huge_page_backed) bytes += segment.bytes;
+  }
+  return bytes;
+}
+
+void MemoryReport::print(std::ostream& out) const {
+  out << "=== Memory usage: " << total_bytes() << " bytes (" << huge_page_bytes() << " bytes on huge pages)"
+      << std::endl;
+  for (const auto& [table_name, table_bytes] : bytes_by_table()) {
+    out << table_name << ": " << table_bytes << " bytes" << std::endl;
+    for (const auto& segment : _segments) {
+      if (segment.table_name != table_name) continue;
+      out << "  chunk " << std::setw(4) << segment.chunk_id << " | " << std::setw(20) << segment.column_name << " | "
+          << std::setw(10) << encoding_type_to_string(segment.encoding_type) << " | " << segment.bytes << " bytes"
+          << (segment.huge_page_backed ? " | huge pages" : "") << std::endl;
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// memory consumed by a single segment, i.e., one column within one chunk of a table
+struct SegmentMemoryUsage {
+  std::string table_name;
+  ChunkID chunk_id;
+  ColumnID column_id;
+  std::string column_name;
+  EncodingType encoding_type;
+  size_t bytes;
+  // whether the segment's values are stored on huge pages (see HugePageMemoryResource)
+  bool huge_page_backed;
+};
+
+// A MemoryReport breaks down the memory used by the tables in the StorageManager.
+// It is a snapshot, i.e., it does not change if the tables are modified after it was created.
+class MemoryReport {
+ public:
+  void add_segment(SegmentMemoryUsage segment_memory_usage);
+
+  // returns one entry per segment, ordered by table name, chunk, and column
+  const std::vector<SegmentMemoryUsage>& segments() const;
+
+  size_t total_bytes() const;
+
+  // aggregations of the segment entries
+  std::map<std::string, size_t> bytes_by_table() const;
+  std::map<ChunkID, size_t> bytes_by_chunk(const std::string& table_name) const;
+  std::map<std::string, size_t> bytes_by_column(const std::string& table_name) const;
+  std::map<EncodingType, size_t> bytes_by_encoding() const;
+
+  // returns the memory used by segments that are stored on huge pages
+  size_t huge_page_bytes() const;
+
+  // prints the memory usage per table, chunk, and column
+  void print(std::ostream& out = std::cout) const;
+
+ protected:
+  std::vector<SegmentMemoryUsage> _segments;
+};
+
+}  // namespace opossum
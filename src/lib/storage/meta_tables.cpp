@@ -0,0 +1,145 @@
+#include "meta_tables.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "dictionary_segment.hpp"
+#include "operators/operator_statistics.hpp"
+#include "resolve_type.hpp"
+#include "storage_manager.hpp"
+#include "table.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace {
+
+std::shared_ptr<Table> generate_meta_tables(const StorageManager& storage_manager) {
+  auto meta_table = std::make_shared<Table>();
+  meta_table->add_column("table_name", "string");
+  meta_table->add_column("column_count", "int");
+  meta_table->add_column("row_count", "long");
+  meta_table->add_column("chunk_count", "int");
+  meta_table->add_column("max_chunk_size", "long");
+  meta_table->add_column("memory_bytes", "long");
+
+  for (const auto& [table_name, table] : storage_manager.stored_tables()) {
+    meta_table->append({table_name, int32_t{table->column_count()}, static_cast<int64_t>(table->row_count()),
+                        static_cast<int32_t>(table->chunk_count()), int64_t{table->max_chunk_size()},
+                        static_cast<int64_t>(table->estimate_memory_usage())});
+  }
+  return meta_table;
+}
+
+std::shared_ptr<Table> generate_meta_chunks(const StorageManager& storage_manager) {
+  auto meta_table = std::make_shared<Table>();
+  meta_table->add_column("table_name", "string");
+  meta_table->add_column("chunk_id", "int");
+  meta_table->add_column("row_count", "long");
+  meta_table->add_column("invalid_row_count", "long");
+  meta_table->add_column("memory_bytes", "long");
+
+  for (const auto& [table_name, table] : storage_manager.stored_tables()) {
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      meta_table->append({table_name, static_cast<int32_t>(chunk_id), int64_t{chunk.size()},
+                          int64_t{chunk.invalid_row_count()}, static_cast<int64_t>(chunk.estimate_memory_usage())});
+    }
+  }
+  return meta_table;
+}
+
+// returns the width and the distinct count of a stored segment, or 0 for both if the segment was evicted to disk
+std::pair<int32_t, int64_t> segment_width_and_distinct_count(const BaseSegment& segment,
+                                                             const std::string& column_type) {
+  auto width = int32_t{0};
+  auto distinct_count = int64_t{0};
+  resolve_data_type(column_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    if (segment.encoding_type() == EncodingType::Unencoded) {
+      const auto& values = static_cast<const ValueSegment<Type>&>(segment).values();
+      width = sizeof(Type);
+      distinct_count = static_cast<int64_t>(std::unordered_set<Type>(values.cbegin(), values.cend()).size());
+    } else if (segment.encoding_type() == EncodingType::Dictionary) {
+      const auto& dictionary_segment = static_cast<const DictionarySegment<Type>&>(segment);
+      width = dictionary_segment.attribute_vector()->width();
+      distinct_count = static_cast<int64_t>(dictionary_segment.unique_values_count());
+    }
+  });
+  return {width, distinct_count};
+}
+
+std::shared_ptr<Table> generate_meta_segments(const StorageManager& storage_manager) {
+  auto meta_table = std::make_shared<Table>();
+  meta_table->add_column("table_name", "string");
+  meta_table->add_column("chunk_id", "int");
+  meta_table->add_column("column_id", "int");
+  meta_table->add_column("column_name", "string");
+  meta_table->add_column("column_type", "string");
+  meta_table->add_column("encoding", "string");
+  meta_table->add_column("width", "int");
+  meta_table->add_column("distinct_count", "long");
+  meta_table->add_column("memory_bytes", "long");
+
+  for (const auto& [table_name, table] : storage_manager.stored_tables()) {
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+        // the stored segment, so that evicted segments are not loaded and the chunk does not count as accessed
+        const auto segment = chunk.get_stored_segment(column_id);
+        const auto& column_type = table->column_type(column_id);
+        const auto [width, distinct_count] = segment_width_and_distinct_count(*segment, column_type);
+        meta_table->append({table_name, static_cast<int32_t>(chunk_id), static_cast<int32_t>(column_id),
+                            table->column_name(column_id), column_type,
+                            encoding_type_to_string(segment->encoding_type()), width, distinct_count,
+                            static_cast<int64_t>(segment->estimate_memory_usage())});
+      }
+    }
+  }
+  return meta_table;
+}
+
+std::shared_ptr<Table> generate_meta_operators() {
+  auto meta_table = std::make_shared<Table>();
+  meta_table->add_column("operator_name", "string");
+  meta_table->add_column("execution_count", "long");
+  meta_table->add_column("cached_count", "long");
+  meta_table->add_column("walltime_ns", "long");
+  meta_table->add_column("cpu_time_ns", "long");
+  meta_table->add_column("input_row_count", "long");
+  meta_table->add_column("output_row_count", "long");
+
+  for (const auto& [operator_name, entry] : OperatorStatistics::get().entries()) {
+    meta_table->append({operator_name, static_cast<int64_t>(entry.execution_count),
+                        static_cast<int64_t>(entry.cached_count), static_cast<int64_t>(entry.walltime.count()),
+                        static_cast<int64_t>(entry.cpu_time.count()), static_cast<int64_t>(entry.input_row_count),
+                        static_cast<int64_t>(entry.output_row_count)});
+  }
+  return meta_table;
+}
+
+}  // namespace
+
+bool MetaTables::is_meta_table(const std::string& name) {
+  const auto names = table_names();
+  return std::find(names.cbegin(), names.cend(), name) != names.cend();
+}
+
+std::vector<std::string> MetaTables::table_names() {
+  return {"meta_chunks", "meta_operators", "meta_segments", "meta_tables"};
+}
+
+std::shared_ptr<Table> MetaTables::generate(const std::string& name, const StorageManager& storage_manager) {
+  if (name == "meta_tables") return generate_meta_tables(storage_manager);
+  if (name == "meta_chunks") return generate_meta_chunks(storage_manager);
+  if (name == "meta_segments") return generate_meta_segments(storage_manager);
+  if (name == "meta_operators") return generate_meta_operators();
+  Fail("Not a meta table: " + name);
+  return nullptr;
+}
+
+}  // namespace opossum
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opossum {
+
+class StorageManager;
+class Table;
+
+// MetaTables generates tables that describe the tables of the StorageManager and the executed operators, so that a
+// deployment can be analyzed with the regular operators, e.g., GetTable("meta_segments") followed by an Aggregate of
+// the memory bytes per encoding. The StorageManager generates them on demand whenever they are requested, so that
+// they always show the current state:
+//
+// meta_tables:    table_name, column_count, row_count, chunk_count, max_chunk_size, memory_bytes
+// meta_chunks:    table_name, chunk_id, row_count, invalid_row_count, memory_bytes
+// meta_segments:  table_name, chunk_id, column_id, column_name, column_type, encoding, width, distinct_count,
+//                 memory_bytes
+// meta_operators: operator_name, execution_count, cached_count, walltime_ns, cpu_time_ns, input_row_count,
+//                 output_row_count
+//
+// The width of a segment is the number of bytes per value without heap payloads, i.e., sizeof the data type for
+// unencoded segments and the width of the value ids for dictionary segments. Segments that were evicted to disk are
+// not loaded, so that their width and distinct count are 0. meta_operators sums up the executions since the start or
+// the last OperatorStatistics::reset.
+class MetaTables {
+ public:
+  // returns whether the name refers to a meta table rather than a stored table
+  static bool is_meta_table(const std::string& name);
+
+  static std::vector<std::string> table_names();
+
+  // generates the meta table with the given name from the current state of the StorageManager
+  static std::shared_ptr<Table> generate(const std::string& name, const StorageManager& storage_manager);
+};
+
+}  // namespace opossum
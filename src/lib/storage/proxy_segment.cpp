@@ -0,0 +1,188 @@
+#include "proxy_segment.hpp"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dictionary_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
+#include "group_key_index.hpp"
+#include "resolve_type.hpp"
+#include "storage_manager.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A serialized dictionary segment consists of
+//   uint32_t row count | uint32_t dictionary size | uint8_t attribute vector width | dictionary | attribute vector
+// Strings in the dictionary are stored as uint32_t length followed by their characters.
+
+template <typename T>
+void write_value(std::vector<char>& bytes, const T& value) {
+  const auto* begin = reinterpret_cast<const char*>(&value);
+  bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+void write_value(std::vector<char>& bytes, const std::string& value) {
+  write_value(bytes, static_cast<uint32_t>(value.size()));
+  bytes.insert(bytes.end(), value.cbegin(), value.cend());
+}
+
+template <typename T>
+T read_value(const char*& position) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto length = read_value<uint32_t>(position);
+    auto value = std::string{position, length};
+    position += length;
+    return value;
+  } else {
+    T value;
+    std::memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+}
+
+template <typename T>
+std::vector<char> serialize(const DictionarySegment<T>& segment) {
+  const auto& dictionary = *segment.dictionary();
+  const auto& attribute_vector = *segment.attribute_vector();
+
+  auto bytes = std::vector<char>{};
+  write_value(bytes, static_cast<uint32_t>(segment.size()));
+  write_value(bytes, static_cast<uint32_t>(dictionary.size()));
+  write_value(bytes, attribute_vector.width());
+
+  for (const auto& value : dictionary) {
+    write_value(bytes, value);
+  }
+
+  for (auto chunk_offset = size_t{0}; chunk_offset < attribute_vector.size(); ++chunk_offset) {
+    const auto value_id = attribute_vector.get(chunk_offset);
+    switch (attribute_vector.width()) {
+      case 1:
+        write_value(bytes, static_cast<uint8_t>(value_id));
+        break;
+      case 2:
+        write_value(bytes, static_cast<uint16_t>(value_id));
+        break;
+      default:
+        write_value(bytes, static_cast<uint32_t>(value_id));
+    }
+  }
+
+  return bytes;
+}
+
+template <typename Uint>
+std::shared_ptr<BaseAttributeVector> read_attribute_vector(const char*& position, const size_t size) {
+  auto value_ids = pmr_vector<Uint>(size);
+  std::memcpy(value_ids.data(), position, size * sizeof(Uint));
+  position += size * sizeof(Uint);
+  return std::make_shared<FixedSizeAttributeVector<Uint>>(std::move(value_ids));
+}
+
+template <typename T>
+std::shared_ptr<BaseSegment> deserialize(const char* position) {
+  const auto size = read_value<uint32_t>(position);
+  const auto dictionary_size = read_value<uint32_t>(position);
+  const auto width = read_value<AttributeVectorWidth>(position);
+
+  auto dictionary = std::make_shared<pmr_vector<T>>();
+  dictionary->reserve(dictionary_size);
+  for (auto value_id = uint32_t{0}; value_id < dictionary_size; ++value_id) {
+    dictionary->emplace_back(read_value<T>(position));
+  }
+
+  auto attribute_vector = std::shared_ptr<BaseAttributeVector>{};
+  switch (width) {
+    case 1:
+      attribute_vector = read_attribute_vector<uint8_t>(position, size);
+      break;
+    case 2:
+      attribute_vector = read_attribute_vector<uint16_t>(position, size);
+      break;
+    default:
+      attribute_vector = read_attribute_vector<uint32_t>(position, size);
+  }
+
+  return std::make_shared<DictionarySegment<T>>(std::move(dictionary), std::move(attribute_vector));
+}
+
+}  // namespace
+
+std::shared_ptr<ProxySegment> ProxySegment::evict(const std::shared_ptr<BaseSegment>& segment,
+                                                  const std::string& column_type,
+                                                  const std::shared_ptr<SpillFile>& spill_file,
+                                                  const bool is_indexed) {
+  Assert(segment->encoding_type() == EncodingType::Dictionary, "Only dictionary segments can be evicted");
+
+  auto bytes = std::vector<char>{};
+  resolve_data_type(column_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    bytes = serialize(static_cast<const DictionarySegment<Type>&>(*segment));
+  });
+
+  const auto region = spill_file->write(bytes);
+  return std::make_shared<ProxySegment>(column_type, segment->size(), spill_file, region, is_indexed);
+}
+
+ProxySegment::ProxySegment(const std::string& column_type, const size_t size,
+                           const std::shared_ptr<SpillFile>& spill_file, const SpillFile::Region region,
+                           const bool is_indexed)
+    : _column_type(column_type), _size(size), _spill_file(spill_file), _region(region), _is_indexed(is_indexed) {}
+
+std::shared_ptr<BaseSegment> ProxySegment::load() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_segment) return _segment;
+
+  const auto mapped_region = _spill_file->map(_region);
+  resolve_data_type(_column_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    _segment = deserialize<Type>(mapped_region.data());
+    if (_is_indexed) {
+      _index = std::make_shared<GroupKeyIndex<Type>>(static_cast<const DictionarySegment<Type>&>(*_segment));
+    }
+  });
+  DebugAssert(_segment && _segment->size() == _size, "Spill file is corrupted");
+  StorageManager::get().notify_memory_growth();
+
+  return _segment;
+}
+
+bool ProxySegment::is_loaded() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return static_cast<bool>(_segment);
+}
+
+std::shared_ptr<BaseIndex> ProxySegment::index() const {
+  if (!_is_indexed) return nullptr;
+  load();
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _index;
+}
+
+void ProxySegment::unload() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _segment = nullptr;
+  _index = nullptr;
+}
+
+AllTypeVariant ProxySegment::operator[](const ChunkOffset chunk_offset) const { return (*load())[chunk_offset]; }
+
+size_t ProxySegment::size() const { return _size; }
+
+size_t ProxySegment::estimate_memory_usage() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return sizeof(ProxySegment) + (_segment ? _segment->estimate_memory_usage() : 0) +
+         (_index ? _index->estimate_memory_usage() : 0);
+}
+
+const std::string& ProxySegment::column_type() const { return _column_type; }
+
+}  // namespace opossum
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "base_index.hpp"
+#include "base_segment.hpp"
+#include "spill_file.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A ProxySegment stands in for a dictionary segment that was evicted to a SpillFile. It only remembers where the
+// serialized segment is located. When the segment is accessed, it is mapped from the file and deserialized again.
+// The deserialized segment stays in memory until the eviction policy calls unload(). If the evicted segment was
+// indexed, the index is rebuilt along with the loaded segment, as it refers to the segment's dictionary.
+//
+// Chunk::get_segment resolves proxies transparently, so operators never see them.
+class ProxySegment : public BaseSegment {
+ public:
+  // writes the given dictionary segment to the spill file and returns a proxy for it
+  static std::shared_ptr<ProxySegment> evict(const std::shared_ptr<BaseSegment>& segment,
+                                             const std::string& column_type,
+                                             const std::shared_ptr<SpillFile>& spill_file,
+                                             const bool is_indexed = false);
+
+  ProxySegment(const std::string& column_type, const size_t size, const std::shared_ptr<SpillFile>& spill_file,
+               const SpillFile::Region region, const bool is_indexed = false);
+
+  // returns the evicted segment, reading it back from the spill file if it is not in memory
+  std::shared_ptr<BaseSegment> load() const;
+
+  // returns whether the evicted segment is currently held in memory
+  bool is_loaded() const;
+
+  // returns the index of the loaded segment, loading it if needed, or nullptr if the evicted segment was not indexed
+  std::shared_ptr<BaseIndex> index() const;
+
+  // drops the in-memory copy of the segment and its index
+  // operators that still hold the segment keep it alive until they release it
+  void unload();
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  void append(const AllTypeVariant&) override { throw std::logic_error("ProxySegment is immutable"); }
+
+  // returns the number of values without loading the segment
+  size_t size() const override;
+
+  // returns the memory used by the proxy and, if loaded, by the segment and its index
+  size_t estimate_memory_usage() const final;
+
+  EncodingType encoding_type() const final { return EncodingType::Proxy; }
+
+  const std::string& column_type() const;
+
+ protected:
+  const std::string _column_type;
+  const size_t _size;
+  const std::shared_ptr<SpillFile> _spill_file;
+  const SpillFile::Region _region;
+  const bool _is_indexed;
+
+  mutable std::mutex _mutex;
+  mutable std::shared_ptr<BaseSegment> _segment;
+  mutable std::shared_ptr<BaseIndex> _index;
+};
+
+}  // namespace opossum
@@ -0,0 +1,115 @@
+#include "reference_segment.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "utils/arena.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
+                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList> pos)
+    : _referenced_table(referenced_table),
+      _referenced_column_id(referenced_column_id),
+      _pos_list(pos),
+      _referenced_layout_version(referenced_table->layout_version()) {}
+
+AllTypeVariant ReferenceSegment::operator[](const ChunkOffset chunk_offset) const {
+  PerformanceWarning("operator[] used");
+  const auto& row_id = _pos_list->at(chunk_offset);
+  if (row_id == NULL_ROW_ID) {
+    auto default_value = AllTypeVariant{};
+    resolve_data_type(_referenced_table->column_type(_referenced_column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      default_value = Type{};
+    });
+    return default_value;
+  }
+
+  const auto segment = referenced_table()->get_chunk(row_id.chunk_id).get_segment(_referenced_column_id);
+  return (*segment)[row_id.chunk_offset];
+}
+
+size_t ReferenceSegment::size() const { return _pos_list->size(); }
+
+const std::shared_ptr<const PosList> ReferenceSegment::pos_list() const { return _pos_list; }
+
+const std::shared_ptr<const Table> ReferenceSegment::referenced_table() const {
+  Assert(_referenced_table->layout_version() == _referenced_layout_version,
+         "The referenced table was compacted, so that the positions refer to other rows");
+  return _referenced_table;
+}
+
+ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
+
+size_t ReferenceSegment::estimate_memory_usage() const { return sizeof(RowID) * _pos_list->size(); }
+
+void append_reference_segments(Chunk& output_chunk, const std::shared_ptr<const Table>& input_table,
+                               const std::shared_ptr<const PosList>& pos_list,
+                               const std::shared_ptr<MemoryResource>& memory_resource) {
+  const auto& first_chunk = input_table->get_chunk(ChunkID{0});
+  const auto is_reference_table = first_chunk.column_count() > 0 &&
+                                  first_chunk.get_segment(ColumnID{0})->encoding_type() == EncodingType::Reference;
+  if (!is_reference_table) {
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      output_chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id, pos_list));
+    }
+    return;
+  }
+
+  // Columns of the input that share their PosLists in all chunks, e.g., all columns that come from the same table,
+  // also share the resolved PosList in the output.
+  auto resolved_pos_lists = std::map<std::vector<const PosList*>, std::shared_ptr<const PosList>>{};
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    auto input_pos_lists = std::vector<const PosList*>(input_table->chunk_count());
+    auto referenced_segment = std::shared_ptr<const ReferenceSegment>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+      const auto& chunk = input_table->get_chunk(chunk_id);
+      if (chunk.column_count() == 0) continue;
+      referenced_segment = std::static_pointer_cast<const ReferenceSegment>(chunk.get_segment(column_id));
+      input_pos_lists[chunk_id] = referenced_segment->pos_list().get();
+    }
+
+    auto& resolved_pos_list = resolved_pos_lists[input_pos_lists];
+    if (!resolved_pos_list) {
+      auto new_pos_list = make_pos_list(memory_resource);
+      new_pos_list->reserve(pos_list->size());
+      for (const auto& row_id : *pos_list) {
+        if (row_id == NULL_ROW_ID) {
+          new_pos_list->emplace_back(NULL_ROW_ID);
+        } else {
+          new_pos_list->emplace_back((*input_pos_lists[row_id.chunk_id])[row_id.chunk_offset]);
+        }
+      }
+      resolved_pos_list = std::move(new_pos_list);
+    }
+
+    output_chunk.add_segment(std::make_shared<ReferenceSegment>(
+        referenced_segment->referenced_table(), referenced_segment->referenced_column_id(), resolved_pos_list));
+  }
+}
+
+std::shared_ptr<PosList> first_rows_pos_list(const Table& table, const size_t row_count,
+                                             const std::shared_ptr<MemoryResource>& memory_resource) {
+  auto pos_list = make_pos_list(memory_resource);
+  pos_list->reserve(std::min(row_count, static_cast<size_t>(table.row_count())));
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count() && pos_list->size() < row_count; ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    if (chunk.size() == 0) continue;
+
+    const auto is_reference_chunk = chunk.get_segment(ColumnID{0})->encoding_type() == EncodingType::Reference;
+    const auto invalidation_bitmap = is_reference_chunk ? nullptr : chunk.invalidation_bitmap();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size() && pos_list->size() < row_count;
+         ++chunk_offset) {
+      if (!is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) continue;
+      pos_list->emplace_back(RowID{chunk_id, chunk_offset});
+    }
+  }
+  return pos_list;
+}
+
+}  // namespace opossum
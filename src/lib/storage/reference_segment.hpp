@@ -31,11 +31,35 @@ class ReferenceSegment : public BaseSegment {
   size_t size() const override;
 
   const std::shared_ptr<const PosList> pos_list() const;
+
+  // Returns the referenced table. Throws if the table was compacted since the segment was created, as the positions
+  // refer to other rows then (see Table::layout_version).
   const std::shared_ptr<const Table> referenced_table() const;
 
   ColumnID referenced_column_id() const;
 
   size_t estimate_memory_usage() const final;
+
+  EncodingType encoding_type() const final { return EncodingType::Reference; }
+
+ protected:
+  const std::shared_ptr<const Table> _referenced_table;
+  const ColumnID _referenced_column_id;
+  const std::shared_ptr<const PosList> _pos_list;
+  const uint64_t _referenced_layout_version;
 };
 
+// Adds reference segments for all columns of the input table to the chunk, referencing the rows at the given positions
+// of the input. If the input references other tables, the positions are resolved to RowIDs of those tables, so that a
+// reference segment never references another reference segment. Resolved PosLists are allocated from the given memory
+// resource and shared by the columns that come from the same table.
+void append_reference_segments(Chunk& output_chunk, const std::shared_ptr<const Table>& input_table,
+                               const std::shared_ptr<const PosList>& pos_list,
+                               const std::shared_ptr<MemoryResource>& memory_resource);
+
+// Returns the positions of the first row_count rows of the table, or of all rows if it has fewer. Deleted rows of data
+// chunks are skipped. The PosList is allocated from the given memory resource.
+std::shared_ptr<PosList> first_rows_pos_list(const Table& table, const size_t row_count,
+                                             const std::shared_ptr<MemoryResource>& memory_resource);
+
 }  // namespace opossum
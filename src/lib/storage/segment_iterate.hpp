@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+
+#include "dictionary_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
+#include "reference_segment.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+// Returns the value at the given position of a value, dictionary, or reference segment of type T. Reading a reference
+// segment looks up the referenced segment, so that segment_iterate should be preferred for reading many values. NULL
+// rows yield the default value of T.
+template <typename T>
+T get_segment_value(const BaseSegment& segment, const ChunkOffset chunk_offset) {
+  if (segment.encoding_type() == EncodingType::Unencoded) {
+    return static_cast<const ValueSegment<T>&>(segment).values()[chunk_offset];
+  }
+  if (segment.encoding_type() == EncodingType::Reference) {
+    const auto& reference_segment = static_cast<const ReferenceSegment&>(segment);
+    const auto& row_id = (*reference_segment.pos_list())[chunk_offset];
+    if (row_id == NULL_ROW_ID) return T{};
+    const auto& referenced_chunk = reference_segment.referenced_table()->get_chunk(row_id.chunk_id);
+    return get_segment_value<T>(*referenced_chunk.get_segment(reference_segment.referenced_column_id()),
+                                row_id.chunk_offset);
+  }
+  DebugAssert(segment.encoding_type() == EncodingType::Dictionary, "Expected a value or dictionary segment");
+  return static_cast<const DictionarySegment<T>&>(segment).get(chunk_offset);
+}
+
+/**
+ * Calls functor(chunk_offset, value) for every value of a segment of type T, in order. The encoding of the segment is
+ * resolved once, so that the loop does not need a virtual call per value for value and dictionary segments. For
+ * reference segments, the referenced segment is only looked up when the referenced chunk changes. NULL_ROW_IDs are
+ * passed on as the default value of T.
+ *
+ * This is the preferred way for operators to read all values of a segment, e.g., to compact, join, or aggregate it.
+ */
+template <typename T, typename Functor>
+void segment_iterate(const BaseSegment& segment, const Functor& functor) {
+  switch (segment.encoding_type()) {
+    case EncodingType::Unencoded: {
+      const auto& values = static_cast<const ValueSegment<T>&>(segment).values();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+        functor(chunk_offset, values[chunk_offset]);
+      }
+      break;
+    }
+    case EncodingType::Dictionary: {
+      const auto& dictionary_segment = static_cast<const DictionarySegment<T>&>(segment);
+      const auto& dictionary = *dictionary_segment.dictionary();
+      resolve_attribute_vector(*dictionary_segment.attribute_vector(), [&](const auto& value_ids) {
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_ids.size(); ++chunk_offset) {
+          functor(chunk_offset, dictionary[value_ids[chunk_offset]]);
+        }
+      });
+      break;
+    }
+    case EncodingType::Reference: {
+      const auto& reference_segment = static_cast<const ReferenceSegment&>(segment);
+      const auto& pos_list = *reference_segment.pos_list();
+      const auto& referenced_table = *reference_segment.referenced_table();
+
+      auto referenced_chunk_id = ChunkID{0};
+      auto referenced_segment = std::shared_ptr<BaseSegment>{};
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < pos_list.size(); ++chunk_offset) {
+        const auto& row_id = pos_list[chunk_offset];
+        if (row_id == NULL_ROW_ID) {
+          functor(chunk_offset, T{});
+          continue;
+        }
+        if (!referenced_segment || row_id.chunk_id != referenced_chunk_id) {
+          referenced_chunk_id = row_id.chunk_id;
+          referenced_segment =
+              referenced_table.get_chunk(referenced_chunk_id).get_segment(reference_segment.referenced_column_id());
+          DebugAssert(referenced_segment->encoding_type() != EncodingType::Reference,
+                      "Reference segments must not reference other reference segments");
+        }
+        functor(chunk_offset, get_segment_value<T>(*referenced_segment, row_id.chunk_offset));
+      }
+      break;
+    }
+    default:
+      Fail("Segments of this encoding cannot be iterated");
+  }
+}
+
+}  // namespace opossum
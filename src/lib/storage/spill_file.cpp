@@ -0,0 +1,70 @@
+#include "spill_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+SpillFile::MappedRegion::MappedRegion(int file_descriptor, const Region& region) : _length(region.length) {
+  // mmap requires the file offset to be a multiple of the page size
+  static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const auto aligned_offset = region.offset - region.offset % page_size;
+  _offset_in_mapping = region.offset - aligned_offset;
+  _mapping_length = _offset_in_mapping + region.length;
+
+  _mapping =
+      mmap(nullptr, _mapping_length, PROT_READ, MAP_PRIVATE, file_descriptor, static_cast<off_t>(aligned_offset));
+  Assert(_mapping != MAP_FAILED, std::string{"Could not map spill file: "} + std::strerror(errno));
+}
+
+SpillFile::MappedRegion::~MappedRegion() { munmap(_mapping, _mapping_length); }
+
+const char* SpillFile::MappedRegion::data() const { return static_cast<const char*>(_mapping) + _offset_in_mapping; }
+
+size_t SpillFile::MappedRegion::size() const { return _length; }
+
+SpillFile::SpillFile(const std::string& path) : _path(path) {
+  _file_descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  Assert(_file_descriptor != -1, "Could not open spill file " + path + ": " + std::strerror(errno));
+}
+
+SpillFile::~SpillFile() {
+  close(_file_descriptor);
+  unlink(_path.c_str());
+}
+
+SpillFile::Region SpillFile::write(const std::vector<char>& bytes) {
+  std::lock_guard<std::mutex> lock(_write_mutex);
+
+  const auto region = Region{_size, bytes.size()};
+  auto bytes_written = size_t{0};
+  while (bytes_written < bytes.size()) {
+    const auto result = pwrite(_file_descriptor, bytes.data() + bytes_written, bytes.size() - bytes_written,
+                               static_cast<off_t>(region.offset + bytes_written));
+    Assert(result > 0, "Could not write to spill file " + _path + ": " + std::strerror(errno));
+    bytes_written += static_cast<size_t>(result);
+  }
+
+  _size += bytes.size();
+  return region;
+}
+
+SpillFile::MappedRegion SpillFile::map(const Region& region) const {
+  DebugAssert(region.offset + region.length <= _size, "Region lies outside of the spill file");
+  return MappedRegion{_file_descriptor, region};
+}
+
+const std::string& SpillFile::path() const { return _path; }
+
+size_t SpillFile::size() const { return _size; }
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A SpillFile is an append-only local file that holds the serialized segments of evicted chunks.
+// Regions that were written once are never modified, so they can be read concurrently. The file is removed when the
+// SpillFile is destroyed, i.e., when the last ProxySegment referencing it is gone.
+class SpillFile : private Noncopyable {
+ public:
+  // location of a serialized segment within the file
+  struct Region {
+    size_t offset;
+    size_t length;
+  };
+
+  // A read-only memory mapping of a region. The mapping is released when the view is destroyed.
+  class MappedRegion : private Noncopyable {
+   public:
+    MappedRegion(int file_descriptor, const Region& region);
+    ~MappedRegion();
+
+    const char* data() const;
+    size_t size() const;
+
+   protected:
+    void* _mapping;
+    size_t _mapping_length;
+    size_t _offset_in_mapping;
+    size_t _length;
+  };
+
+  // creates (or truncates) the file at the given path
+  explicit SpillFile(const std::string& path);
+  ~SpillFile();
+
+  // appends the given bytes to the file and returns where they were written
+  Region write(const std::vector<char>& bytes);
+
+  // maps a previously written region into memory
+  MappedRegion map(const Region& region) const;
+
+  const std::string& path() const;
+
+  // returns the number of bytes written so far
+  size_t size() const;
+
+ protected:
+  const std::string _path;
+  int _file_descriptor;
+  std::atomic<size_t> _size{0};
+  std::mutex _write_mutex;
+};
+
+}  // namespace opossum
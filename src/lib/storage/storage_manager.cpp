@@ -1,11 +1,23 @@
 #include "storage_manager.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "base_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "meta_tables.hpp"
+#include "operators/result_cache.hpp"
+#include "proxy_segment.hpp"
+#include "resolve_type.hpp"
+#include "spill_file.hpp"
 #include "utils/assert.hpp"
+#include "utils/huge_page_memory_resource.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
@@ -15,45 +27,257 @@ StorageManager& StorageManager::get() {
 }
 
 void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) {
-  if (!this->has_table(name)) {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+    if (tables.count(name) || MetaTables::is_meta_table(name)) {
+      throw std::runtime_error(std::string("Table already exists: " + name));
+    }
     tables[name] = table;
-  } else {
-    throw std::runtime_error(std::string("Table already exists: " + name));
   }
+  enforce_memory_budget();
 }
 
 void StorageManager::drop_table(const std::string& name) {
-  this->get_table(name);
-  tables.erase(name);
+  Assert(!MetaTables::is_meta_table(name), "Cannot drop meta table: " + name);
+  {
+    const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+    if (!tables.erase(name)) throw std::runtime_error(std::string("Cannot find following table: " + name));
+  }
+  ResultCache::get().invalidate(name);
 }
 
 std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
-  auto it = tables.find(name);
-  if (it != tables.end()) {
-    return it->second;
+  {
+    const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+    auto it = tables.find(name);
+    if (it != tables.end()) {
+      return it->second;
+    }
   }
+  // meta tables are generated without the lock, as they list the stored tables
+  if (MetaTables::is_meta_table(name)) return MetaTables::generate(name, *this);
 
   throw std::runtime_error(std::string("Cannot find following table: " + name));
 }
 
 bool StorageManager::has_table(const std::string& name) const {
-  auto it = tables.find(name);
-  if (it != tables.end()) {
-    return true;
+  {
+    const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+    if (tables.count(name)) return true;
   }
-  return false;
+  return MetaTables::is_meta_table(name);
 }
 
 std::vector<std::string> StorageManager::table_names() const {
-  throw std::runtime_error("Implement StorageManager::table_names");
+  const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+  auto table_names = std::vector<std::string>{};
+  table_names.reserve(tables.size());
+  for (const auto& [table_name, table] : tables) {
+    table_names.emplace_back(table_name);
+  }
+  return table_names;
+}
+
+std::map<std::string, std::shared_ptr<Table>> StorageManager::stored_tables() const {
+  const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+  return tables;
 }
 
 void StorageManager::print(std::ostream& out) const {
-  for (auto table : tables) {
-    out << table.first << std::endl;
+  for (const auto& [table_name, table] : stored_tables()) {
+    out << table_name << ": " << table->column_count() << " columns, " << table->row_count() << " rows, "
+        << table->chunk_count() << " chunks, " << table->estimate_memory_usage() << " bytes" << std::endl;
+  }
+}
+
+void StorageManager::reset() {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_tables_mutex};
+    tables.clear();
+  }
+  ResultCache::get().clear();
+  _memory_budget.reset();
+  _memory_budget_status = {};
+  _memory_grew = false;
+  _enforced_table_versions.clear();
+  ResultCache::get().set_storage_headroom(std::nullopt);
+  _spill_file = nullptr;
+  _clock_hand = {};
+}
+
+// returns whether the values of a segment, i.e., the values of a ValueSegment or the attribute vector or dictionary
+// of a DictionarySegment, are stored on huge pages
+static bool is_huge_page_backed(const BaseSegment& segment, const std::string& column_type) {
+  const auto& huge_page_memory_resource = HugePageMemoryResource::get();
+  auto huge_page_backed = false;
+  resolve_data_type(column_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    if (segment.encoding_type() == EncodingType::Unencoded) {
+      const auto& values = static_cast<const ValueSegment<Type>&>(segment).values();
+      huge_page_backed = huge_page_memory_resource.is_huge_page_backed(values.data());
+    } else if (segment.encoding_type() == EncodingType::Dictionary) {
+      const auto& dictionary_segment = static_cast<const DictionarySegment<Type>&>(segment);
+      const auto* const value_ids = dictionary_segment.attribute_vector()->data();
+      huge_page_backed = huge_page_memory_resource.is_huge_page_backed(value_ids) ||
+                         huge_page_memory_resource.is_huge_page_backed(dictionary_segment.dictionary()->data());
+    }
+  });
+  return huge_page_backed;
+}
+
+MemoryReport StorageManager::memory_report() const {
+  auto report = MemoryReport{};
+  for (const auto& [table_name, table] : stored_tables()) {
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+        const auto segment = chunk.get_stored_segment(column_id);
+        report.add_segment({table_name, chunk_id, column_id, table->column_name(column_id), segment->encoding_type(),
+                            segment->estimate_memory_usage(),
+                            is_huge_page_backed(*segment, table->column_type(column_id))});
+      }
+    }
+  }
+  return report;
+}
+
+void StorageManager::set_memory_budget(size_t bytes) {
+  _memory_budget = bytes;
+  enforce_memory_budget();
+}
+
+std::optional<size_t> StorageManager::memory_budget() const { return _memory_budget; }
+
+MemoryBudgetStatus StorageManager::memory_budget_status() const {
+  const auto lock = std::lock_guard<std::mutex>{_memory_budget_mutex};
+  return _memory_budget_status;
+}
+
+void StorageManager::enable_tiering(const std::string& spill_file_path) {
+  _spill_file = std::make_shared<SpillFile>(spill_file_path);
+  enforce_memory_budget();
+}
+
+bool StorageManager::enforce_memory_budget() {
+  const auto lock = std::lock_guard<std::mutex>{_memory_budget_mutex};
+  // growth and modifications from now on are enforced the next time
+  _memory_grew = false;
+  _enforced_table_versions = _table_versions();
+  if (!_memory_budget) {
+    _memory_budget_status = {};
+    ResultCache::get().set_storage_headroom(std::nullopt);
+    return true;
+  }
+
+  auto memory_usage = size_t{0};
+  const auto fits = _fit_tables_into_budget(memory_usage);
+  _memory_budget_status = MemoryBudgetStatus{memory_usage, !fits};
+  // the ResultCache gets the memory that the tables leave free
+  ResultCache::get().set_storage_headroom(fits ? *_memory_budget - memory_usage : 0);
+  return fits;
+}
+
+void StorageManager::notify_memory_growth() { _memory_grew = true; }
+
+void StorageManager::enforce_pending_memory_budget() {
+  auto lock = std::unique_lock<std::mutex>{_memory_budget_mutex};
+  if (!_memory_grew && _table_versions() == _enforced_table_versions) return;
+  lock.unlock();
+  enforce_memory_budget();
+}
+
+std::map<std::string, uint64_t> StorageManager::_table_versions() const {
+  auto table_versions = std::map<std::string, uint64_t>{};
+  for (const auto& [table_name, table] : stored_tables()) {
+    table_versions.emplace(table_name, table->version());
+  }
+  return table_versions;
+}
+
+bool StorageManager::_fit_tables_into_budget(size_t& memory_usage) {
+  const auto stored = stored_tables();
+  for (const auto& [table_name, table] : stored) {
+    memory_usage += table->estimate_memory_usage();
+  }
+  if (memory_usage <= *_memory_budget) return true;
+
+  // Only full chunks are compressed because dictionary segments are immutable and the table would otherwise fail to
+  // append to its last chunk. Compressing the largest chunks first frees the most memory with the fewest compressions.
+  auto candidates = std::vector<std::tuple<size_t, std::shared_ptr<Table>, ChunkID>>{};
+  for (const auto& [table_name, table] : stored) {
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      if (chunk.size() == 0 || chunk.size() < table->max_chunk_size()) continue;
+
+      auto is_unencoded = true;
+      for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+        is_unencoded &= chunk.get_stored_segment(column_id)->encoding_type() == EncodingType::Unencoded;
+      }
+      if (is_unencoded) candidates.emplace_back(chunk.estimate_memory_usage(), table, chunk_id);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) > std::get<0>(rhs); });
+
+  for (const auto& [chunk_memory_usage, table, chunk_id] : candidates) {
+    table->compress_chunk(chunk_id);
+    memory_usage = memory_usage - chunk_memory_usage + table->get_chunk(chunk_id).estimate_memory_usage();
+    if (memory_usage <= *_memory_budget) return true;
   }
+
+  return _spill_file && _evict_cold_chunks(memory_usage);
 }
 
-void StorageManager::reset() { tables.clear(); }
+bool StorageManager::_evict_cold_chunks(size_t& memory_usage) {
+  // the clock hand sweeps over all chunks in the order of table names and chunk ids
+  const auto stored = stored_tables();
+  auto clock = std::vector<std::pair<std::string, ChunkID>>{};
+  for (const auto& [table_name, table] : stored) {
+    for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      clock.emplace_back(table_name, chunk_id);
+    }
+  }
+  if (clock.empty()) return false;
+
+  const auto start = static_cast<size_t>(std::lower_bound(clock.cbegin(), clock.cend(), _clock_hand) - clock.cbegin());
+
+  // In the first round, the reference bits of recently accessed chunks are cleared. These chunks are evicted in the
+  // second round if needed.
+  for (auto step = size_t{0}; step < 2 * clock.size(); ++step) {
+    const auto& [table_name, chunk_id] = clock[(start + step) % clock.size()];
+    const auto& table = stored.at(table_name);
+    auto& chunk = table->get_chunk(chunk_id);
+
+    // Only encoded chunks are evicted. Chunks whose segments are all on disk already do not free anything.
+    auto is_evictable = chunk.size() > 0;
+    auto frees_memory = false;
+    for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+      const auto segment = chunk.get_stored_segment(column_id);
+      if (segment->encoding_type() == EncodingType::Dictionary) {
+        frees_memory = true;
+      } else if (segment->encoding_type() == EncodingType::Proxy) {
+        frees_memory |= static_cast<const ProxySegment&>(*segment).is_loaded();
+      } else {
+        is_evictable = false;
+      }
+    }
+    if (!is_evictable || !frees_memory) continue;
+
+    // second chance for chunks that were accessed since the clock hand last passed them
+    if (chunk.reset_access_flag()) continue;
+
+    const auto chunk_memory_usage = chunk.estimate_memory_usage();
+    table->evict_chunk(chunk_id, _spill_file);
+    memory_usage = memory_usage - chunk_memory_usage + chunk.estimate_memory_usage();
+
+    if (memory_usage <= *_memory_budget) {
+      _clock_hand = clock[(start + step + 1) % clock.size()];
+      return true;
+    }
+  }
+
+  _clock_hand = clock[start];
+  return false;
+}
 
 }  // namespace opossum
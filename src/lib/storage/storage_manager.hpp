@@ -1,50 +1,122 @@
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "storage/memory_report.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
 namespace opossum {
 
+class SpillFile;
+
+// the outcome of the last enforcement of the memory budget
+struct MemoryBudgetStatus {
+  // the memory used by all tables once chunks were compressed and evicted
+  size_t memory_usage = 0;
+  // whether the tables still did not fit into the budget
+  bool exceeded = false;
+};
+
 // The StorageManager is a singleton that maintains all tables
 // by mapping table names to table instances.
+// Besides the stored tables, it provides meta tables such as meta_segments, which are generated whenever they are
+// requested (see MetaTables).
 class StorageManager : private Noncopyable {
  public:
   static StorageManager& get();
 
-  // adds a table to the storage manager
+  // adds a table to the storage manager, whose name must not be taken by a stored or a meta table
   void add_table(const std::string& name, std::shared_ptr<Table> table);
 
-  // removes the table from the storage manger
+  // removes the table from the storage manger and the results computed from it from the ResultCache
   void drop_table(const std::string& name);
 
-  // returns the table instance with the given name
+  // returns the table instance with the given name, or a newly generated meta table
   std::shared_ptr<Table> get_table(const std::string& name) const;
 
-  // returns whether the storage manager holds a table with the given name
+  // returns whether the storage manager holds a table or provides a meta table with the given name
   bool has_table(const std::string& name) const;
 
-  // returns a list of all table names
+  // returns a list of all names of stored tables, i.e., without meta tables
   std::vector<std::string> table_names() const;
 
-  // prints information about all tables in the storage manager (name, #columns, #rows, #chunks)
+  // Returns the stored tables by name, i.e., without meta tables. Unlike table_names followed by get_table, this does
+  // not fail if a table is dropped concurrently, e.g., by another thread while BackgroundCompaction iterates them.
+  std::map<std::string, std::shared_ptr<Table>> stored_tables() const;
+
+  // Prints one line per stored table with its name, #columns, #rows, #chunks, and memory usage in bytes, i.e., the
+  // summary of meta_tables.
   void print(std::ostream& out = std::cout) const;
 
   // deletes the entire StorageManager and creates a new one, used especially in tests
   void reset();
 
+  // returns the memory used by all tables, broken down by table, chunk, column, and encoding
+  MemoryReport memory_report() const;
+
+  // Sets the number of bytes that all tables together should not exceed. Whenever a table is added, a plan modified or
+  // grew the tables (see enforce_pending_memory_budget), or the budget is enforced explicitly, full chunks that are not
+  // encoded yet are compressed, largest first, until the tables fit into the budget again. If tiering is enabled, cold
+  // compressed chunks are evicted next. Whether the tables still do not fit is reported by memory_budget_status. The
+  // ResultCache only uses the memory that the tables leave free.
+  void set_memory_budget(size_t bytes);
+  std::optional<size_t> memory_budget() const;
+  MemoryBudgetStatus memory_budget_status() const;
+
+  // Enables tiered storage. Cold dictionary-encoded chunks are then written to the given file and replaced by
+  // ProxySegments, which read them back on access. Chunks are chosen with the CLOCK policy, where the access flag of
+  // a chunk serves as its reference bit: a chunk that was accessed since the clock hand last passed it gets a second
+  // chance.
+  void enable_tiering(const std::string& spill_file_path);
+
+  // tries to bring the memory usage below the budget and returns whether this succeeded
+  bool enforce_memory_budget();
+
+  // Notes that an evicted segment was loaded, which happens while operators read the tables. Their chunks cannot be
+  // replaced until the plan is done, so the budget is only enforced by enforce_pending_memory_budget.
+  void notify_memory_growth();
+
+  // Enforces the budget if an evicted segment was loaded or a stored table was added, dropped, or modified, e.g., a
+  // chunk became full, since the budget was last enforced. Called by the operator that executes a plan once it is done.
+  void enforce_pending_memory_budget();
+
   StorageManager(StorageManager&&) = delete;
 
  protected:
   StorageManager() {}
   StorageManager& operator=(StorageManager&&) = default;
 
+  // compresses and evicts chunks until the tables fit into the budget, returns whether they do and their memory usage
+  bool _fit_tables_into_budget(size_t& memory_usage);
+
+  // evicts chunks with the CLOCK policy until the memory usage fits into the budget, returns whether it does
+  bool _evict_cold_chunks(size_t& memory_usage);
+
+  // returns the versions of the stored tables by name (see Table::version)
+  std::map<std::string, uint64_t> _table_versions() const;
+
+  // guarded by _tables_mutex, which is not held while the tables themselves are read or modified
   std::map<std::string, std::shared_ptr<Table>> tables;
-  // Implementation goes here
+  mutable std::mutex _tables_mutex;
+  std::optional<size_t> _memory_budget;
+  MemoryBudgetStatus _memory_budget_status;
+  std::atomic<bool> _memory_grew{false};
+  // the versions of the stored tables when the budget was last enforced
+  std::map<std::string, uint64_t> _enforced_table_versions;
+  // held while the budget is enforced, which operators on several threads may do at the same time
+  mutable std::mutex _memory_budget_mutex;
+
+  std::shared_ptr<SpillFile> _spill_file;
+  // the chunk at which the next sweep of the clock hand starts
+  std::pair<std::string, ChunkID> _clock_hand;
 };
 }  // namespace opossum
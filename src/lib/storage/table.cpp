@@ -1,6 +1,7 @@
 #include "table.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <future>
 #include <iomanip>
 #include <limits>
@@ -14,31 +15,69 @@
 #include "value_segment.hpp"
 
 #include "dictionary_segment.hpp"
+#include "group_key_index.hpp"
+#include "proxy_segment.hpp"
 #include "resolve_type.hpp"
+#include "segment_iterate.hpp"
 #include "types.hpp"
+#include "utils/arena.hpp"
 #include "utils/assert.hpp"
+#include "utils/huge_page_memory_resource.hpp"
+#include "utils/tracer.hpp"
 
 namespace opossum {
 
 struct SegmentCompressionTask {
   std::shared_ptr<BaseSegment> old_segment;
   std::string column_type;
+  std::shared_ptr<MemoryResource> memory_resource;
 
-  SegmentCompressionTask(std::shared_ptr<BaseSegment> old_segment, std::string column_type) {
+  SegmentCompressionTask(std::shared_ptr<BaseSegment> old_segment, std::string column_type,
+                         std::shared_ptr<MemoryResource> memory_resource) {
     this->old_segment = old_segment;
     this->column_type = column_type;
+    this->memory_resource = memory_resource;
   }
 };
 
 static std::shared_ptr<BaseSegment> compress_segment(SegmentCompressionTask compression_task) {
-  auto pSegment = make_shared_by_data_type<BaseSegment, DictionarySegment>(compression_task.column_type,
-                                                                           compression_task.old_segment);
-  return pSegment;
+  const auto trace_scope = TraceScope{"compression", "compress segment"};
+  auto pSegment = make_shared_by_data_type<BaseSegment, DictionarySegment>(
+      compression_task.column_type, compression_task.old_segment,
+      PolymorphicAllocator<size_t>{compression_task.memory_resource.get()});
+  return keep_memory_resource_alive(std::move(pSegment), compression_task.memory_resource);
 };
 
+// creates an empty value segment that is allocated from the chunk's arena
+static std::shared_ptr<BaseSegment> make_value_segment(const std::string& type, const Chunk& chunk) {
+  auto segment = make_shared_by_data_type<BaseSegment, ValueSegment>(type, chunk.get_allocator());
+  return keep_memory_resource_alive(std::move(segment), chunk.memory_resource());
+}
+
+static std::atomic<bool> use_huge_pages_by_default{false};
+
+// the version that the next modified table gets, shared by all tables so that versions are unique
+static std::atomic<uint64_t> next_version{1};
+
 Table::Table(uint32_t chunk_size) {
-  this->chunk_size = chunk_size;
+  this->chunk_size = chunk_size != 0 ? chunk_size : std::numeric_limits<ChunkOffset>::max() - 1;
   this->build_chunk();
+  mark_modified();
+}
+
+Table::Table(Table&& other) { *this = std::move(other); }
+
+Table& Table::operator=(Table&& other) {
+  DebugAssert(_read_lock_count == 0 && other._read_lock_count == 0, "Tables must not be moved while they are read");
+  chunk_size = other.chunk_size;
+  _chunks = std::move(other._chunks);
+  col_names = std::move(other.col_names);
+  col_types = std::move(other.col_types);
+  _use_huge_pages = other._use_huge_pages;
+  _indexed_column_ids = std::move(other._indexed_column_ids);
+  _version = other._version.load();
+  _layout_version = other._layout_version.load();
+  return *this;
 }
 
 void Table::add_column(const std::string& name, const std::string& type) {
@@ -47,8 +86,9 @@ void Table::add_column(const std::string& name, const std::string& type) {
   col_names.push_back(name);
   col_types.push_back(type);
 
-  auto segment = make_shared_by_data_type<BaseSegment, ValueSegment>(type);
+  auto segment = make_value_segment(type, _chunks.back());
   _chunks.back().add_segment(segment);
+  mark_modified();
 }
 
 void Table::
@@ -56,29 +96,63 @@ void Table::
     // My IDE wrongly notifies me that I do not use this function
     build_chunk() {
   // Create Chunk
-  _chunks.push_back(Chunk());
+  _chunks.push_back(_make_chunk());
 
   // Create segments for new chunk
   for (uint32_t index = 0; index < col_types.size(); ++index) {  // TODO(all): Wat is the MAX for col_types?
-    auto segment = make_shared_by_data_type<BaseSegment, ValueSegment>(col_types[index]);
+    auto segment = make_value_segment(col_types[index], _chunks.back());
     _chunks.back().add_segment(segment);
   }
 }
 
+void Table::add_column_definition(const std::string& name, const std::string& type) {
+  col_names.push_back(name);
+  col_types.push_back(type);
+  mark_modified();
+}
+
+void Table::create_new_chunk() {
+  build_chunk();
+  mark_modified();
+}
+
+void Table::emplace_chunk(Chunk chunk) {
+  DebugAssert(chunk.column_count() == column_count(), "Chunk does not match the table's columns");
+  if (_chunks.size() == 1 && _chunks.back().size() == 0) {
+    _chunks.back() = std::move(chunk);
+  } else {
+    _chunks.emplace_back(std::move(chunk));
+  }
+  mark_modified();
+}
+
 void Table::append(std::vector<AllTypeVariant> values) {
   // if last chunk is full create a new chunk and add it to back
   if (_chunks.back().size() >= chunk_size) {
     this->build_chunk();
   }
   _chunks.back().append(values);
+  mark_modified();
 }
 
-uint16_t Table::column_count() const {
-  return _chunks.back()
-      .column_count();  // I assume here that all chunks have the same count of columns. Last chunk -> most recent data
+uint16_t Table::column_count() const { return static_cast<uint16_t>(col_names.size()); }
+
+uint64_t Table::row_count() const {
+  // chunks other than the last one are not necessarily full, e.g., after compaction or in the output of operators
+  auto row_count = uint64_t{0};
+  for (const auto& chunk : _chunks) {
+    row_count += chunk.size();
+  }
+  return row_count;
 }
 
-uint64_t Table::row_count() const { return chunk_size * (chunk_count() - 1) + _chunks.back().size(); }
+uint64_t Table::approx_valid_row_count() const {
+  auto valid_row_count = uint64_t{0};
+  for (const auto& chunk : _chunks) {
+    valid_row_count += chunk.size() - chunk.invalid_row_count();
+  }
+  return valid_row_count;
+}
 
 ChunkID Table::chunk_count() const { return ChunkID{static_cast<uint32_t>(_chunks.size())}; }
 
@@ -106,13 +180,14 @@ Chunk& Table::get_chunk(ChunkID chunk_id) { return _chunks.at(chunk_id); }
 const Chunk& Table::get_chunk(ChunkID chunk_id) const { return _chunks.at(chunk_id); }
 
 void Table::compress_chunk(ChunkID chunk_id) {
-  Chunk dict_chunk = Chunk();
+  const auto trace_scope = TraceScope{"compression", [&] { return "compress chunk " + std::to_string(chunk_id); }};
+  Chunk dict_chunk = _make_chunk();
   Chunk& old_chunk = get_chunk(chunk_id);
 
   std::vector<std::future<std::shared_ptr<BaseSegment>>> futures;
   for (ColumnID i = static_cast<ColumnID>(0); i < old_chunk.column_count(); ++i) {
     const auto old_segment = old_chunk.get_segment(i);
-    const auto compression_task = SegmentCompressionTask(old_segment, column_type(i));
+    const auto compression_task = SegmentCompressionTask(old_segment, column_type(i), dict_chunk.memory_resource());
 
     futures.emplace_back(std::async(compress_segment, compression_task));
   }
@@ -122,7 +197,163 @@ void Table::compress_chunk(ChunkID chunk_id) {
     dict_chunk.add_segment(future.get());
   }
 
+  _index_chunk(dict_chunk);
+
   // Replace Chunk
+  _begin_replacement();
   _chunks[chunk_id] = std::move(dict_chunk);
+  mark_modified();
+  _end_replacement();
+}
+
+void Table::compact_chunk(ChunkID chunk_id) {
+  const auto trace_scope = TraceScope{"compression", [&] { return "compact chunk " + std::to_string(chunk_id); }};
+  // Rows that are deleted while the chunk is rewritten must not be lost. Deletes are operators, which hold a read lock
+  // on the table. Thus, once no read lock is held, we start over if the invalidation bitmap changed in the meantime.
+  auto invalidation_bitmap = std::shared_ptr<const std::vector<uint64_t>>{};
+  auto compacted_chunk = Chunk{};
+  while (true) {
+    const auto& old_chunk = get_chunk(chunk_id);
+    invalidation_bitmap = old_chunk.invalidation_bitmap();
+
+    compacted_chunk = _make_chunk();
+    for (auto column_id = ColumnID{0}; column_id < old_chunk.column_count(); ++column_id) {
+      resolve_data_type(column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+
+        auto values = pmr_vector<Type>{};
+        values.reserve(old_chunk.size() - old_chunk.invalid_row_count());
+        const auto old_segment = old_chunk.get_segment(column_id);
+        segment_iterate<Type>(*old_segment, [&](const ChunkOffset chunk_offset, const Type& value) {
+          if (is_valid_in_bitmap(invalidation_bitmap.get(), chunk_offset)) values.push_back(value);
+        });
+
+        const auto value_segment = std::make_shared<ValueSegment<Type>>(std::move(values));
+        compacted_chunk.add_segment(compress_segment(
+            SegmentCompressionTask(value_segment, column_type(column_id), compacted_chunk.memory_resource())));
+      });
+    }
+    _index_chunk(compacted_chunk);
+
+    _begin_replacement();
+    if (get_chunk(chunk_id).invalidation_bitmap() == invalidation_bitmap) break;
+    _end_replacement();
+  }
+
+  _chunks[chunk_id] = std::move(compacted_chunk);
+  if (chunk_id + 1 == chunk_count()) build_chunk();
+  ++_layout_version;
+  mark_modified();
+  _end_replacement();
+}
+
+void Table::evict_chunk(ChunkID chunk_id, const std::shared_ptr<SpillFile>& spill_file) {
+  auto& chunk = get_chunk(chunk_id);
+  auto proxies = std::vector<std::shared_ptr<ProxySegment>>(chunk.column_count());
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto segment = chunk.get_stored_segment(column_id);
+    if (segment->encoding_type() == EncodingType::Proxy) {
+      // operators that still use the loaded segment keep it alive
+      std::static_pointer_cast<ProxySegment>(segment)->unload();
+    } else {
+      const auto is_indexed = static_cast<bool>(chunk.get_index(column_id));
+      proxies[column_id] = ProxySegment::evict(segment, column_type(column_id), spill_file, is_indexed);
+    }
+  }
+
+  _begin_replacement();
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    if (proxies[column_id]) chunk.replace_segment(column_id, proxies[column_id]);
+  }
+  _end_replacement();
+}
+
+void Table::lock_for_reading() const {
+  auto lock = std::unique_lock<std::mutex>{_replacement_mutex};
+  _replacement_condition.wait(lock, [&] { return !_is_replacing; });
+  ++_read_lock_count;
+}
+
+void Table::unlock_for_reading() const {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_replacement_mutex};
+    DebugAssert(_read_lock_count > 0, "Table is not locked for reading");
+    --_read_lock_count;
+  }
+  _replacement_condition.notify_all();
+}
+
+void Table::_begin_replacement() {
+  auto lock = std::unique_lock<std::mutex>{_replacement_mutex};
+  _replacement_condition.wait(lock, [&] { return _read_lock_count == 0 && !_is_replacing; });
+  _is_replacing = true;
+}
+
+void Table::_end_replacement() {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_replacement_mutex};
+    _is_replacing = false;
+  }
+  _replacement_condition.notify_all();
+}
+
+uint64_t Table::layout_version() const { return _layout_version; }
+
+void Table::create_index(ColumnID column_id) {
+  DebugAssert(column_id < column_count(), "Cannot index a column that does not exist");
+  if (is_indexed(column_id)) return;
+  _indexed_column_ids.push_back(column_id);
+
+  for (auto& chunk : _chunks) {
+    _index_chunk(chunk);
+  }
+}
+
+bool Table::is_indexed(ColumnID column_id) const {
+  return std::find(_indexed_column_ids.cbegin(), _indexed_column_ids.cend(), column_id) != _indexed_column_ids.cend();
+}
+
+void Table::_index_chunk(Chunk& chunk) const {
+  for (const auto& column_id : _indexed_column_ids) {
+    // evicted chunks are not indexed, as this would load them
+    const auto segment = chunk.get_stored_segment(column_id);
+    if (segment->encoding_type() != EncodingType::Dictionary || chunk.get_index(column_id)) continue;
+
+    resolve_data_type(column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      chunk.add_index(column_id,
+                      std::make_shared<GroupKeyIndex<Type>>(static_cast<const DictionarySegment<Type>&>(*segment)));
+    });
+  }
+}
+
+void Table::set_use_huge_pages(bool use_huge_pages) {
+  _use_huge_pages = use_huge_pages;
+  if (row_count() == 0) {
+    _chunks.clear();
+    build_chunk();
+  }
+}
+
+bool Table::uses_huge_pages() const { return _use_huge_pages.value_or(use_huge_pages_by_default.load()); }
+
+void Table::set_use_huge_pages_by_default(bool use_huge_pages) { use_huge_pages_by_default = use_huge_pages; }
+
+bool Table::uses_huge_pages_by_default() { return use_huge_pages_by_default; }
+
+Chunk Table::_make_chunk() const {
+  return uses_huge_pages() ? Chunk{&HugePageMemoryResource::get()} : Chunk{};
+}
+
+uint64_t Table::version() const { return _version; }
+
+void Table::mark_modified() { _version = next_version++; }
+
+size_t Table::estimate_memory_usage() const {
+  auto memory_usage = size_t{0};
+  for (const auto& chunk : _chunks) {
+    memory_usage += chunk.estimate_memory_usage();
+  }
+  return memory_usage;
 }
 }  // namespace opossum
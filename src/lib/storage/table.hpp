@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
 #include "base_segment.hpp"
 #include "chunk.hpp"
 
@@ -9,6 +14,7 @@
 
 namespace opossum {
 
+class SpillFile;
 class TableStatistics;
 
 // A table is partitioned horizontally into a number of chunks
@@ -16,13 +22,15 @@ class Table : private Noncopyable {
  public:
   // creates a table
   // the parameter specifies the maximum chunk size, i.e., partition size
-  // default is the maximum chunk size minus 1. A table holds always at least one chunk
+  // default is the maximum chunk size minus 1, which is also used if 0 is passed
+  // A table holds always at least one chunk
   explicit Table(const uint32_t chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
 
-  // we need to explicitly set the move constructor to default when
-  // we overwrite the copy constructor
-  Table(Table&&) = default;
-  Table& operator=(Table&&) = default;
+  // we need to explicitly define the move constructor when
+  // we overwrite the copy constructor (std::atomic and std::mutex are not movable)
+  // tables must not be moved while they are locked for reading
+  Table(Table&& other);
+  Table& operator=(Table&& other);
 
   // returns the number of columns (cannot exceed ColumnID (uint16_t))
   uint16_t column_count() const;
@@ -32,6 +40,10 @@ class Table : private Noncopyable {
   // Use approx_valid_row_count() for an approximate count of valid rows instead.
   uint64_t row_count() const;
 
+  // Returns the number of rows that have not been deleted. The count is approximate because rows can be deleted
+  // concurrently.
+  uint64_t approx_valid_row_count() const;
+
   // returns the number of chunks (cannot exceed ChunkID (uint32_t))
   ChunkID chunk_count() const;
 
@@ -79,14 +91,82 @@ class Table : private Noncopyable {
   // compresses a ValueSegment into a DictionarySegment
   void compress_chunk(ChunkID chunk_id);
 
+  // Rewrites a chunk without its deleted rows into a new dictionary-compressed chunk. Positions in the chunk change,
+  // so the layout version changes and ReferenceSegments that were created before reject their positions. If the last
+  // chunk is compacted, a new chunk is started for subsequent appends.
+  void compact_chunk(ChunkID chunk_id);
+
+  // Evicts a dictionary-encoded chunk to the spill file, i.e., replaces its segments by ProxySegments, and unloads the
+  // segments that were evicted before. The segments are written before readers are blocked for the replacement.
+  void evict_chunk(ChunkID chunk_id, const std::shared_ptr<SpillFile>& spill_file);
+
+  // Operators hold a read lock on the tables that they read while they are executed (see AbstractOperator::execute).
+  // Compressing and compacting replace chunks only while no read lock is held, so that they never swap a chunk that is
+  // being read. Unlike for a std::shared_mutex, read locks are only blocked while a chunk is being replaced, not while
+  // a replacement waits, so that a thread can lock a table again, e.g., for a nested plan, without deadlocking.
+  void lock_for_reading() const;
+  void unlock_for_reading() const;
+
+  // Returns a number that changes whenever rows move to other positions, i.e., when a chunk is compacted. Positions
+  // that were computed before refer to other rows afterwards (see ReferenceSegment::referenced_table).
+  uint64_t layout_version() const;
+
+  // Creates a GroupKeyIndex on the given column for every dictionary-encoded chunk. Chunks that are compressed or
+  // compacted later are indexed as well. Unencoded chunks, e.g., the chunk that is appended to, stay unindexed.
+  // note this is not thread-safe and must not be called while operators read the table
+  void create_index(ColumnID column_id);
+
+  // returns whether create_index was called for the given column
+  bool is_indexed(ColumnID column_id) const;
+
+  // returns the calculated memory usage of all chunks
+  size_t estimate_memory_usage() const;
+
+  // Returns a number that changes whenever the table is modified, e.g., by appending or compressing. Versions are
+  // unique across tables, so that a table that replaces a dropped one with the same name has a different version.
+  // Results computed from a table can be reused as long as its version is the same (see ResultCache).
+  uint64_t version() const;
+
+  // gives the table a new version, e.g., after rows were deleted from its chunks
+  void mark_modified();
+
+  // Chunks that are created afterwards, e.g., by appending or compressing, allocate large segments from huge pages
+  // (see HugePageMemoryResource). If the table is still empty, its first chunk is recreated as well.
+  // Tables for which this is not set explicitly use the global default.
+  void set_use_huge_pages(bool use_huge_pages);
+  bool uses_huge_pages() const;
+
+  static void set_use_huge_pages_by_default(bool use_huge_pages);
+  static bool uses_huge_pages_by_default();
+
  protected:
   uint32_t chunk_size;
   std::vector<Chunk> _chunks;
   std::vector<std::string> col_names;
   std::vector<std::string> col_types;
+  std::optional<bool> _use_huge_pages;
+  std::vector<ColumnID> _indexed_column_ids;
+  std::atomic<uint64_t> _version{0};
+  std::atomic<uint64_t> _layout_version{0};
+
+  // the read locks and whether a chunk is being replaced (see lock_for_reading)
+  mutable std::mutex _replacement_mutex;
+  mutable std::condition_variable _replacement_condition;
+  mutable size_t _read_lock_count = 0;
+  bool _is_replacing = false;
 
   void build_chunk();
 
+  // creates an empty chunk whose arena uses huge pages if enabled for the table
+  Chunk _make_chunk() const;
+
+  // adds the indexes of all indexed columns to a dictionary-encoded chunk
+  void _index_chunk(Chunk& chunk) const;
+
+  // waits until no read lock is held and blocks new ones until _end_replacement is called
+  void _begin_replacement();
+  void _end_replacement();
+
   //void compress_segment(const std::shared_ptr<BaseSegment> old_segment, const ColumnID& id, Chunk& new_chunk) const;
 };
 }  // namespace opossum
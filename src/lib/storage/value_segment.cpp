@@ -9,6 +9,7 @@
 
 #include "type_cast.hpp"
 #include "utils/assert.hpp"
+#include "utils/memory_usage.hpp"
 #include "utils/performance_warning.hpp"
 
 namespace opossum {
@@ -33,11 +34,11 @@ size_t ValueSegment<T>::size() const {
 
 template <typename T>
 size_t ValueSegment<T>::estimate_memory_usage() const {
-  return sizeof(T) * _value_segment.size();
+  return opossum::estimate_memory_usage(_value_segment);
 }
 
 template <typename T>
-const std::vector<T>& ValueSegment<T>::values() const {
+const pmr_vector<T>& ValueSegment<T>::values() const {
   return _value_segment;
 }
 
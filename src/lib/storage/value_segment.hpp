@@ -13,7 +13,11 @@ namespace opossum {
 template <typename T>
 class ValueSegment : public BaseSegment {
  public:
-  ValueSegment() { _value_segment = std::vector<T>(); }
+  // the values are allocated using the given allocator, e.g., from the arena of the chunk the segment belongs to
+  explicit ValueSegment(const PolymorphicAllocator<T>& allocator = {}) : _value_segment(allocator) {}
+
+  // creates a segment from already materialized values
+  explicit ValueSegment(pmr_vector<T> values) : _value_segment(std::move(values)) {}
 
   // return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
@@ -27,13 +31,15 @@ class ValueSegment : public BaseSegment {
   // Return all values. This is the preferred method to check a value at a certain index. Usually you need to
   // access more than a single value anyway.
   // e.g. const auto& values = value_segment.values(); and then: values[i]; in your loop.
-  const std::vector<T>& values() const;
+  const pmr_vector<T>& values() const;
 
   // returns the calculated memory usage
   size_t estimate_memory_usage() const final;
 
+  EncodingType encoding_type() const final { return EncodingType::Unencoded; }
+
  protected:
-  std::vector<T> _value_segment;
+  pmr_vector<T> _value_segment;
 };
 
 }  // namespace opossum
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+
 #include <cstdint>
 #include <iostream>
 #include <limits>
@@ -34,6 +37,19 @@ STRONG_TYPEDEF(uint32_t, ValueID);  // Cannot be larger than ChunkOffset
 
 namespace opossum {
 
+/**
+ * Segments, dictionaries, and PosLists are allocator-aware, so that they can be placed into arenas (e.g., per chunk
+ * or per operator output) instead of competing for the global heap. We use the boost implementation because
+ * std::pmr is not available in all standard libraries we support.
+ */
+using MemoryResource = boost::container::pmr::memory_resource;
+
+template <typename T>
+using PolymorphicAllocator = boost::container::pmr::polymorphic_allocator<T>;
+
+template <typename T>
+using pmr_vector = std::vector<T, PolymorphicAllocator<T>>;
+
 using ChunkOffset = uint32_t;
 using AttributeVectorWidth = uint8_t;
 
@@ -49,11 +65,25 @@ struct RowID {
   bool operator==(const RowID& rhs) const {
     return std::tie(chunk_id, chunk_offset) == std::tie(rhs.chunk_id, rhs.chunk_offset);
   }
+
+  bool operator!=(const RowID& rhs) const { return !(*this == rhs); }
 };
 
+// There are no NULL values in the storage layer. Unmatched rows of outer joins reference NULL_ROW_ID instead. Such
+// rows never satisfy predicates or join conditions, reading them returns the default value of the column's type.
+constexpr RowID NULL_ROW_ID{ChunkID{std::numeric_limits<ChunkID::base_type>::max()},
+                            std::numeric_limits<ChunkOffset>::max()};
+
 enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
 
-using PosList = std::vector<RowID>;
+// Inner joins return the matching pairs of rows. Left joins also return left rows without a match, paired with
+// NULL_ROW_ID. Semi and anti joins return the left rows with and without a match, respectively, and only the left
+// columns.
+enum class JoinMode { Inner, Left, Semi, Anti };
+
+enum class OrderByMode { Ascending, Descending };
+
+using PosList = pmr_vector<RowID>;
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
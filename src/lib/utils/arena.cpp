@@ -0,0 +1,54 @@
+#include "arena.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace opossum {
+
+namespace {
+
+std::atomic<uint64_t> next_arena_id{1};
+
+// the arena that the calling thread allocated from last and its buffer in that arena
+struct ThreadBufferCache {
+  uint64_t arena_id = 0;
+  boost::container::pmr::monotonic_buffer_resource* buffer = nullptr;
+};
+
+thread_local ThreadBufferCache thread_buffer_cache;
+
+}  // namespace
+
+Arena::Arena() : _id(next_arena_id++) {}
+
+size_t Arena::thread_buffer_count() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _thread_buffers.size();
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  return _thread_buffer().allocate(bytes, alignment);
+}
+
+boost::container::pmr::monotonic_buffer_resource& Arena::_thread_buffer() {
+  if (thread_buffer_cache.arena_id == _id) return *thread_buffer_cache.buffer;
+
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  auto& buffer = _thread_buffers[std::this_thread::get_id()];
+  if (!buffer) buffer = std::make_unique<boost::container::pmr::monotonic_buffer_resource>();
+  thread_buffer_cache = ThreadBufferCache{_id, buffer.get()};
+  return *buffer;
+}
+
+void Arena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {}
+
+bool Arena::do_is_equal(const MemoryResource& other) const noexcept { return this == &other; }
+
+std::shared_ptr<PosList> make_pos_list(const std::shared_ptr<MemoryResource>& memory_resource) {
+  auto pos_list = std::make_shared<PosList>(PolymorphicAllocator<RowID>{memory_resource.get()});
+  return keep_memory_resource_alive(std::move(pos_list), memory_resource);
+}
+
+}  // namespace opossum
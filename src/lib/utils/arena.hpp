@@ -0,0 +1,71 @@
+#pragma once
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * An Arena hands out memory from large blocks and releases all of it at once when it is destroyed. Deallocating
+ * single objects is a no-op. This makes it a good fit for intermediate results, which are built once and dropped as a
+ * whole, e.g., the PosLists of an operator's output.
+ *
+ * Unlike boost's monotonic_buffer_resource, an Arena can be used by multiple threads at the same time. Each thread
+ * allocates from a monotonic buffer of its own, so that the workers of a parallel_for do not contend. The buffers
+ * take their blocks from the default memory resource, which is thread-safe.
+ */
+class Arena : public MemoryResource, private Noncopyable {
+ public:
+  Arena();
+
+  // returns the number of threads that allocated from the arena
+  size_t thread_buffer_count() const;
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const MemoryResource& other) const noexcept override;
+
+  // returns the buffer of the calling thread, which is created when the thread allocates for the first time
+  boost::container::pmr::monotonic_buffer_resource& _thread_buffer();
+
+  // distinguishes the arena from earlier ones at the same address, whose buffers the threads might still remember
+  const uint64_t _id;
+
+  // only locked when a thread allocates from the arena for the first time
+  mutable std::mutex _mutex;
+  std::unordered_map<std::thread::id, std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>>
+      _thread_buffers;
+};
+
+/**
+ * Objects that allocate from a memory resource must not outlive it. This returns a pointer to the given object that
+ * also keeps the memory resource alive, so that the object can be passed around freely, e.g., from one operator's
+ * output to the next one.
+ */
+template <typename T>
+std::shared_ptr<T> keep_memory_resource_alive(std::shared_ptr<T> object,
+                                              std::shared_ptr<MemoryResource> memory_resource) {
+  struct Holder {
+    // members are destroyed in reverse order, i.e., the object is destroyed before the memory resource
+    std::shared_ptr<MemoryResource> memory_resource;
+    std::shared_ptr<T> object;
+  };
+
+  auto holder = std::make_shared<Holder>(Holder{std::move(memory_resource), std::move(object)});
+  auto* const object_pointer = holder->object.get();
+  return std::shared_ptr<T>(std::move(holder), object_pointer);
+}
+
+// creates an empty PosList whose entries are allocated from the given memory resource
+std::shared_ptr<PosList> make_pos_list(const std::shared_ptr<MemoryResource>& memory_resource);
+
+}  // namespace opossum
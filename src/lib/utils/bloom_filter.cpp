@@ -0,0 +1,27 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+
+namespace opossum {
+
+namespace {
+
+// 16 bits per hash yield a false positive rate of about 0.1%
+constexpr auto BITS_PER_HASH = size_t{16};
+
+}  // namespace
+
+BloomFilter::BloomFilter(const size_t hash_count)
+    : _blocks(std::max((hash_count * BITS_PER_HASH + 255) / 256, size_t{1})) {}
+
+void BloomFilter::insert(const uint64_t hash) {
+  auto& block = _blocks[_block_index(hash)];
+  const auto mask = _mask(hash);
+  for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+    block.words[word_index] |= mask[word_index];
+  }
+}
+
+size_t BloomFilter::block_count() const { return _blocks.size(); }
+
+}  // namespace opossum
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace opossum {
+
+// Returns the hash of a value that is inserted into or looked up in a BloomFilter. The hash is mixed, because
+// std::hash is the identity for integers.
+template <typename T>
+uint64_t bloom_filter_hash(const T& value) {
+  return static_cast<uint64_t>(std::hash<T>{}(value)) * uint64_t{0x9E3779B97F4A7C15};
+}
+
+// A blocked Bloom filter over hashes, e.g., over the join keys of a table. Each hash selects one block of 256 bits and
+// sets one bit in each of the eight 32-bit words of that block. A lookup thus touches a single cache line, and the
+// eight words are tested independently of each other, so that the compiler can vectorize the test.
+//
+// Lookups may return false positives, but never false negatives.
+class BloomFilter {
+ public:
+  // sizes the filter for the given number of hashes, with a false positive rate of well below one percent
+  explicit BloomFilter(const size_t hash_count);
+
+  void insert(const uint64_t hash);
+
+  bool contains(const uint64_t hash) const {
+    const auto& block = _blocks[_block_index(hash)];
+    const auto mask = _mask(hash);
+    auto missing_bits = uint32_t{0};
+    for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+      missing_bits |= mask[word_index] & ~block.words[word_index];
+    }
+    return missing_bits == 0;
+  }
+
+  size_t block_count() const;
+
+ protected:
+  static constexpr auto WORDS_PER_BLOCK = size_t{8};
+
+  struct alignas(32) Block {
+    std::array<uint32_t, WORDS_PER_BLOCK> words{};
+  };
+
+  // the upper half of the hash selects the block
+  size_t _block_index(const uint64_t hash) const {
+    return static_cast<size_t>(((hash >> 32) * _blocks.size()) >> 32);
+  }
+
+  // the lower half of the hash selects the bit of each word, using a different odd multiplier per word
+  static std::array<uint32_t, WORDS_PER_BLOCK> _mask(const uint64_t hash) {
+    constexpr auto SALTS = std::array<uint32_t, WORDS_PER_BLOCK>{0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                                 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    auto mask = std::array<uint32_t, WORDS_PER_BLOCK>{};
+    for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+      mask[word_index] = uint32_t{1} << ((static_cast<uint32_t>(hash) * SALTS[word_index]) >> 27);
+    }
+    return mask;
+  }
+
+  std::vector<Block> _blocks;
+};
+
+}  // namespace opossum
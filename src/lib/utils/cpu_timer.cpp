@@ -0,0 +1,42 @@
+#include "cpu_timer.hpp"
+
+#include <time.h>
+
+#include <chrono>
+
+namespace opossum {
+
+namespace {
+
+// the innermost timer that measures the calling thread
+thread_local CpuTimer* current_timer = nullptr;
+
+}  // namespace
+
+std::chrono::nanoseconds thread_cpu_time() {
+  auto time = timespec{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+CpuTimer::CpuTimer() : _previous_timer(current_timer), _start(thread_cpu_time()) { current_timer = this; }
+
+CpuTimer::~CpuTimer() { current_timer = _previous_timer; }
+
+std::chrono::nanoseconds CpuTimer::elapsed() const {
+  return thread_cpu_time() - _start + std::chrono::nanoseconds{_job_nanoseconds.load()};
+}
+
+CpuTimer* CpuTimer::current() { return current_timer; }
+
+CpuTimer::JobScope::JobScope(CpuTimer* timer)
+    : _timer(timer), _previous_timer(current_timer), _start(thread_cpu_time()) {
+  current_timer = timer;
+}
+
+CpuTimer::JobScope::~JobScope() {
+  current_timer = _previous_timer;
+  _timer->_job_nanoseconds += (thread_cpu_time() - _start).count();
+}
+
+}  // namespace opossum
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// returns the CPU time that the calling thread has consumed so far
+std::chrono::nanoseconds thread_cpu_time();
+
+/**
+ * CpuTimer measures the CPU time of work that may be spread over several threads, e.g., the execution of an operator.
+ * It measures the CPU time of the thread that created it. While it is alive, parallel_for adds the CPU time of the
+ * jobs that run on other threads on behalf of this thread, so that the morsels of a parallel operator are included.
+ *
+ * A thread that waits for tasks helps running other tasks, which are then counted as well. Thus, the CPU time of
+ * operators that are executed concurrently is only approximate.
+ */
+class CpuTimer : private Noncopyable {
+ public:
+  CpuTimer();
+  ~CpuTimer();
+
+  std::chrono::nanoseconds elapsed() const;
+
+  // returns the timer that measures the calling thread, or nullptr
+  static CpuTimer* current();
+
+  // Adds the CPU time of a job that runs on another thread on behalf of the timer, which becomes the current timer of
+  // that thread in the meantime. Jobs that run on a thread that the timer already measures must not be added again.
+  class JobScope : private Noncopyable {
+   public:
+    explicit JobScope(CpuTimer* timer);
+    ~JobScope();
+
+   protected:
+    CpuTimer* const _timer;
+    CpuTimer* const _previous_timer;
+    const std::chrono::nanoseconds _start;
+  };
+
+ protected:
+  CpuTimer* const _previous_timer;
+  const std::chrono::nanoseconds _start;
+  std::atomic<int64_t> _job_nanoseconds{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,103 @@
+#include "hardware_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+namespace opossum {
+
+namespace {
+
+std::atomic<bool> hardware_counters_enabled{false};
+
+// the innermost counters that measure the calling thread
+thread_local HardwareCounters* current_counters = nullptr;
+
+// opens a counter for the calling thread, returns -1 if it is not permitted or not supported
+int open_counter(const uint32_t type, const uint64_t config) {
+  auto attributes = perf_event_attr{};
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = type;
+  attributes.config = config;
+  attributes.disabled = 1;
+  // counting user space only is permitted with the default perf_event_paranoid setting
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+
+  const auto file_descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  if (file_descriptor < 0) return -1;
+  ioctl(file_descriptor, PERF_EVENT_IOC_RESET, 0);
+  ioctl(file_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+  return file_descriptor;
+}
+
+}  // namespace
+
+double HardwareCounterValues::ipc() const {
+  return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+}
+
+HardwareCounterValues& HardwareCounterValues::operator+=(const HardwareCounterValues& other) {
+  cycles += other.cycles;
+  instructions += other.instructions;
+  llc_misses += other.llc_misses;
+  branch_misses += other.branch_misses;
+  return *this;
+}
+
+void HardwareCounters::set_enabled(const bool enabled) { hardware_counters_enabled = enabled; }
+
+bool HardwareCounters::is_enabled() { return hardware_counters_enabled; }
+
+HardwareCounters::HardwareCounters()
+    : _previous_counters(current_counters),
+      _file_descriptors{open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+                        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+                        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+                        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES)} {
+  current_counters = this;
+}
+
+HardwareCounters::~HardwareCounters() {
+  current_counters = _previous_counters;
+  for (const auto file_descriptor : _file_descriptors) {
+    if (file_descriptor >= 0) close(file_descriptor);
+  }
+}
+
+bool HardwareCounters::is_available() const { return _file_descriptors[0] >= 0 && _file_descriptors[1] >= 0; }
+
+HardwareCounterValues HardwareCounters::read() const {
+  auto values = _read_thread();
+  values += HardwareCounterValues{_job_counts[0], _job_counts[1], _job_counts[2], _job_counts[3]};
+  return values;
+}
+
+HardwareCounterValues HardwareCounters::_read_thread() const {
+  auto counts = std::array<uint64_t, COUNTER_COUNT>{};
+  for (auto index = size_t{0}; index < COUNTER_COUNT; ++index) {
+    if (_file_descriptors[index] < 0) continue;
+    if (::read(_file_descriptors[index], &counts[index], sizeof(uint64_t)) != sizeof(uint64_t)) counts[index] = 0;
+  }
+  return HardwareCounterValues{counts[0], counts[1], counts[2], counts[3]};
+}
+
+HardwareCounters* HardwareCounters::current() { return current_counters; }
+
+HardwareCounters::JobScope::JobScope(HardwareCounters* counters) : _counters(counters) { current_counters = counters; }
+
+HardwareCounters::JobScope::~JobScope() {
+  const auto values = _job_counters.read();
+  _counters->_job_counts[0] += values.cycles;
+  _counters->_job_counts[1] += values.instructions;
+  _counters->_job_counts[2] += values.llc_misses;
+  _counters->_job_counts[3] += values.branch_misses;
+}
+
+}  // namespace opossum
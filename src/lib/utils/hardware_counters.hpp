@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// the values of the hardware performance counters of a piece of work, e.g., an operator
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+
+  // instructions per cycle, or 0 if no cycles were counted
+  double ipc() const;
+
+  HardwareCounterValues& operator+=(const HardwareCounterValues& other);
+};
+
+/**
+ * HardwareCounters count the cycles, instructions, last-level cache misses, and branch misses of the calling thread
+ * from their construction until they are read, using perf_event_open. While they are alive, parallel_for adds the
+ * counts of the jobs that run on other threads on behalf of this thread, like for a CpuTimer.
+ *
+ * The counters are optional, as opening them costs a few system calls per thread: operators only measure them if
+ * they were enabled (see AbstractOperator::performance_data). Counters that the kernel does not permit, e.g., because
+ * of perf_event_paranoid or in a container, or that the CPU does not support, are not available and read as 0.
+ */
+class HardwareCounters : private Noncopyable {
+ public:
+  static void set_enabled(const bool enabled);
+  static bool is_enabled();
+
+  HardwareCounters();
+  ~HardwareCounters();
+
+  // returns whether at least the cycles and instructions are counted
+  bool is_available() const;
+
+  // returns the counts of the thread and of the jobs so far
+  HardwareCounterValues read() const;
+
+  // returns the counters that measure the calling thread, or nullptr
+  static HardwareCounters* current();
+
+  // adds the counts of a job that runs on another thread on behalf of the counters
+  class JobScope;
+
+ protected:
+  // reads the counts of this thread only
+  HardwareCounterValues _read_thread() const;
+
+  static constexpr size_t COUNTER_COUNT = 4;
+
+  HardwareCounters* const _previous_counters;
+  // the file descriptors of cycles, instructions, LLC misses, and branch misses, -1 if not available
+  std::array<int, COUNTER_COUNT> _file_descriptors;
+  // the counts of the jobs on other threads
+  std::array<std::atomic<uint64_t>, COUNTER_COUNT> _job_counts{};
+};
+
+// The counters become the current counters of the job's thread in the meantime. Jobs that run on a thread that the
+// counters already measure must not be added.
+class HardwareCounters::JobScope : private Noncopyable {
+ public:
+  explicit JobScope(HardwareCounters* counters);
+  ~JobScope();
+
+ protected:
+  HardwareCounters* const _counters;
+  // measures the job's thread, restores the previous counters of the thread when it is destroyed
+  const HardwareCounters _job_counters;
+};
+
+}  // namespace opossum
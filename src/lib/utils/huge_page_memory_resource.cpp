@@ -0,0 +1,101 @@
+#include "huge_page_memory_resource.hpp"
+
+#include <sys/mman.h>
+
+#include <boost/container/pmr/global_resource.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+HugePageMemoryResource& HugePageMemoryResource::get() {
+  // Chunks may be destroyed during static destruction, e.g., by the StorageManager. The resource is therefore never
+  // destroyed, so that it is still usable at that point.
+  static auto* const instance = new HugePageMemoryResource{};
+  return *instance;
+}
+
+bool HugePageMemoryResource::is_available() {
+#ifdef MADV_HUGEPAGE
+  // the active mode is marked with brackets, e.g., "always [madvise] never"
+  auto file = std::ifstream{"/sys/kernel/mm/transparent_hugepage/enabled"};
+  auto mode = std::string{};
+  std::getline(file, mode);
+  return file.good() && mode.find("[never]") == std::string::npos;
+#else
+  return false;
+#endif
+}
+
+HugePageMemoryResource::HugePageMemoryResource()
+    : _available(is_available()), _upstream(boost::container::pmr::get_default_resource()) {}
+
+bool HugePageMemoryResource::is_huge_page_backed(const void* pointer) const {
+  const auto* const address = static_cast<const char*>(pointer);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto mapping = _mappings.upper_bound(address);
+  if (mapping == _mappings.cbegin()) return false;
+  --mapping;
+  return address < mapping->first + mapping->second.length && mapping->second.uses_huge_pages;
+}
+
+size_t HugePageMemoryResource::huge_page_bytes() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto bytes = size_t{0};
+  for (const auto& [address, mapping] : _mappings) {
+    if (mapping.uses_huge_pages) bytes += mapping.length;
+  }
+  return bytes;
+}
+
+void* HugePageMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  if (!_available || bytes < HUGE_PAGE_SIZE || alignment > HUGE_PAGE_SIZE) {
+    return _upstream->allocate(bytes, alignment);
+  }
+
+  // mmap only guarantees an alignment of 4 KB. We over-allocate by one huge page and unmap the unaligned head and tail.
+  const auto length = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+  auto* const mapping = static_cast<char*>(
+      mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (mapping == MAP_FAILED) throw std::bad_alloc{};
+
+  const auto head = (HUGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(mapping) % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+  auto* const aligned_mapping = mapping + head;
+  if (head > 0) munmap(mapping, head);
+  munmap(aligned_mapping + length, HUGE_PAGE_SIZE - head);
+
+  // If the kernel rejects the advice, the mapping is still usable, only with regular pages.
+  const auto uses_huge_pages = madvise(aligned_mapping, length, MADV_HUGEPAGE) == 0;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _mappings.emplace(aligned_mapping, Mapping{length, uses_huge_pages});
+  return aligned_mapping;
+}
+
+void HugePageMemoryResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+  if (!_available || bytes < HUGE_PAGE_SIZE || alignment > HUGE_PAGE_SIZE) {
+    _upstream->deallocate(pointer, bytes, alignment);
+    return;
+  }
+
+  auto length = size_t{0};
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto mapping = _mappings.find(static_cast<const char*>(pointer));
+    DebugAssert(mapping != _mappings.cend(), "Pointer was not allocated by this resource");
+    length = mapping->second.length;
+    _mappings.erase(mapping);
+  }
+  munmap(pointer, length);
+}
+
+bool HugePageMemoryResource::do_is_equal(const MemoryResource& other) const noexcept { return this == &other; }
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * The HugePageMemoryResource serves large allocations from anonymous mappings that are aligned to 2 MB and advised
+ * (madvise(MADV_HUGEPAGE)) to be backed by transparent huge pages. Scanning a large segment then needs far fewer TLB
+ * entries. Allocations smaller than a huge page are forwarded to the default memory resource, as are all allocations
+ * if transparent huge pages are disabled on this system.
+ *
+ * Chunks use it as the upstream resource of their arena if huge pages are enabled for their table (see Table).
+ */
+class HugePageMemoryResource : public MemoryResource, private Noncopyable {
+ public:
+  static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  static HugePageMemoryResource& get();
+
+  // returns whether the kernel supports transparent huge pages and has not disabled them
+  static bool is_available();
+
+  // returns whether the given address lies in a mapping that was successfully advised to use huge pages
+  bool is_huge_page_backed(const void* pointer) const;
+
+  // returns the number of bytes that are currently mapped with huge pages
+  size_t huge_page_bytes() const;
+
+ protected:
+  HugePageMemoryResource();
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const MemoryResource& other) const noexcept override;
+
+  struct Mapping {
+    size_t length;
+    bool uses_huge_pages;
+  };
+
+  const bool _available;
+  MemoryResource* const _upstream;
+
+  mutable std::mutex _mutex;
+  // all mappings that are currently handed out, by their start address
+  std::map<const char*, Mapping> _mappings;
+};
+
+}  // namespace opossum
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Helpers for BaseSegment::estimate_memory_usage and friends.
+ *
+ * sizeof(T) does not cover memory that a value owns on the heap. For std::string, this is the payload of every string
+ * that is too long for the small string buffer inside the std::string object itself. Ignoring it makes string columns
+ * look far cheaper than they are.
+ */
+
+// returns the number of heap bytes that a single value owns in addition to sizeof(T)
+template <typename T>
+size_t estimate_heap_memory_usage(const T&) {
+  return 0;
+}
+
+inline size_t estimate_heap_memory_usage(const std::string& value) {
+  // the capacity of an empty string is the size of the small string buffer, e.g., 15 for libstdc++
+  static const auto small_string_capacity = std::string{}.capacity();
+  if (value.capacity() <= small_string_capacity) return 0;
+
+  // + 1 for the terminating null character
+  return value.capacity() + 1;
+}
+
+// returns the memory used by the values of a vector including their heap payloads
+template <typename T, typename Allocator>
+size_t estimate_memory_usage(const std::vector<T, Allocator>& values) {
+  auto memory_usage = sizeof(T) * values.size();
+  if constexpr (!std::is_arithmetic_v<T>) {
+    for (const auto& value : values) {
+      memory_usage += estimate_heap_memory_usage(value);
+    }
+  }
+  return memory_usage;
+}
+
+}  // namespace opossum
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/task_scheduler.hpp"
+#include "utils/cpu_timer.hpp"
+#include "utils/hardware_counters.hpp"
+#include "utils/performance_warning.hpp"
+#include "utils/tracer.hpp"
+
+namespace opossum {
+
+/**
+ * Calls functor(index) for every index in [0, count), e.g., once per chunk, which makes each index a morsel. The
+ * morsels are processed by up to one job per worker of the shared TaskScheduler. Jobs take the next morsel once they
+ * are done with the previous one, so that uneven work, e.g., chunks of different sizes, is balanced. The calling
+ * thread processes morsels as well, so that parallel_for can be nested, e.g., within operators that are executed as
+ * tasks. The first exception thrown by the functor is rethrown once all jobs are done.
+ *
+ * Jobs that run on other threads add their CPU time and hardware counters to the CpuTimer and HardwareCounters of the
+ * calling thread, e.g., those of an operator, and attribute their performance warnings to its operator.
+ * Each morsel is traced as a span (see Tracer).
+ */
+template <typename Functor>
+void parallel_for(const size_t count, const Functor& functor) {
+  const auto process_morsel = [&](const size_t index) {
+    const auto trace_scope = TraceScope{"job", [&] { return "morsel " + std::to_string(index); }};
+    functor(index);
+  };
+
+  auto& scheduler = TaskScheduler::get();
+  const auto job_count = std::min(count, scheduler.worker_count());
+  if (job_count <= 1) {
+    for (auto index = size_t{0}; index < count; ++index) process_morsel(index);
+    return;
+  }
+
+  auto next_index = std::atomic<size_t>{0};
+  auto* const cpu_timer = CpuTimer::current();
+  auto* const hardware_counters = HardwareCounters::current();
+  const auto operator_id = PerformanceWarningRegistry::current_operator();
+  const auto work = [&]() {
+    const auto warning_scope = PerformanceWarningScope{operator_id};
+    auto job_scope = std::optional<CpuTimer::JobScope>{};
+    if (cpu_timer && CpuTimer::current() != cpu_timer) job_scope.emplace(cpu_timer);
+    auto counters_job_scope = std::optional<HardwareCounters::JobScope>{};
+    if (hardware_counters && HardwareCounters::current() != hardware_counters) {
+      counters_job_scope.emplace(hardware_counters);
+    }
+
+    try {
+      for (auto index = next_index++; index < count; index = next_index++) process_morsel(index);
+    } catch (...) {
+      // the other jobs stop after their current morsel
+      next_index = count;
+      throw;
+    }
+  };
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(job_count);
+  for (auto job_index = size_t{0}; job_index < job_count; ++job_index) {
+    jobs.emplace_back(std::make_shared<JobTask>(work));
+  }
+  scheduler.schedule_and_wait(jobs);
+}
+
+}  // namespace opossum
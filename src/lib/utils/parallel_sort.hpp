@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "scheduler/task_scheduler.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+/**
+ * Merges sorted runs, e.g., one per chunk, into a single sorted vector. The output is split into ranges of values by
+ * splitters that are sampled from the runs. Each range is located in all runs with binary searches and merged
+ * independently with a heap, so that the ranges are merged in parallel. The merge is stable with regard to the order
+ * of the runs.
+ */
+template <typename T, typename Compare>
+std::vector<T> parallel_multiway_merge(const std::vector<std::vector<T>>& runs, const Compare& compare) {
+  auto total_size = size_t{0};
+  for (const auto& run : runs) total_size += run.size();
+
+  // sample splitters evenly from all runs
+  const auto thread_count = TaskScheduler::get().worker_count();
+  const auto range_count = std::min(thread_count * 4, total_size / 1024 + 1);
+  auto samples = std::vector<T>{};
+  for (const auto& run : runs) {
+    const auto step = std::max(run.size() / range_count, size_t{1});
+    for (auto index = step / 2; index < run.size(); index += step) samples.push_back(run[index]);
+  }
+  std::sort(samples.begin(), samples.end(), compare);
+  auto splitters = std::vector<T>{};
+  for (auto range = size_t{1}; range < range_count && !samples.empty(); ++range) {
+    splitters.push_back(samples[range * samples.size() / range_count]);
+  }
+
+  // range r covers the values in [splitters[r - 1], splitters[r]), located per run by binary search
+  const auto actual_range_count = splitters.size() + 1;
+  auto bounds = std::vector<std::vector<size_t>>(actual_range_count + 1, std::vector<size_t>(runs.size()));
+  for (auto run_index = size_t{0}; run_index < runs.size(); ++run_index) {
+    const auto& run = runs[run_index];
+    bounds[actual_range_count][run_index] = run.size();
+    for (auto range = size_t{1}; range < actual_range_count; ++range) {
+      bounds[range][run_index] = static_cast<size_t>(
+          std::lower_bound(run.begin(), run.end(), splitters[range - 1], compare) - run.begin());
+    }
+  }
+
+  auto output_offsets = std::vector<size_t>(actual_range_count + 1);
+  for (auto range = size_t{0}; range < actual_range_count; ++range) {
+    output_offsets[range + 1] = output_offsets[range];
+    for (auto run_index = size_t{0}; run_index < runs.size(); ++run_index) {
+      output_offsets[range + 1] += bounds[range + 1][run_index] - bounds[range][run_index];
+    }
+  }
+
+  auto output = std::vector<T>(total_size);
+  parallel_for(actual_range_count, [&](const size_t range) {
+    // the heap holds the position of the next value of each run and yields the smallest one, ties by run index
+    using Cursor = std::pair<size_t, size_t>;
+    const auto greater = [&](const Cursor& lhs, const Cursor& rhs) {
+      const auto& lhs_value = runs[lhs.first][lhs.second];
+      const auto& rhs_value = runs[rhs.first][rhs.second];
+      if (compare(rhs_value, lhs_value)) return true;
+      if (compare(lhs_value, rhs_value)) return false;
+      return lhs.first > rhs.first;
+    };
+    auto heap = std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)>{greater};
+    for (auto run_index = size_t{0}; run_index < runs.size(); ++run_index) {
+      if (bounds[range][run_index] < bounds[range + 1][run_index]) heap.emplace(run_index, bounds[range][run_index]);
+    }
+
+    auto output_index = output_offsets[range];
+    while (!heap.empty()) {
+      auto [run_index, position] = heap.top();
+      heap.pop();
+      output[output_index++] = runs[run_index][position];
+      if (++position < bounds[range + 1][run_index]) heap.emplace(run_index, position);
+    }
+  });
+
+  return output;
+}
+
+// Sorts each run in parallel and merges them (see parallel_multiway_merge). The sort is stable.
+template <typename T, typename Compare>
+std::vector<T> parallel_sort(std::vector<std::vector<T>> runs, const Compare& compare) {
+  parallel_for(runs.size(), [&](const size_t run_index) {
+    std::stable_sort(runs[run_index].begin(), runs[run_index].end(), compare);
+  });
+  return parallel_multiway_merge(runs, compare);
+}
+
+}  // namespace opossum
@@ -0,0 +1,165 @@
+#include "performance_warning.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+namespace {
+
+thread_local bool warnings_disabled = false;
+
+// the operator that the calling thread works for, 0 if there is none
+thread_local size_t current_operator_id = 0;
+
+// writes the string as the value of a Prometheus label
+void write_label_value(std::ostream& out, const std::string& string) {
+  out << '"';
+  for (const auto character : string) {
+    if (character == '"' || character == '\\') {
+      out << '\\' << character;
+    } else if (character == '\n') {
+      out << "\\n";
+    } else {
+      out << character;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+PerformanceWarningRegistry& PerformanceWarningRegistry::get() {
+  static PerformanceWarningRegistry instance;
+  return instance;
+}
+
+PerformanceWarningRegistry::PerformanceWarningRegistry() : _operator_names{""}, _operator_ids{{"", 0}} {}
+
+size_t PerformanceWarningRegistry::register_site(const std::string& text, const char* file, const size_t line) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  _sites.emplace_back(Site{text, std::string{file} + ":" + std::to_string(line)});
+  return _sites.size() - 1;
+}
+
+void PerformanceWarningRegistry::record(const size_t site_id) {
+  if (warnings_disabled) return;
+
+  // Threads usually hit the same site from the same operator many times in a row, e.g., once per row, so that the
+  // count is only looked up if the site or operator changed.
+  thread_local auto last_key = std::pair<size_t, size_t>{std::numeric_limits<size_t>::max(), 0};
+  thread_local std::atomic<uint64_t>* last_count = nullptr;
+
+  const auto key = std::pair<size_t, size_t>{site_id, current_operator_id};
+  if (key != last_key) {
+    auto& thread_counts = _thread_counts();
+    const auto lock = std::lock_guard<std::mutex>{thread_counts.mutex};
+    last_count = &thread_counts.counts[key];
+    last_key = key;
+  }
+
+  // only the calling thread increments the count, so that it does not need an atomic increment
+  last_count->store(last_count->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+PerformanceWarningRegistry::ThreadCounts& PerformanceWarningRegistry::_thread_counts() {
+  // Counts are never removed, so that the pointer stays valid for the lifetime of the thread.
+  thread_local ThreadCounts* thread_counts = nullptr;
+  if (!thread_counts) {
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    auto counts = std::make_shared<ThreadCounts>();
+    thread_counts = counts.get();
+    _thread_counts_list.emplace_back(std::move(counts));
+  }
+  return *thread_counts;
+}
+
+std::vector<PerformanceWarningCount> PerformanceWarningRegistry::snapshot() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+  auto counts = std::map<std::pair<size_t, size_t>, uint64_t>{};
+  for (const auto& thread_counts : _thread_counts_list) {
+    const auto thread_lock = std::lock_guard<std::mutex>{thread_counts->mutex};
+    for (const auto& [key, count] : thread_counts->counts) {
+      const auto value = count.load(std::memory_order_relaxed);
+      if (value > 0) counts[key] += value;
+    }
+  }
+
+  auto snapshot = std::vector<PerformanceWarningCount>{};
+  snapshot.reserve(counts.size());
+  for (const auto& [key, count] : counts) {
+    const auto& site = _sites[key.first];
+    snapshot.emplace_back(PerformanceWarningCount{site.text, site.location, _operator_names[key.second], count});
+  }
+  std::sort(snapshot.begin(), snapshot.end(), [](const auto& left, const auto& right) {
+    return std::tie(left.text, left.location, left.operator_name) <
+           std::tie(right.text, right.location, right.operator_name);
+  });
+  return snapshot;
+}
+
+uint64_t PerformanceWarningRegistry::hit_count(const std::string& text) const {
+  auto hit_count = uint64_t{0};
+  for (const auto& count : snapshot()) {
+    if (count.text == text) hit_count += count.count;
+  }
+  return hit_count;
+}
+
+void PerformanceWarningRegistry::write_snapshot(std::ostream& out) const {
+  out << "# HELP performance_warning_hits How often slow paths were hit, per call site and operator.\n";
+  out << "# TYPE performance_warning_hits counter\n";
+  for (const auto& count : snapshot()) {
+    out << "performance_warning_hits{warning=";
+    write_label_value(out, count.text);
+    out << ",location=";
+    write_label_value(out, count.location);
+    out << ",operator=";
+    write_label_value(out, count.operator_name);
+    out << "} " << count.count << "\n";
+  }
+  out << std::flush;
+}
+
+void PerformanceWarningRegistry::reset() {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  for (const auto& thread_counts : _thread_counts_list) {
+    const auto thread_lock = std::lock_guard<std::mutex>{thread_counts->mutex};
+    for (auto& [key, count] : thread_counts->counts) count = 0;
+  }
+}
+
+size_t PerformanceWarningRegistry::register_operator(const std::string& name) {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  const auto [iterator, inserted] = _operator_ids.emplace(name, _operator_names.size());
+  if (inserted) _operator_names.emplace_back(name);
+  return iterator->second;
+}
+
+size_t PerformanceWarningRegistry::current_operator() { return current_operator_id; }
+
+bool PerformanceWarningRegistry::_disable() {
+  const auto previous = warnings_disabled;
+  warnings_disabled = true;
+  return previous;
+}
+
+void PerformanceWarningRegistry::_enable() { warnings_disabled = false; }
+
+PerformanceWarningScope::PerformanceWarningScope(const size_t operator_id)
+    : _previous_operator_id(current_operator_id) {
+  current_operator_id = operator_id;
+}
+
+PerformanceWarningScope::~PerformanceWarningScope() { current_operator_id = _previous_operator_id; }
+
+}  // namespace opossum
@@ -1,72 +1,142 @@
 #pragma once
 
-#include <boost/preprocessor/stringize.hpp>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
 
 /**
  * Performance Warnings can be used in places where slow workarounds are used. This includes BaseSegment[] or the
  * use of a cross join followed by a projection instead of an equijoin.
  *
- * The warnings are printed only once per program execution. This is achieved by using static variables.
+ * Each PerformanceWarning is a call site with a named counter in the PerformanceWarningRegistry, which counts how often
+ * the site was hit and from which operator, also in release builds. The counts can be queried or exported as a
+ * snapshot, e.g., to find the operators that hit a slow path most often in production:
+ *
+ * PerformanceWarningRegistry::get().write_snapshot(std::cout);
+ * // performance_warning_hits{warning="operator[] used",location="storage/value_segment.cpp:19",operator="Sort"} 42
  *
- * Performance warnings can be disabled using the RAII-style PerformanceWarningDisabler:
+ * Performance warnings can be disabled on the calling thread using the RAII-style PerformanceWarningDisabler, e.g., for
+ * printing, which hits the slow paths on purpose:
  *
  * {
  *   PerformanceWarningDisabler pwd;
- *   std::cout << base_segment[5] << std::endl; // this does not cause a warning
+ *   std::cout << base_segment[5] << std::endl; // this is not counted
  * }
- * // warnings are enabled again
- *
- * Warnings do not print in tests.
+ * // warnings are counted again
  */
 
-class PerformanceWarningDisabler;
+namespace opossum {
 
-class PerformanceWarningClass {
-  static bool& disabled() {
-    // hacky hack that allows us to have state in a header file
-    static bool _disabled{false};
-    return _disabled;
-  }
+// the hits of a call site from within one operator
+struct PerformanceWarningCount {
+  std::string text;
+  // the source file and line of the call site
+  std::string location;
+  // the name of the operator that hit the call site, or empty if it was not hit from an operator
+  std::string operator_name;
+  uint64_t count;
+};
 
+class PerformanceWarningRegistry : private Noncopyable {
  public:
-  explicit PerformanceWarningClass(const std::string& text) {
-    if (PerformanceWarningClass::disabled()) return;
-    std::cout << "[PERF] " << text << "\n\tPerformance can be affected. This warning is only shown once." << std::endl;
-  }
+  static PerformanceWarningRegistry& get();
+
+  // registers a call site and returns its id, called once per site by PerformanceWarning
+  size_t register_site(const std::string& text, const char* file, const size_t line);
+
+  // Counts a hit of the call site on the calling thread unless warnings are disabled on it. Only the counters of the
+  // calling thread are incremented, so that threads do not contend.
+  void record(const size_t site_id);
+
+  // returns the non-zero counts of all threads, ordered by text, location, and operator
+  std::vector<PerformanceWarningCount> snapshot() const;
+
+  // returns how often call sites with the given text were hit, e.g., "operator[] used"
+  uint64_t hit_count(const std::string& text) const;
+
+  // writes the snapshot in the text format of Prometheus, one counter per line
+  void write_snapshot(std::ostream& out) const;
+
+  // Sets all counts to zero. Should be called while no warnings are counted.
+  void reset();
+
+  // registers an operator name and returns its id, which PerformanceWarningScope takes
+  size_t register_operator(const std::string& name);
+
+  // returns the id of the operator that the calling thread works for, or 0 if there is none
+  static size_t current_operator();
+
+  PerformanceWarningRegistry(PerformanceWarningRegistry&&) = delete;
 
  protected:
-  static bool disable() {
-    bool previous = PerformanceWarningClass::disabled();
-    PerformanceWarningClass::disabled() = true;
-    return previous;
-  }
+  PerformanceWarningRegistry();
+
+  struct Site {
+    std::string text;
+    std::string location;
+  };
+
+  struct ThreadCounts {
+    // the counts per site and operator, whose nodes stay in place so that the calling thread can keep a pointer to the
+    // count that it incremented last
+    std::map<std::pair<size_t, size_t>, std::atomic<uint64_t>> counts;
+    // only contended by a snapshot or reset, and when the thread hits a site from an operator for the first time
+    std::mutex mutex;
+  };
 
-  static void enable() { PerformanceWarningClass::disabled() = false; }
+  // returns the counts of the calling thread, which are created when the thread hits its first site
+  ThreadCounts& _thread_counts();
+
+  static bool _disable();
+  static void _enable();
 
   friend class PerformanceWarningDisabler;
+  friend class PerformanceWarningScope;
+
+  mutable std::mutex _mutex;
+  std::vector<Site> _sites;
+  std::vector<std::string> _operator_names;
+  std::map<std::string, size_t> _operator_ids;
+  std::vector<std::shared_ptr<ThreadCounts>> _thread_counts_list;
 };
 
-class PerformanceWarningDisabler {
+// Attributes the warnings of the calling thread to an operator from its construction to its destruction. Operators
+// set it while they are executed, and parallel_for in the jobs that run on their behalf.
+class PerformanceWarningScope : private Noncopyable {
+ public:
+  explicit PerformanceWarningScope(const size_t operator_id);
+  ~PerformanceWarningScope();
+
+ protected:
+  const size_t _previous_operator_id;
+};
+
+class PerformanceWarningDisabler : private Noncopyable {
   bool _previously_disabled;
 
  public:
-  PerformanceWarningDisabler() : _previously_disabled(PerformanceWarningClass::disable()) {}
+  PerformanceWarningDisabler() : _previously_disabled(PerformanceWarningRegistry::_disable()) {}
   ~PerformanceWarningDisabler() {
-    if (!_previously_disabled) PerformanceWarningClass::enable();
+    if (!_previously_disabled) PerformanceWarningRegistry::_enable();
   }
 };
 
-#if IS_DEBUG
+}  // namespace opossum
+
 #ifndef __FILENAME__
 #define __FILENAME__ (__FILE__ + SOURCE_PATH_SIZE)
 #endif
-#define PerformanceWarning(text)                                                                 \
-  {                                                                                              \
-    static PerformanceWarningClass warn(std::string(text) + " at " + std::string(__FILENAME__) + \
-                                        ":" BOOST_PP_STRINGIZE(__LINE__));                       \
+#define PerformanceWarning(text)                                                                                 \
+  {                                                                                                              \
+    static const auto performance_warning_site =                                                                 \
+        opossum::PerformanceWarningRegistry::get().register_site(text, __FILENAME__, __LINE__);                  \
+    opossum::PerformanceWarningRegistry::get().record(performance_warning_site);                                 \
   }  // NOLINT
-#else
-#define PerformanceWarning(text)
-#endif
@@ -0,0 +1,134 @@
+#include "tracer.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+namespace {
+
+// writes the string as a JSON string literal
+void write_json_string(std::ostream& out, const std::string& string) {
+  out << '"';
+  for (const auto character : string) {
+    if (character == '"' || character == '\\') {
+      out << '\\' << character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec
+          << std::setfill(' ');
+    } else {
+      out << character;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+Tracer& Tracer::get() {
+  static Tracer instance;
+  return instance;
+}
+
+Tracer::Tracer() : _start(std::chrono::steady_clock::now()) {}
+
+void Tracer::enable(const size_t buffer_capacity) {
+  _buffer_capacity = buffer_capacity;
+  _enabled = true;
+}
+
+void Tracer::disable() { _enabled = false; }
+
+void Tracer::clear() {
+  const auto lock = std::lock_guard<std::mutex>{_buffers_mutex};
+  for (const auto& buffer : _buffers) {
+    const auto buffer_lock = std::lock_guard<std::mutex>{buffer->mutex};
+    buffer->events.clear();
+    buffer->next_index = 0;
+  }
+}
+
+std::chrono::nanoseconds Tracer::now() const { return std::chrono::steady_clock::now() - _start; }
+
+Tracer::ThreadBuffer& Tracer::_thread_buffer() {
+  // Buffers are never removed, so that the pointer stays valid for the lifetime of the thread.
+  thread_local ThreadBuffer* thread_buffer = nullptr;
+  if (!thread_buffer) {
+    const auto lock = std::lock_guard<std::mutex>{_buffers_mutex};
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->thread_number = _buffers.size();
+    buffer->capacity = std::max(_buffer_capacity.load(), size_t{1});
+    thread_buffer = buffer.get();
+    _buffers.emplace_back(std::move(buffer));
+  }
+  return *thread_buffer;
+}
+
+void Tracer::record(const char* category, std::string name, const std::chrono::nanoseconds begin) {
+  const auto duration = now() - begin;
+  auto& buffer = _thread_buffer();
+  const auto lock = std::lock_guard<std::mutex>{buffer.mutex};
+  auto event = Event{category, std::move(name), begin, duration};
+  if (buffer.events.size() < buffer.capacity) {
+    buffer.events.emplace_back(std::move(event));
+  } else {
+    buffer.events[buffer.next_index] = std::move(event);
+    buffer.next_index = (buffer.next_index + 1) % buffer.capacity;
+  }
+}
+
+void Tracer::write_chrome_trace(std::ostream& out) const {
+  const auto lock = std::lock_guard<std::mutex>{_buffers_mutex};
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  const auto fill = out.fill();
+
+  // timestamps and durations are written in microseconds
+  const auto micros = [](const std::chrono::nanoseconds nanoseconds) {
+    return std::chrono::duration<double, std::micro>{nanoseconds}.count();
+  };
+
+  out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  auto first_event = true;
+  for (const auto& buffer : _buffers) {
+    const auto buffer_lock = std::lock_guard<std::mutex>{buffer->mutex};
+    const auto event_count = buffer->events.size();
+    for (auto offset = size_t{0}; offset < event_count; ++offset) {
+      // Starts with the oldest event, which is the one that is overwritten next if the ring is full. Spans are recorded
+      // when they end, so that nested spans precede the spans that contain them.
+      const auto& event = buffer->events[(buffer->next_index + offset) % event_count];
+      out << (first_event ? "\n" : ",\n");
+      first_event = false;
+
+      out << "{\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"cat\":";
+      write_json_string(out, event.category);
+      out << ",\"ph\":\"X\",\"ts\":" << micros(event.begin) << ",\"dur\":" << micros(event.duration)
+          << ",\"pid\":1,\"tid\":" << buffer->thread_number << "}";
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+
+  out.flags(flags);
+  out.precision(precision);
+  out.fill(fill);
+}
+
+size_t Tracer::event_count() const {
+  const auto lock = std::lock_guard<std::mutex>{_buffers_mutex};
+  auto event_count = size_t{0};
+  for (const auto& buffer : _buffers) {
+    const auto buffer_lock = std::lock_guard<std::mutex>{buffer->mutex};
+    event_count += buffer->events.size();
+  }
+  return event_count;
+}
+
+}  // namespace opossum
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * The Tracer records when operators, parallel_for morsels, segment compressions, and the stages of load_table begin
+ * and end on which thread, e.g., to find stragglers among the jobs of an operator. The events are exported in the
+ * trace event format of Chrome, which about://tracing and Perfetto display as one timeline per thread.
+ *
+ * Tracing is disabled by default. Then, recording a span costs a single branch. Otherwise, each thread records its
+ * spans into its own ring buffer, which overwrites the oldest spans once it is full. Each span is recorded as one
+ * complete event when it ends, so that overwriting never leaves a begin without its end or vice versa. The buffers are
+ * only shared with the export, so that threads do not contend while recording.
+ */
+class Tracer : private Noncopyable {
+ public:
+  // the number of spans that each thread keeps
+  static constexpr size_t DEFAULT_BUFFER_CAPACITY = 64 * 1024;
+
+  static Tracer& get();
+
+  static bool is_enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+  // Enables recording. Buffers that are created afterwards, i.e., by threads that record their first span, keep the
+  // given number of spans.
+  void enable(const size_t buffer_capacity = DEFAULT_BUFFER_CAPACITY);
+  void disable();
+
+  // removes all recorded events
+  void clear();
+
+  // returns the time since the tracer was created, which spans use as their begin
+  std::chrono::nanoseconds now() const;
+
+  // Records a span of the calling thread that began at the given time and ends now, usually via a TraceScope. The
+  // category groups the spans, e.g., "operator" or "job".
+  void record(const char* category, std::string name, const std::chrono::nanoseconds begin);
+
+  // Writes the recorded spans of all threads as a JSON object in Chrome's trace event format. The threads are
+  // numbered in the order in which they recorded their first span. Should be called while no spans are recorded. The
+  // formatting flags of the stream are left unchanged.
+  void write_chrome_trace(std::ostream& out) const;
+
+  // returns the number of recorded spans of all threads
+  size_t event_count() const;
+
+  Tracer(Tracer&&) = delete;
+
+ protected:
+  Tracer();
+
+  struct Event {
+    const char* category;
+    std::string name;
+    std::chrono::nanoseconds begin;
+    std::chrono::nanoseconds duration;
+  };
+
+  struct ThreadBuffer {
+    size_t thread_number;
+    // all events of the thread if it recorded fewer than the capacity, otherwise a ring whose oldest event is at
+    // next_index
+    std::vector<Event> events;
+    size_t capacity;
+    size_t next_index = 0;
+    // only contended by an export or clear
+    std::mutex mutex;
+  };
+
+  // returns the buffer of the calling thread, which is created when the thread records its first span
+  ThreadBuffer& _thread_buffer();
+
+  inline static std::atomic<bool> _enabled{false};
+
+  const std::chrono::steady_clock::time_point _start;
+  std::atomic<size_t> _buffer_capacity{DEFAULT_BUFFER_CAPACITY};
+
+  mutable std::mutex _buffers_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+};
+
+// Records a span from its construction to its destruction if tracing is enabled. The name is either a string or a
+// function that returns it, which is only called if tracing is enabled, so that it is not built otherwise.
+class TraceScope : private Noncopyable {
+ public:
+  template <typename Name>
+  TraceScope(const char* category, const Name& name) : _category(Tracer::is_enabled() ? category : nullptr) {
+    if (!_category) return;
+    if constexpr (std::is_invocable_v<Name>) {
+      _name = name();
+    } else {
+      _name = name;
+    }
+    _begin = Tracer::get().now();
+  }
+
+  ~TraceScope() {
+    if (_category) Tracer::get().record(_category, std::move(_name), _begin);
+  }
+
+ protected:
+  // nullptr if tracing was disabled when the span began
+  const char* const _category;
+  std::string _name;
+  std::chrono::nanoseconds _begin{0};
+};
+
+}  // namespace opossum
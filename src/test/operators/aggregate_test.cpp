@@ -0,0 +1,217 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // the first chunk is dictionary-encoded, so that both the dictionary and the hash path are used
+    _table = load_table("src/test/tables/aggregate_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<const Table> aggregate(const std::vector<AggregateColumnDefinition>& aggregates,
+                                         const std::vector<ColumnID>& groupby_column_ids) {
+    auto aggregate = std::make_shared<Aggregate>(_table_wrapper, aggregates, groupby_column_ids);
+    aggregate->execute();
+    return aggregate->get_output();
+  }
+
+  // Left joins 1, 2, and 3 with the given values of b for 1 and 3, so that b is NULL for 2. The columns of the output
+  // are the left a, the right a, and b.
+  static std::shared_ptr<JoinHash> left_join_with_null(const int32_t b_of_1, const int32_t b_of_3) {
+    auto left_table = std::make_shared<Table>();
+    left_table->add_column("a", "int");
+    for (auto value = 1; value <= 3; ++value) left_table->append({value});
+    auto right_table = std::make_shared<Table>();
+    right_table->add_column("a", "int");
+    right_table->add_column("b", "int");
+    right_table->append({1, b_of_1});
+    right_table->append({3, b_of_3});
+    auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+    left_wrapper->execute();
+    auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+    right_wrapper->execute();
+
+    auto join = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Left,
+                                           std::make_pair(ColumnID{0}, ColumnID{0}));
+    join->execute();
+    return join;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAggregateTest, GroupByOneColumn) {
+  const auto output = aggregate({{ColumnID{2}, AggregateFunction::Sum},
+                                 {std::nullopt, AggregateFunction::Count},
+                                 {ColumnID{1}, AggregateFunction::Min},
+                                 {ColumnID{2}, AggregateFunction::Max},
+                                 {ColumnID{2}, AggregateFunction::Avg}},
+                                {ColumnID{0}});
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/aggregate_groupby_a_result.tbl", 10));
+}
+
+TEST_F(OperatorsAggregateTest, GroupByTwoColumns) {
+  const auto output = aggregate({{ColumnID{0}, AggregateFunction::Sum}, {ColumnID{2}, AggregateFunction::Count}},
+                                {ColumnID{0}, ColumnID{1}});
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/aggregate_groupby_a_b_result.tbl", 10));
+}
+
+TEST_F(OperatorsAggregateTest, NoGroupByColumns) {
+  const auto output = aggregate({{ColumnID{0}, AggregateFunction::Sum}, {ColumnID{1}, AggregateFunction::Max}}, {});
+  ASSERT_EQ(output->row_count(), 1u);
+  const auto& chunk = output->get_chunk(ChunkID{0});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[0], AllTypeVariant{int64_t{10}});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[0], AllTypeVariant{"z"});
+}
+
+TEST_F(OperatorsAggregateTest, EmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+
+  // without group-by columns, there is one row for the aggregates of no rows
+  auto count = std::make_shared<Aggregate>(scan, std::vector<AggregateColumnDefinition>{{std::nullopt,
+                                                                                        AggregateFunction::Count}},
+                                           std::vector<ColumnID>{});
+  count->execute();
+  ASSERT_EQ(count->get_output()->row_count(), 1u);
+  EXPECT_EQ((*count->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0], AllTypeVariant{int64_t{0}});
+
+  auto group_by = std::make_shared<Aggregate>(scan, std::vector<AggregateColumnDefinition>{}, std::vector{ColumnID{0}});
+  group_by->execute();
+  EXPECT_EQ(group_by->get_output()->row_count(), 0u);
+  EXPECT_EQ(group_by->get_output()->get_chunk(ChunkID{0}).column_count(), 1u);
+}
+
+TEST_F(OperatorsAggregateTest, ReferenceInputAndDeletedRows) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({0});
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 2.0f);
+  scan->execute();
+
+  auto aggregate = std::make_shared<Aggregate>(
+      scan, std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count}}, std::vector{ColumnID{0}});
+  aggregate->execute();
+  // the groups 1, 2, and 3 with two, two, and one rows
+  EXPECT_EQ(aggregate->get_output()->row_count(), 3u);
+
+  const auto output = this->aggregate({{std::nullopt, AggregateFunction::Count}}, {ColumnID{1}});
+  // x only has one row left, which is the row 1 | x | 3.0
+  EXPECT_EQ(output->row_count(), 3u);
+}
+
+TEST_F(OperatorsAggregateTest, SkipsRowsDeletedAfterReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 2.0f);
+  scan->execute();
+  // the row 3 | y | 4.0 is deleted after the scan referenced it
+  _table->get_chunk(ChunkID{0}).invalidate_rows({3});
+
+  auto group_by = std::make_shared<Aggregate>(
+      scan, std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count}}, std::vector{ColumnID{0}});
+  group_by->execute();
+  EXPECT_EQ(group_by->get_output()->row_count(), 2u);
+
+  auto count = std::make_shared<Aggregate>(
+      scan, std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count}}, std::vector<ColumnID>{});
+  count->execute();
+  EXPECT_EQ((*count->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0], AllTypeVariant{int64_t{4}});
+}
+
+TEST_F(OperatorsAggregateTest, SkipsNullValues) {
+  auto aggregate = std::make_shared<Aggregate>(
+      left_join_with_null(1, 3),
+      std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count},
+                                             {ColumnID{2}, AggregateFunction::Count},
+                                             {ColumnID{2}, AggregateFunction::Sum},
+                                             {ColumnID{2}, AggregateFunction::Min},
+                                             {ColumnID{2}, AggregateFunction::Max},
+                                             {ColumnID{2}, AggregateFunction::Avg}},
+      std::vector<ColumnID>{});
+  aggregate->execute();
+
+  // only COUNT(*) counts the row of 2, whose b is NULL
+  const auto& chunk = aggregate->get_output()->get_chunk(ChunkID{0});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[0], AllTypeVariant{int64_t{3}});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[0], AllTypeVariant{int64_t{2}});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{2}))[0], AllTypeVariant{int64_t{4}});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{3}))[0], AllTypeVariant{1});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{4}))[0], AllTypeVariant{3});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{5}))[0], AllTypeVariant{2.0});
+}
+
+TEST_F(OperatorsAggregateTest, SkipsNullGroups) {
+  auto aggregate = std::make_shared<Aggregate>(
+      left_join_with_null(0, 3), std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count}},
+      std::vector{ColumnID{2}});
+  aggregate->execute();
+
+  // the row of 2, whose b is NULL, is not merged into the group of 0
+  const auto output = aggregate->get_output();
+  ASSERT_EQ(output->row_count(), 2u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[chunk_offset], AllTypeVariant{int64_t{1}});
+    }
+  }
+}
+
+TEST_F(OperatorsAggregateTest, ManyGroups) {
+  // large enough for the groups to be merged in several partitions
+  auto table = std::make_shared<Table>(10'000);
+  table->add_column("a", "long");
+  table->add_column("b", "int");
+  for (auto value = int64_t{0}; value < 100'000; ++value) {
+    table->append({value % 30'000, static_cast<int32_t>(value % 7)});
+  }
+  table->compress_chunk(ChunkID{3});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count},
+                                             {ColumnID{0}, AggregateFunction::Sum}},
+      std::vector{ColumnID{0}});
+  aggregate->execute();
+  const auto output = aggregate->get_output();
+  EXPECT_EQ(output->row_count(), 30'000u);
+
+  auto total_count = int64_t{0};
+  auto total_sum = int64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      total_count += type_cast<int64_t>((*chunk.get_segment(ColumnID{1}))[chunk_offset]);
+      total_sum += type_cast<int64_t>((*chunk.get_segment(ColumnID{2}))[chunk_offset]);
+    }
+  }
+  EXPECT_EQ(total_count, 100'000);
+  // 0 + ... + 29'999 three times and 0 + ... + 9'999 once more
+  EXPECT_EQ(total_sum, 3 * (int64_t{29'999} * 30'000 / 2) + int64_t{9'999} * 10'000 / 2);
+}
+
+TEST_F(OperatorsAggregateTest, RejectsSumOfStrings) {
+  auto aggregate = std::make_shared<Aggregate>(
+      _table_wrapper, std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Sum}},
+      std::vector<ColumnID>{});
+  EXPECT_THROW(aggregate->execute(), std::logic_error);
+}
+
+}  // namespace opossum
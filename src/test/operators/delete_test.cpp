@@ -0,0 +1,66 @@
+#include <memory>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/delete.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsDeleteTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (auto value = 0; value < 8; ++value) _table->append({value, "row"});
+    _table->compress_chunk(ChunkID{0});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsDeleteTest, DeletesScannedRows) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 2);
+  scan->execute();
+  auto delete_rows = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpLessThan, 5);
+  delete_rows->execute();
+
+  auto delete_operator = std::make_shared<Delete>(delete_rows);
+  delete_operator->execute();
+  EXPECT_EQ(delete_operator->get_output()->row_count(), 3u);
+
+  EXPECT_EQ(_table->row_count(), 8u);
+  EXPECT_EQ(_table->approx_valid_row_count(), 5u);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0}).is_valid(1));
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0}).is_valid(2));
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1}).is_valid(1));
+
+  auto scan_all = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpEquals, "row");
+  scan_all->execute();
+  EXPECT_EQ(scan_all->get_output()->row_count(), 5u);
+}
+
+TEST_F(OperatorsDeleteTest, DeleteEmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+
+  auto delete_operator = std::make_shared<Delete>(scan);
+  delete_operator->execute();
+  EXPECT_EQ(_table->approx_valid_row_count(), 8u);
+}
+
+TEST_F(OperatorsDeleteTest, RejectsDataTables) {
+  auto delete_operator = std::make_shared<Delete>(_table_wrapper);
+  EXPECT_THROW(delete_operator->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,117 @@
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/fused_table_scan.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsFusedTableScanTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsFusedTableScanTest, MatchesTableScans) {
+  auto fused_scan = make_fused_table_scan(_table_wrapper, ScanPredicate<int32_t, std::greater<>>{ColumnID{0}, 1},
+                                          ScanPredicate<std::string, std::not_equal_to<>>{ColumnID{1}, "cherry"});
+  fused_scan->execute();
+
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpNotEquals, std::string{"cherry"});
+  scan_b->execute();
+
+  const auto& output = *fused_scan->get_output();
+  EXPECT_EQ(output.column_names(), _table->column_names());
+  EXPECT_EQ(column_values<float>(output, ColumnID{2}), (std::vector<float>{1.5f, 0.5f, 3.0f}));
+  EXPECT_EQ(column_values<float>(output, ColumnID{2}), column_values<float>(*scan_b->get_output(), ColumnID{2}));
+
+  // the output references the input table directly
+  const auto& segment = static_cast<const ReferenceSegment&>(*output.get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_EQ(segment.referenced_table(), _table);
+}
+
+TEST_F(OperatorsFusedTableScanTest, ReferenceInputAndDeletedRows) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 0.0f);
+  scan->execute();
+  _table->get_chunk(ChunkID{1}).invalidate_rows({1});
+
+  auto fused_scan = make_fused_table_scan(scan, ScanPredicate<std::string, std::equal_to<>>{ColumnID{1}, "apple"},
+                                          ScanPredicate<float, std::less<>>{ColumnID{2}, 10.0f});
+  fused_scan->execute();
+  EXPECT_EQ(column_values<float>(*fused_scan->get_output(), ColumnID{2}), (std::vector<float>{2.5f, 0.5f}));
+}
+
+TEST_F(OperatorsFusedTableScanTest, RemovesNullRowsOfAllPredicates) {
+  auto left_table = std::make_shared<Table>();
+  left_table->add_column("a", "int");
+  left_table->append({1});
+  left_table->append({2});
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("a", "int");
+  right_table->add_column("b", "int");
+  right_table->append({1, 3});
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  right_wrapper->execute();
+
+  // b is NULL for 2, which does not match b < 5 even though the default value of the column would
+  auto join = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Left,
+                                         std::make_pair(ColumnID{0}, ColumnID{0}));
+  auto fused_scan = make_fused_table_scan(join, ScanPredicate<int32_t, std::greater<>>{ColumnID{0}, 0},
+                                          ScanPredicate<int32_t, std::less<>>{ColumnID{2}, 5});
+  fused_scan->execute();
+
+  EXPECT_EQ(column_values<int32_t>(*fused_scan->get_output(), ColumnID{0}), std::vector<int32_t>{1});
+}
+
+TEST_F(OperatorsFusedTableScanTest, EmptyResultAndRowLimit) {
+  auto empty_scan = make_fused_table_scan(_table_wrapper, ScanPredicate<int32_t, std::greater<>>{ColumnID{0}, 3});
+  empty_scan->execute();
+  EXPECT_EQ(empty_scan->get_output()->chunk_count(), 1u);
+  EXPECT_EQ(empty_scan->get_output()->row_count(), 0u);
+
+  auto limited_scan = make_fused_table_scan(_table_wrapper, ScanPredicate<int32_t, std::less<>>{ColumnID{0}, 3});
+  limited_scan->set_row_limit(1);
+  limited_scan->execute();
+  EXPECT_EQ(limited_scan->get_output()->chunk_count(), 1u);
+}
+
+TEST_F(OperatorsFusedTableScanTest, RejectsWrongDataType) {
+  auto fused_scan = make_fused_table_scan(_table_wrapper, ScanPredicate<int64_t, std::greater<>>{ColumnID{0}, 1});
+  EXPECT_THROW(fused_scan->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -4,32 +4,56 @@
 #include "gtest/gtest.h"
 
 #include "operators/get_table.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
 // The fixture for testing class GetTable.
-// class OperatorsGetTableTest : public BaseTest {
-//  protected:
-//   void SetUp() override {
-//     _test_table = std::make_shared<Table>(2);
-//     StorageManager::get().add_table("aNiceTestTable", _test_table);
-//   }
-
-//   std::shared_ptr<Table> _test_table;
-// };
-
-// TEST_F(OperatorsGetTableTest, GetOutput) {
-//   auto gt = std::make_shared<GetTable>("aNiceTestTable");
-//   gt->execute();
-
-//   EXPECT_EQ(gt->get_output(), _test_table);
-// }
-
-// TEST_F(OperatorsGetTableTest, ThrowsUnknownTableName) {
-//   auto gt = std::make_shared<GetTable>("anUglyTestTable");
-
-//   EXPECT_THROW(gt->execute(), std::exception) << "Should throw unknown table name exception";
-// }
+class OperatorsGetTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _test_table = std::make_shared<Table>(2);
+    StorageManager::get().add_table("aNiceTestTable", _test_table);
+  }
+
+  std::shared_ptr<Table> _test_table;
+};
+
+TEST_F(OperatorsGetTableTest, GetOutput) {
+  auto gt = std::make_shared<GetTable>("aNiceTestTable");
+  gt->execute();
+
+  EXPECT_EQ(gt->get_output(), _test_table);
+}
+
+TEST_F(OperatorsGetTableTest, ThrowsUnknownTableName) {
+  auto gt = std::make_shared<GetTable>("anUglyTestTable");
+
+  EXPECT_THROW(gt->execute(), std::exception) << "Should throw unknown table name exception";
+}
+
+TEST_F(OperatorsGetTableTest, RowLimit) {
+  _test_table->add_column("a", "int");
+  for (auto value = 0; value < 10; ++value) {
+    _test_table->append({value});
+  }
+  _test_table->get_chunk(ChunkID{0}).invalidate_rows({1});
+
+  auto gt = std::make_shared<GetTable>("aNiceTestTable");
+  gt->set_row_limit(3);
+  gt->execute();
+
+  const auto output = gt->get_output();
+  ASSERT_EQ(output->row_count(), 3u);
+  const auto segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _test_table);
+  EXPECT_EQ(get_segment_value<int32_t>(*segment, 0), 0);
+  EXPECT_EQ(get_segment_value<int32_t>(*segment, 1), 2);
+  EXPECT_EQ(get_segment_value<int32_t>(*segment, 2), 3);
+}
 
 }  // namespace opossum
@@ -0,0 +1,198 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/limit.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsJoinHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table_a = load_table("src/test/tables/join_input_a.tbl", 2);
+    _table_a->compress_chunk(ChunkID{0});
+    _table_wrapper_a = std::make_shared<TableWrapper>(_table_a);
+    _table_wrapper_a->execute();
+
+    _table_wrapper_b = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_b.tbl", 3));
+    _table_wrapper_b->execute();
+  }
+
+  std::shared_ptr<const Table> join(const JoinMode mode) {
+    auto join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, mode, _column_ids);
+    join->execute();
+    return join->get_output();
+  }
+
+  const std::pair<ColumnID, ColumnID> _column_ids{ColumnID{0}, ColumnID{0}};
+  std::shared_ptr<Table> _table_a;
+  std::shared_ptr<TableWrapper> _table_wrapper_a, _table_wrapper_b;
+};
+
+TEST_F(OperatorsJoinHashTest, InnerJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Inner), load_table("src/test/tables/join_inner_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinHashTest, LeftJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Left), load_table("src/test/tables/join_left_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinHashTest, SemiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Semi), load_table("src/test/tables/join_semi_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinHashTest, AntiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Anti), load_table("src/test/tables/join_anti_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinHashTest, OutputReferencesDataTables) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpGreaterThan, 2);
+  scan->execute();
+  auto join = std::make_shared<JoinHash>(scan, _table_wrapper_b, JoinMode::Inner, _column_ids);
+  join->execute();
+
+  const auto output = join->get_output();
+  EXPECT_EQ(output->row_count(), 1u);
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_a);
+  EXPECT_EQ((*segment)[0], AllTypeVariant{"three"});
+}
+
+TEST_F(OperatorsJoinHashTest, SkipsDeletedRows) {
+  _table_a->get_chunk(ChunkID{1}).invalidate_rows({0});
+  EXPECT_EQ(join(JoinMode::Inner)->row_count(), 3u);
+  EXPECT_EQ(join(JoinMode::Anti)->row_count(), 2u);
+}
+
+TEST_F(OperatorsJoinHashTest, EmptyResult) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  auto join = std::make_shared<JoinHash>(_table_wrapper_a, scan, JoinMode::Inner, _column_ids);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 0u);
+  EXPECT_EQ(join->get_output()->get_chunk(ChunkID{0}).column_count(), 4u);
+}
+
+TEST_F(OperatorsJoinHashTest, NullJoinKeys) {
+  // the left join leaves c NULL for 1 | one and 5 | five, which never match, but left and anti joins keep them
+  auto left_join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Left, _column_ids);
+  left_join->execute();
+  const auto join_on_c = [&](const JoinMode mode) {
+    auto join = std::make_shared<JoinHash>(left_join, _table_wrapper_b, mode, std::make_pair(ColumnID{2}, ColumnID{0}));
+    join->execute();
+    return join->get_output()->row_count();
+  };
+  EXPECT_EQ(join_on_c(JoinMode::Inner), 9u);
+  EXPECT_EQ(join_on_c(JoinMode::Left), 11u);
+  EXPECT_EQ(join_on_c(JoinMode::Semi), 5u);
+  EXPECT_EQ(join_on_c(JoinMode::Anti), 2u);
+}
+
+TEST_F(OperatorsJoinHashTest, ManyPartitions) {
+  // large enough for the build side to be radix-partitioned
+  auto left_table = std::make_shared<Table>(10'000);
+  left_table->add_column("a", "long");
+  auto right_table = std::make_shared<Table>(10'000);
+  right_table->add_column("b", "long");
+  for (auto value = int64_t{0}; value < 100'000; ++value) {
+    left_table->append({value});
+    if (value % 3 == 0) right_table->append({value / 2});
+  }
+
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  right_wrapper->execute();
+
+  auto join = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Semi, _column_ids);
+  join->execute();
+  // the right side contains the values 3k and 3k + 1 below 50'000
+  EXPECT_EQ(join->get_output()->row_count(), 33'334u);
+}
+
+TEST_F(OperatorsJoinHashTest, BloomFilterPushdown) {
+  // the left table mixes dictionary and value segments, the right table contains 10 of its values
+  auto left_table = std::make_shared<Table>(1'000);
+  left_table->add_column("a", "int");
+  auto right_table = std::make_shared<Table>(1'000);
+  right_table->add_column("b", "int");
+  for (auto value = 0; value < 10'000; ++value) {
+    left_table->append({value});
+    if (value % 1'000 == 7) right_table->append({value});
+  }
+  left_table->compress_chunk(ChunkID{0});
+  left_table->compress_chunk(ChunkID{1});
+
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+
+  const auto scan_and_join = [&](const JoinMode mode, const bool execute_right_first) {
+    auto left_scan = std::make_shared<TableScan>(left_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 0);
+    auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+    auto join = std::make_shared<JoinHash>(left_scan, right_wrapper, mode, _column_ids);
+    if (execute_right_first) right_wrapper->execute();
+    left_scan->execute();
+    if (!execute_right_first) right_wrapper->execute();
+    join->execute();
+    return std::make_pair(left_scan->get_output()->row_count(), join->get_output()->row_count());
+  };
+
+  // the filter may let a few rows pass that have no join partner
+  for (const auto mode : {JoinMode::Inner, JoinMode::Semi}) {
+    const auto [scan_row_count, join_row_count] = scan_and_join(mode, true);
+    EXPECT_GE(scan_row_count, 10u);
+    EXPECT_LT(scan_row_count, 100u);
+    EXPECT_EQ(join_row_count, 10u);
+  }
+
+  // without the output of the right input, the scan cannot be reduced
+  EXPECT_EQ(scan_and_join(JoinMode::Inner, false), std::make_pair(size_t{10'000}, size_t{10}));
+
+  // left joins need all left rows
+  EXPECT_EQ(scan_and_join(JoinMode::Left, true), std::make_pair(size_t{10'000}, size_t{10'000}));
+
+  // other consumers of the scan need all of its rows
+  auto left_scan = std::make_shared<TableScan>(left_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 0);
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  auto join = std::make_shared<JoinHash>(left_scan, right_wrapper, JoinMode::Inner, _column_ids);
+  auto limit = std::make_shared<Limit>(left_scan, 20'000);
+  EXPECT_TRUE(left_scan->execute_after_operators().empty());
+  join->execute();
+  limit->execute();
+  EXPECT_EQ(left_scan->get_output()->row_count(), 10'000u);
+  EXPECT_EQ(join->get_output()->row_count(), 10u);
+  EXPECT_EQ(limit->get_output()->row_count(), 10'000u);
+}
+
+TEST_F(OperatorsJoinHashTest, BuildsBloomFilterOnce) {
+  auto join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Inner, _column_ids);
+  const auto bloom_filter = join->build_bloom_filter();
+  ASSERT_TRUE(bloom_filter);
+  EXPECT_EQ(join->build_bloom_filter(), bloom_filter);
+
+  // the join uses the keys that were materialized for the filter
+  join->execute();
+  EXPECT_TABLE_EQ(join->get_output(), load_table("src/test/tables/join_inner_result.tbl", 10));
+  EXPECT_EQ(join->build_bloom_filter(), bloom_filter);
+}
+
+TEST_F(OperatorsJoinHashTest, RejectsDifferentTypes) {
+  auto join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Inner,
+                                         std::make_pair(ColumnID{0}, ColumnID{1}));
+  EXPECT_THROW(join->execute(), std::logic_error);
+}
+
+}  // namespace opossum
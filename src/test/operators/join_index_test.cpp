@@ -0,0 +1,119 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsJoinIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table_wrapper_a = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_a.tbl", 2));
+    _table_wrapper_a->execute();
+
+    // the first chunk is indexed, the second one is joined through the hash table
+    _table_b = load_table("src/test/tables/join_input_b.tbl", 3);
+    _table_b->compress_chunk(ChunkID{0});
+    _table_b->create_index(ColumnID{0});
+    _table_wrapper_b = std::make_shared<TableWrapper>(_table_b);
+    _table_wrapper_b->execute();
+  }
+
+  std::shared_ptr<const Table> join(const JoinMode mode) {
+    auto join = std::make_shared<JoinIndex>(_table_wrapper_a, _table_wrapper_b, mode, _column_ids);
+    join->execute();
+    return join->get_output();
+  }
+
+  const std::pair<ColumnID, ColumnID> _column_ids{ColumnID{0}, ColumnID{0}};
+  std::shared_ptr<Table> _table_b;
+  std::shared_ptr<TableWrapper> _table_wrapper_a, _table_wrapper_b;
+};
+
+TEST_F(OperatorsJoinIndexTest, InnerJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Inner), load_table("src/test/tables/join_inner_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinIndexTest, LeftJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Left), load_table("src/test/tables/join_left_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinIndexTest, SemiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Semi), load_table("src/test/tables/join_semi_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinIndexTest, AntiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Anti), load_table("src/test/tables/join_anti_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinIndexTest, SkipsDeletedRows) {
+  // deletes the row 2 | 2.25 from the indexed chunk
+  _table_b->get_chunk(ChunkID{0}).invalidate_rows({1});
+  EXPECT_EQ(join(JoinMode::Inner)->row_count(), 3u);
+}
+
+TEST_F(OperatorsJoinIndexTest, ReferenceInputs) {
+  // the output of a scan has no indexes, so that all of its chunks are joined through the hash table
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan_a->execute();
+  auto scan_b = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::OpLessThan, 3);
+  scan_b->execute();
+  auto join = std::make_shared<JoinIndex>(scan_a, scan_b, JoinMode::Inner, _column_ids);
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 4u);
+}
+
+TEST_F(OperatorsJoinIndexTest, NullJoinKeys) {
+  // the left join leaves c NULL for 1 | one and 5 | five, which never match, but left and anti joins keep them
+  auto left_join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Left, _column_ids);
+  left_join->execute();
+  const auto join_on_c = [&](const JoinMode mode) {
+    const auto column_ids = std::make_pair(ColumnID{2}, ColumnID{0});
+    auto join = std::make_shared<JoinIndex>(left_join, _table_wrapper_b, mode, column_ids);
+    join->execute();
+    return join->get_output()->row_count();
+  };
+  EXPECT_EQ(join_on_c(JoinMode::Inner), 9u);
+  EXPECT_EQ(join_on_c(JoinMode::Left), 11u);
+  EXPECT_EQ(join_on_c(JoinMode::Semi), 5u);
+  EXPECT_EQ(join_on_c(JoinMode::Anti), 2u);
+}
+
+TEST_F(OperatorsJoinIndexTest, MatchesJoinHash) {
+  // large enough for the left input to be probed in several batches
+  auto left_table = std::make_shared<Table>(10'000);
+  left_table->add_column("a", "long");
+  auto right_table = std::make_shared<Table>(10'000);
+  right_table->add_column("b", "long");
+  for (auto value = int64_t{0}; value < 100'000; ++value) {
+    if (value % 5 == 0) left_table->append({(value * 7919) % 100'000});
+    right_table->append({value / 3});
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id + 1 < right_table->chunk_count(); ++chunk_id) {
+    right_table->compress_chunk(chunk_id);
+  }
+  right_table->create_index(ColumnID{0});
+
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  right_wrapper->execute();
+
+  auto join_index = std::make_shared<JoinIndex>(left_wrapper, right_wrapper, JoinMode::Inner, _column_ids);
+  join_index->execute();
+  auto join_hash = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Inner, _column_ids);
+  join_hash->execute();
+  EXPECT_TABLE_EQ(join_index->get_output(), join_hash->get_output());
+}
+
+}  // namespace opossum
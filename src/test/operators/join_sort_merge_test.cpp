@@ -0,0 +1,131 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsJoinSortMergeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table_a = load_table("src/test/tables/join_input_a.tbl", 2);
+    _table_a->compress_chunk(ChunkID{0});
+    _table_wrapper_a = std::make_shared<TableWrapper>(_table_a);
+    _table_wrapper_a->execute();
+
+    _table_wrapper_b = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_b.tbl", 3));
+    _table_wrapper_b->execute();
+  }
+
+  std::shared_ptr<const Table> join(const JoinMode mode, const ScanType scan_type = ScanType::OpEquals) {
+    auto join = std::make_shared<JoinSortMerge>(_table_wrapper_a, _table_wrapper_b, mode, _column_ids, scan_type);
+    join->execute();
+    return join->get_output();
+  }
+
+  const std::pair<ColumnID, ColumnID> _column_ids{ColumnID{0}, ColumnID{0}};
+  std::shared_ptr<Table> _table_a;
+  std::shared_ptr<TableWrapper> _table_wrapper_a, _table_wrapper_b;
+};
+
+TEST_F(OperatorsJoinSortMergeTest, InnerJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Inner), load_table("src/test/tables/join_inner_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, LeftJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Left), load_table("src/test/tables/join_left_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, SemiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Semi), load_table("src/test/tables/join_semi_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, AntiJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Anti), load_table("src/test/tables/join_anti_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, LessThanJoin) {
+  EXPECT_TABLE_EQ(join(JoinMode::Inner, ScanType::OpLessThan),
+                  load_table("src/test/tables/join_less_than_result.tbl", 10));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, AllScanTypes) {
+  // the left values are 1, 2, 2, 3, 5 and the right values are 2, 2, 3, 4
+  EXPECT_EQ(join(JoinMode::Inner, ScanType::OpNotEquals)->row_count(), 15u);
+  EXPECT_EQ(join(JoinMode::Inner, ScanType::OpLessThanEquals)->row_count(), 14u);
+  EXPECT_EQ(join(JoinMode::Inner, ScanType::OpGreaterThan)->row_count(), 6u);
+  EXPECT_EQ(join(JoinMode::Inner, ScanType::OpGreaterThanEquals)->row_count(), 11u);
+
+  EXPECT_EQ(join(JoinMode::Left, ScanType::OpGreaterThan)->row_count(), 9u);
+  EXPECT_EQ(join(JoinMode::Semi, ScanType::OpLessThan)->row_count(), 4u);
+  EXPECT_EQ(join(JoinMode::Anti, ScanType::OpLessThan)->row_count(), 1u);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, SkipsDeletedRows) {
+  _table_a->get_chunk(ChunkID{1}).invalidate_rows({0});
+  EXPECT_EQ(join(JoinMode::Inner)->row_count(), 3u);
+  EXPECT_EQ(join(JoinMode::Inner, ScanType::OpLessThan)->row_count(), 7u);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, EmptyResult) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  auto join = std::make_shared<JoinSortMerge>(_table_wrapper_a, scan, JoinMode::Inner, _column_ids,
+                                              ScanType::OpLessThan);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 0u);
+  EXPECT_EQ(join->get_output()->get_chunk(ChunkID{0}).column_count(), 4u);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, NullJoinKeys) {
+  // the left join leaves c NULL for 1 | one and 5 | five, which never match, but left and anti joins keep them
+  auto left_join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Left, _column_ids);
+  left_join->execute();
+  const auto join_on_c = [&](const JoinMode mode) {
+    const auto column_ids = std::make_pair(ColumnID{2}, ColumnID{0});
+    auto join = std::make_shared<JoinSortMerge>(left_join, _table_wrapper_b, mode, column_ids, ScanType::OpEquals);
+    join->execute();
+    return join->get_output()->row_count();
+  };
+  EXPECT_EQ(join_on_c(JoinMode::Inner), 9u);
+  EXPECT_EQ(join_on_c(JoinMode::Left), 11u);
+  EXPECT_EQ(join_on_c(JoinMode::Semi), 5u);
+  EXPECT_EQ(join_on_c(JoinMode::Anti), 2u);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, MatchesJoinHash) {
+  // large enough for the keys to be merged and joined in several ranges
+  auto left_table = std::make_shared<Table>(10'000);
+  left_table->add_column("a", "long");
+  auto right_table = std::make_shared<Table>(10'000);
+  right_table->add_column("b", "long");
+  for (auto value = int64_t{0}; value < 100'000; ++value) {
+    left_table->append({(value * 7919) % 100'000});
+    if (value % 3 == 0) right_table->append({value / 2});
+  }
+
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  right_wrapper->execute();
+
+  auto join_sort_merge =
+      std::make_shared<JoinSortMerge>(left_wrapper, right_wrapper, JoinMode::Inner, _column_ids, ScanType::OpEquals);
+  join_sort_merge->execute();
+  auto join_hash = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Inner, _column_ids);
+  join_hash->execute();
+  EXPECT_TABLE_EQ(join_sort_merge->get_output(), join_hash->get_output());
+}
+
+}  // namespace opossum
@@ -0,0 +1,141 @@
+#include <memory>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expressions.hpp"
+#include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/limit.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsLimitTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 100 chunks, the first one is dictionary-encoded
+    _table = std::make_shared<Table>(100);
+    _table->add_column("a", "int");
+    for (auto value = 0; value < 10'000; ++value) {
+      _table->append({value});
+    }
+    _table->compress_chunk(ChunkID{0});
+    StorageManager::get().add_table("table", _table);
+  }
+
+  // returns the values of a column in the order of the rows
+  std::vector<int32_t> column_values(const Table& table) {
+    auto values = std::vector<int32_t>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<int32_t>(*table.get_chunk(chunk_id).get_segment(ColumnID{0}),
+                               [&](const ChunkOffset, const int32_t value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(OperatorsLimitTest, FirstRows) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({1, 2});
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  auto limit = std::make_shared<Limit>(table_wrapper, 3);
+  table_wrapper->execute();
+  limit->execute();
+  EXPECT_EQ(column_values(*limit->get_output()), (std::vector<int32_t>{0, 3, 4}));
+}
+
+TEST_F(OperatorsLimitTest, FewerRowsThanLimit) {
+  auto get_table = std::make_shared<GetTable>("table");
+  auto scan = std::make_shared<TableScan>(get_table, ColumnID{0}, ScanType::OpLessThan, 2);
+  auto limit = std::make_shared<Limit>(scan, 5);
+  get_table->execute();
+  scan->execute();
+  limit->execute();
+  EXPECT_EQ(column_values(*limit->get_output()), (std::vector<int32_t>{0, 1}));
+}
+
+TEST_F(OperatorsLimitTest, StopsTableScan) {
+  auto get_table = std::make_shared<GetTable>("table");
+  auto scan = std::make_shared<TableScan>(get_table, ColumnID{0}, ScanType::OpGreaterThanEquals, 150);
+  auto limit = std::make_shared<Limit>(scan, 60);
+  get_table->execute();
+  scan->execute();
+  limit->execute();
+
+  // the scan stops after the second chunk with matches
+  EXPECT_EQ(scan->get_output()->chunk_count(), 2u);
+  EXPECT_EQ(limit->get_output()->row_count(), 60u);
+  EXPECT_EQ(column_values(*limit->get_output()).back(), 209);
+}
+
+TEST_F(OperatorsLimitTest, DoesNotStopSharedInput) {
+  auto get_table = std::make_shared<GetTable>("table");
+  auto scan = std::make_shared<TableScan>(get_table, ColumnID{0}, ScanType::OpLessThan, 1000);
+  auto limit = std::make_shared<Limit>(scan, 5);
+  auto projection = std::make_shared<Projection>(
+      scan, std::vector<std::shared_ptr<const AbstractExpression>>{std::make_shared<ColumnExpression>(ColumnID{0})});
+  EXPECT_EQ(scan->consumer_count(), 2u);
+  EXPECT_FALSE(scan->row_limit());
+
+  limit->execute();
+  projection->execute();
+  EXPECT_EQ(limit->get_output()->row_count(), 5u);
+  EXPECT_EQ(scan->get_output()->row_count(), 1000u);
+  EXPECT_EQ(projection->get_output()->row_count(), 1000u);
+
+  // once the other consumer is gone, the limit applies to the input again
+  projection = nullptr;
+  EXPECT_EQ(scan->consumer_count(), 1u);
+  EXPECT_EQ(scan->row_limit(), 5u);
+}
+
+TEST_F(OperatorsLimitTest, PropagatesThroughProjectionAndLimits) {
+  auto get_table = std::make_shared<GetTable>("table");
+  const auto a = std::make_shared<ColumnExpression>(ColumnID{0});
+  const auto plus_one = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Addition, a,
+                                                               std::make_shared<ValueExpression>(1));
+  const auto expressions = std::vector<std::shared_ptr<const AbstractExpression>>{plus_one};
+  auto projection = std::make_shared<Projection>(get_table, expressions);
+  auto inner_limit = std::make_shared<Limit>(projection, 10);
+  auto limit = std::make_shared<Limit>(inner_limit, 4);
+  EXPECT_EQ(get_table->row_limit(), 4u);
+
+  get_table->execute();
+  projection->execute();
+  inner_limit->execute();
+  limit->execute();
+  EXPECT_EQ(get_table->get_output()->row_count(), 4u);
+  EXPECT_EQ(column_values(*limit->get_output()), (std::vector<int32_t>{1, 2, 3, 4}));
+}
+
+TEST_F(OperatorsLimitTest, StopsJoins) {
+  auto left = std::make_shared<TableWrapper>(_table);
+  auto right = std::make_shared<TableWrapper>(_table);
+  left->execute();
+  right->execute();
+
+  const auto column_ids = std::make_pair(ColumnID{0}, ColumnID{0});
+  auto hash_join = std::make_shared<JoinHash>(left, right, JoinMode::Inner, column_ids);
+  auto sort_merge_join = std::make_shared<JoinSortMerge>(left, right, JoinMode::Inner, column_ids, ScanType::OpEquals);
+  for (const auto& join : std::vector<std::shared_ptr<AbstractJoin>>{hash_join, sort_merge_join}) {
+    auto limit = std::make_shared<Limit>(join, 10);
+    join->execute();
+    limit->execute();
+
+    EXPECT_GE(join->get_output()->row_count(), 10u);
+    EXPECT_LT(join->get_output()->row_count(), 10'000u);
+    EXPECT_EQ(limit->get_output()->row_count(), 10u);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,106 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/materialize.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsMaterializeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<const Table> materialize(const std::shared_ptr<const AbstractOperator>& in,
+                                           const EncodingType encoding_type = EncodingType::Unencoded) {
+    auto materialize = std::make_shared<Materialize>(in, encoding_type);
+    materialize->execute();
+    return materialize->get_output();
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsMaterializeTest, ScanChain) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan_a->execute();
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpNotEquals, std::string{"cherry"});
+  scan_b->execute();
+
+  const auto output = materialize(scan_b);
+  EXPECT_EQ(output->column_names(), _table->column_names());
+  EXPECT_EQ(output->chunk_count(), scan_b->get_output()->chunk_count());
+  for (auto column_id = ColumnID{0}; column_id < output->column_count(); ++column_id) {
+    EXPECT_EQ(output->column_type(column_id), _table->column_type(column_id));
+    EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(column_id)->encoding_type(), EncodingType::Unencoded);
+  }
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}), (std::vector<int32_t>{3, 3, 2}));
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+            (std::vector<std::string>{"banana", "apple", "apple"}));
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{1.5f, 0.5f, 3.0f}));
+}
+
+TEST_F(OperatorsMaterializeTest, DictionaryEncoding) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3);
+  scan->execute();
+
+  const auto output = materialize(scan, EncodingType::Dictionary);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+            (std::vector<std::string>{"apple", "cherry", "banana", "apple"}));
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{2.5f, -1.0f, -2.5f, 3.0f}));
+}
+
+TEST_F(OperatorsMaterializeTest, NullRows) {
+  auto left = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_a.tbl", 2));
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_b.tbl", 2));
+  right->execute();
+  auto join = std::make_shared<JoinHash>(left, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  const auto output = materialize(join);
+  EXPECT_EQ(output->row_count(), join->get_output()->row_count());
+  for (auto column_id = ColumnID{0}; column_id < output->column_count(); ++column_id) {
+    resolve_data_type(output->column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      EXPECT_EQ(column_values<Type>(*output, column_id), column_values<Type>(*join->get_output(), column_id));
+    });
+  }
+}
+
+TEST_F(OperatorsMaterializeTest, DataInput) {
+  EXPECT_EQ(materialize(_table_wrapper), _table);
+  EXPECT_THROW(std::make_shared<Materialize>(_table_wrapper, EncodingType::Reference), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,165 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expressions.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/limit.hpp"
+#include "operators/pipeline.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsPipelineTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  // a > 1 AND b != 'cherry', projected to (b, a * 2)
+  std::shared_ptr<Projection> make_plan(const std::shared_ptr<const AbstractOperator>& input) {
+    auto scan_a = std::make_shared<TableScan>(input, ColumnID{0}, ScanType::OpGreaterThan, 1);
+    auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpNotEquals, std::string{"cherry"});
+    const auto a = std::make_shared<ColumnExpression>(ColumnID{0});
+    const auto two = std::make_shared<ValueExpression>(2);
+    const auto times_two = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Multiplication, a, two);
+    return std::make_shared<Projection>(
+        scan_b, std::vector<std::shared_ptr<const AbstractExpression>>{std::make_shared<ColumnExpression>(ColumnID{1}),
+                                                                       times_two});
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsPipelineTest, ScanScanProjection) {
+  auto plan = make_plan(_table_wrapper);
+  auto pipeline = std::make_shared<Pipeline>(plan);
+  EXPECT_EQ(pipeline->input_left(), _table_wrapper);
+  EXPECT_EQ(pipeline->table_scans().size(), 2u);
+  EXPECT_EQ(pipeline->projection(), plan);
+  pipeline->execute();
+
+  const auto& output = *pipeline->get_output();
+  EXPECT_EQ(plan->get_output(), nullptr);
+  EXPECT_EQ(output.column_names(), (std::vector<std::string>{"b", "(a * 2)"}));
+  EXPECT_EQ(column_values<std::string>(output, ColumnID{0}), (std::vector<std::string>{"banana", "apple", "apple"}));
+  EXPECT_EQ(column_values<int32_t>(output, ColumnID{1}), (std::vector<int32_t>{6, 6, 4}));
+
+  // the same as executing the operators one by one
+  auto operators = make_plan(_table_wrapper);
+  operators->execute();
+  EXPECT_EQ(column_values<int32_t>(*operators->get_output(), ColumnID{1}), (std::vector<int32_t>{6, 6, 4}));
+}
+
+TEST_F(OperatorsPipelineTest, ScansReferenceInput) {
+  auto scan_c = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 0.0f);
+  scan_c->execute();
+  auto scan_a = std::make_shared<TableScan>(scan_c, ColumnID{0}, ScanType::OpLessThan, 3);
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpEquals, std::string{"apple"});
+  auto pipeline = std::make_shared<Pipeline>(scan_b);
+  pipeline->execute();
+
+  // the output references the table that the input references
+  const auto& output = *pipeline->get_output();
+  EXPECT_EQ(column_values<float>(output, ColumnID{2}), (std::vector<float>{2.5f, 3.0f}));
+  const auto& segment = static_cast<const ReferenceSegment&>(*output.get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_EQ(segment.referenced_table(), _table);
+}
+
+TEST_F(OperatorsPipelineTest, SkipsDeletedRows) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({0});
+  auto pipeline = std::make_shared<Pipeline>(make_plan(_table_wrapper));
+  pipeline->execute();
+  EXPECT_EQ(column_values<std::string>(*pipeline->get_output(), ColumnID{0}),
+            (std::vector<std::string>{"apple", "apple"}));
+}
+
+TEST_F(OperatorsPipelineTest, EmptyResult) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{0}, ScanType::OpLessThan, 2);
+  auto pipeline = std::make_shared<Pipeline>(scan_b);
+  pipeline->execute();
+
+  EXPECT_EQ(pipeline->get_output()->row_count(), 0u);
+  EXPECT_EQ(pipeline->get_output()->chunk_count(), 1u);
+  EXPECT_EQ(pipeline->get_output()->get_chunk(ChunkID{0}).column_count(), 3u);
+}
+
+TEST_F(OperatorsPipelineTest, RowLimit) {
+  auto pipeline = std::make_shared<Pipeline>(make_plan(_table_wrapper));
+  auto limit = std::make_shared<Limit>(pipeline, 1);
+  limit->execute();
+
+  // the second chunk is not processed
+  EXPECT_EQ(pipeline->get_output()->chunk_count(), 1u);
+  EXPECT_EQ(column_values<std::string>(*limit->get_output(), ColumnID{0}), std::vector<std::string>{"banana"});
+}
+
+TEST_F(OperatorsPipelineTest, RemovesNullRowsOfAllScannedColumns) {
+  auto left_table = std::make_shared<Table>();
+  left_table->add_column("a", "int");
+  left_table->append({1});
+  left_table->append({2});
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("a", "int");
+  right_table->add_column("b", "int");
+  right_table->append({1, 3});
+  auto left_wrapper = std::make_shared<TableWrapper>(left_table);
+  left_wrapper->execute();
+  auto right_wrapper = std::make_shared<TableWrapper>(right_table);
+  right_wrapper->execute();
+
+  // b is NULL for 2, which does not match b < 5 even though the default value of the column would
+  auto join = std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Left,
+                                         std::make_pair(ColumnID{0}, ColumnID{0}));
+  auto scan_a = std::make_shared<TableScan>(join, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{2}, ScanType::OpLessThan, 5);
+  auto pipeline = std::make_shared<Pipeline>(scan_b);
+  pipeline->execute();
+
+  EXPECT_EQ(column_values<int>(*pipeline->get_output(), ColumnID{0}), std::vector<int>{1});
+}
+
+TEST_F(OperatorsPipelineTest, RejectsOtherOperators) {
+  EXPECT_THROW(std::make_shared<Pipeline>(_table_wrapper), std::logic_error);
+}
+
+TEST_F(OperatorsPipelineTest, RejectsSharedOperators) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpNotEquals, std::string{"cherry"});
+  auto limit = std::make_shared<Limit>(scan_a, 1);
+  EXPECT_THROW(std::make_shared<Pipeline>(scan_b), std::logic_error);
+
+  // the last fused operator is replaced by the pipeline, so that it must not have consumers either
+  auto scan_c = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto other_limit = std::make_shared<Limit>(scan_c, 1);
+  EXPECT_THROW(std::make_shared<Pipeline>(scan_c), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,100 @@
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/limit.hpp"
+#include "operators/plan_printer.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsPlanPrinterTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    StorageManager::get().add_table("int_float", load_table("src/test/tables/int_float.tbl", 2));
+
+    _get_table = std::make_shared<GetTable>("int_float");
+    _scan = std::make_shared<TableScan>(_get_table, ColumnID{0}, ScanType::OpGreaterThanEquals, 1234);
+    _limit = std::make_shared<Limit>(_scan, 1);
+  }
+
+  std::shared_ptr<GetTable> _get_table;
+  std::shared_ptr<TableScan> _scan;
+  std::shared_ptr<Limit> _limit;
+};
+
+TEST_F(OperatorsPlanPrinterTest, PerformanceData) {
+  _limit->execute();
+
+  const auto& get_table_data = _get_table->performance_data();
+  EXPECT_FALSE(get_table_data.cached);
+  EXPECT_EQ(get_table_data.input_row_count, 0u);
+  EXPECT_EQ(get_table_data.output_row_count, 3u);
+  EXPECT_EQ(get_table_data.output_bytes, 0u);
+
+  // the row limit of the Limit stops the scan after the first chunk
+  const auto& scan_data = _scan->performance_data();
+  EXPECT_EQ(scan_data.input_row_count, 3u);
+  EXPECT_EQ(scan_data.output_row_count, 1u);
+  EXPECT_EQ(scan_data.processed_chunk_count, 1u);
+  EXPECT_EQ(scan_data.skipped_chunk_count, 1u);
+  EXPECT_GT(scan_data.output_bytes, 0u);
+  EXPECT_GT(scan_data.walltime.count(), 0);
+
+  EXPECT_EQ(_limit->performance_data().input_row_count, 1u);
+  EXPECT_EQ(_limit->performance_data().output_row_count, 1u);
+}
+
+TEST_F(OperatorsPlanPrinterTest, PrintsTree) {
+  auto out = std::stringstream{};
+  PlanPrinter::print(_limit, out);
+  EXPECT_EQ(out.str(),
+            "Limit 1 (not executed)\n"
+            "`- TableScan #0 >= 1234 LIMIT 1 (not executed)\n"
+            "   `- GetTable int_float (not executed)\n");
+
+  _limit->execute();
+  out = std::stringstream{};
+  PlanPrinter::print(_limit, out);
+  const auto output = out.str();
+  EXPECT_EQ(output.find("Limit 1 (wall "), 0u);
+  EXPECT_NE(output.find("\n`- TableScan #0 >= 1234 LIMIT 1 (wall "), std::string::npos);
+  EXPECT_NE(output.find("rows 3 -> 1, chunks 1 processed / 1 skipped, output "), std::string::npos);
+  EXPECT_NE(output.find("\n   `- GetTable int_float (wall "), std::string::npos);
+}
+
+TEST_F(OperatorsPlanPrinterTest, PrintsCachedAndBinaryPlans) {
+  _limit->execute();
+
+  // the same plan is taken from the ResultCache
+  const auto scan = std::make_shared<TableScan>(_get_table, ColumnID{0}, ScanType::OpGreaterThanEquals, 1234);
+  const auto limit = std::make_shared<Limit>(scan, 1);
+  limit->execute();
+  EXPECT_TRUE(limit->performance_data().cached);
+
+  auto out = std::stringstream{};
+  PlanPrinter::print(limit, out);
+  EXPECT_EQ(out.str().find("Limit 1 (cached, wall "), 0u);
+  EXPECT_NE(out.str().find("\n`- TableScan #0 >= 1234 LIMIT 1 (not executed)\n"), std::string::npos);
+
+  const auto join = std::make_shared<JoinHash>(std::make_shared<GetTable>("int_float"),
+                                               std::make_shared<GetTable>("int_float"), JoinMode::Inner,
+                                               std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+  out = std::stringstream{};
+  PlanPrinter::print(join, out);
+  EXPECT_EQ(out.str().find("JoinHash Inner #0 = #0 (wall "), 0u);
+  EXPECT_NE(out.str().find("rows 6 -> 3, chunks 4 processed / 0 skipped"), std::string::npos);
+  EXPECT_NE(out.str().find("\n|- GetTable int_float (wall "), std::string::npos);
+  EXPECT_NE(out.str().find("\n`- GetTable int_float (wall "), std::string::npos);
+}
+
+}  // namespace opossum
@@ -0,0 +1,193 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expressions.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsProjectionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+
+    _a = std::make_shared<ColumnExpression>(ColumnID{0});
+    _b = std::make_shared<ColumnExpression>(ColumnID{1});
+    _c = std::make_shared<ColumnExpression>(ColumnID{2});
+  }
+
+  std::shared_ptr<const Table> project(const std::shared_ptr<const AbstractOperator>& in,
+                                       const std::vector<std::shared_ptr<const AbstractExpression>>& expressions) {
+    auto projection = std::make_shared<Projection>(in, expressions);
+    projection->execute();
+    return projection->get_output();
+  }
+
+  static std::shared_ptr<const AbstractExpression> value(const AllTypeVariant& value) {
+    return std::make_shared<ValueExpression>(value);
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+  std::shared_ptr<const AbstractExpression> _a;
+  std::shared_ptr<const AbstractExpression> _b;
+  std::shared_ptr<const AbstractExpression> _c;
+};
+
+TEST_F(OperatorsProjectionTest, ForwardsColumns) {
+  const auto output = project(_table_wrapper, {_b, _a});
+  EXPECT_EQ(output->column_names(), (std::vector<std::string>{"b", "a"}));
+  EXPECT_EQ(output->chunk_count(), 2u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(output->get_chunk(chunk_id).get_segment(ColumnID{0}),
+              _table->get_chunk(chunk_id).get_segment(ColumnID{1}));
+  }
+}
+
+TEST_F(OperatorsProjectionTest, Arithmetic) {
+  const auto times_two = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Multiplication, _a, value(2));
+  const auto sum = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Addition, times_two, _c);
+  const auto output = project(_table_wrapper, {sum, times_two});
+
+  EXPECT_EQ(output->column_name(ColumnID{0}), "((a * 2) + c)");
+  EXPECT_EQ(output->column_type(ColumnID{0}), "float");
+  EXPECT_EQ(output->column_type(ColumnID{1}), "int");
+  EXPECT_EQ(column_values<float>(*output, ColumnID{0}), (std::vector<float>{7.5f, 4.5f, 3.0f, 6.5f, -0.5f, 7.0f}));
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{1}), (std::vector<int32_t>{6, 2, 4, 6, 2, 4}));
+}
+
+TEST_F(OperatorsProjectionTest, IntegerDivision) {
+  const auto half = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, _a, value(2));
+  const auto zero = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Subtraction, _a, _a);
+  const auto by_zero = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, _a, zero);
+  const auto modulo = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Modulo, _a, value(int64_t{2}));
+  const auto output = project(_table_wrapper, {half, by_zero, modulo});
+
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}), (std::vector<int32_t>{1, 0, 1, 1, 0, 1}));
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{1}), (std::vector<int32_t>{0, 0, 0, 0, 0, 0}));
+  EXPECT_EQ(output->column_type(ColumnID{2}), "long");
+  EXPECT_EQ(column_values<int64_t>(*output, ColumnID{2}), (std::vector<int64_t>{1, 1, 0, 1, 1, 0}));
+}
+
+TEST_F(OperatorsProjectionTest, IntegerDivisionOverflow) {
+  const auto minus_one = value(-1);
+  const auto int_min = value(std::numeric_limits<int32_t>::min());
+  const auto long_min = value(std::numeric_limits<int64_t>::min());
+  const auto int_quotient = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, int_min, minus_one);
+  const auto long_quotient = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, long_min, minus_one);
+  const auto remainder = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Modulo, int_min, minus_one);
+  const auto negated = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, _a, minus_one);
+  const auto output = project(_table_wrapper, {int_quotient, long_quotient, remainder, negated});
+
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}).front(), std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(column_values<int64_t>(*output, ColumnID{1}).front(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{2}), (std::vector<int32_t>{0, 0, 0, 0, 0, 0}));
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{3}), (std::vector<int32_t>{-3, -1, -2, -3, -1, -2}));
+}
+
+TEST_F(OperatorsProjectionTest, IntegerOverflowWrapsAround) {
+  const auto int_max = value(std::numeric_limits<int32_t>::max());
+  const auto int_min = value(std::numeric_limits<int32_t>::min());
+  const auto long_max = value(std::numeric_limits<int64_t>::max());
+  const auto sum = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Addition, int_max, value(1));
+  const auto difference = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Subtraction, int_min, value(1));
+  const auto product = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Multiplication, long_max, value(2));
+  const auto output = project(_table_wrapper, {sum, difference, product});
+
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}).front(), std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{1}).front(), std::numeric_limits<int32_t>::max());
+  EXPECT_EQ(column_values<int64_t>(*output, ColumnID{2}).front(), int64_t{-2});
+}
+
+TEST_F(OperatorsProjectionTest, ComparisonAndCase) {
+  const auto is_apple = std::make_shared<ComparisonExpression>(ScanType::OpEquals, _b, value(std::string{"apple"}));
+  const auto greater_than = std::make_shared<ComparisonExpression>(ScanType::OpGreaterThan, _a, value(2.5));
+  const auto greater_than_equals = std::make_shared<ComparisonExpression>(ScanType::OpGreaterThanEquals, _a, value(2));
+  const auto case_expression = std::make_shared<CaseExpression>(
+      std::vector<CaseExpression::WhenThenClause>{{greater_than, value(std::string{"high"})},
+                                                  {greater_than_equals, value(std::string{"mid"})}},
+      value(std::string{"low"}));
+  const auto output = project(_table_wrapper, {is_apple, case_expression});
+
+  EXPECT_EQ(output->column_name(ColumnID{0}), "(b = 'apple')");
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}), (std::vector<int32_t>{0, 1, 0, 1, 0, 1}));
+  EXPECT_EQ(output->column_name(ColumnID{1}),
+            "CASE WHEN (a > 2.5) THEN 'high' WHEN (a >= 2) THEN 'mid' ELSE 'low' END");
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+            (std::vector<std::string>{"high", "low", "mid", "high", "low", "mid"}));
+}
+
+TEST_F(OperatorsProjectionTest, RejectsStringCondition) {
+  const auto case_expression = std::make_shared<CaseExpression>(
+      std::vector<CaseExpression::WhenThenClause>{{_b, value(1)}}, value(0));
+  const auto expressions = std::vector<std::shared_ptr<const AbstractExpression>>{case_expression};
+  auto projection = std::make_shared<Projection>(_table_wrapper, expressions);
+  EXPECT_THROW(projection->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsProjectionTest, Cast) {
+  const auto c_as_int = std::make_shared<CastExpression>(_c, "int");
+  const auto a_as_string = std::make_shared<CastExpression>(_a, "string");
+  const auto parsed = std::make_shared<CastExpression>(value(std::string{"42"}), "long");
+  const auto output = project(_table_wrapper, {c_as_int, a_as_string, parsed});
+
+  EXPECT_EQ(output->column_name(ColumnID{0}), "CAST(c AS int)");
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}), (std::vector<int32_t>{1, 2, -1, 0, -2, 3}));
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+            (std::vector<std::string>{"3", "1", "2", "3", "1", "2"}));
+  EXPECT_EQ(column_values<int64_t>(*output, ColumnID{2}), (std::vector<int64_t>{42, 42, 42, 42, 42, 42}));
+}
+
+TEST_F(OperatorsProjectionTest, ReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+
+  // only column references, which are forwarded
+  const auto forwarded = project(scan, {_c});
+  EXPECT_EQ(forwarded->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{2}));
+
+  // references are not mixed with computed values
+  const auto plus_one = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Addition, _a, value(1));
+  const auto output = project(scan, {_b, plus_one});
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Unencoded);
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{0}),
+            (std::vector<std::string>{"banana", "cherry", "apple", "apple"}));
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{1}), (std::vector<int32_t>{4, 3, 4, 3}));
+}
+
+TEST_F(OperatorsProjectionTest, KeepsDeletedRows) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({1, 3});
+  const auto output = project(_table_wrapper, {_a, value(1)});
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).invalid_row_count(), 2u);
+  EXPECT_FALSE(output->get_chunk(ChunkID{0}).is_valid(1));
+  EXPECT_EQ(output->get_chunk(ChunkID{1}).invalid_row_count(), 0u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,138 @@
+#include <memory>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/limit.hpp"
+#include "operators/result_cache.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsResultCacheTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = load_table("src/test/tables/int_float.tbl", 2);
+    StorageManager::get().add_table("int_float", _table);
+  }
+
+  // executes a new scan for a >= 1234 on the stored table
+  std::shared_ptr<TableScan> scan() {
+    auto scan = std::make_shared<TableScan>(std::make_shared<GetTable>("int_float"), ColumnID{0},
+                                            ScanType::OpGreaterThanEquals, 1234);
+    scan->execute();
+    return scan;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(OperatorsResultCacheTest, Key) {
+  const auto get_table = std::make_shared<GetTable>("int_float");
+  const auto scan = std::make_shared<TableScan>(get_table, ColumnID{1}, ScanType::OpLessThan, 457.5f);
+  const auto limit = std::make_shared<Limit>(scan, 1);
+
+  const auto key = ResultCache::make_key(*limit);
+  ASSERT_TRUE(key);
+  EXPECT_EQ(key->plan, "Limit 1 (TableScan #1 < 457.5 LIMIT 1 (GetTable int_float))");
+  ASSERT_EQ(key->table_versions.size(), 1u);
+  EXPECT_EQ(key->table_versions[0].first, "int_float");
+  EXPECT_EQ(key->table_versions[0].second, _table->version());
+
+  // leaves and operators that are not cacheable do not have a key
+  EXPECT_FALSE(ResultCache::make_key(*get_table));
+  const auto wrapper = std::make_shared<TableWrapper>(_table);
+  EXPECT_FALSE(ResultCache::make_key(*std::make_shared<TableScan>(wrapper, ColumnID{0}, ScanType::OpEquals, 1)));
+}
+
+TEST_F(OperatorsResultCacheTest, RepeatedPlanIsNotExecuted) {
+  const auto first_scan = scan();
+  EXPECT_EQ(first_scan->get_output()->row_count(), 2u);
+  EXPECT_EQ(ResultCache::get().size(), 1u);
+  EXPECT_GT(ResultCache::get().memory_usage(), 0u);
+
+  const auto second_scan = scan();
+  EXPECT_EQ(second_scan->get_output(), first_scan->get_output());
+  EXPECT_FALSE(second_scan->input_left()->get_output());
+}
+
+TEST_F(OperatorsResultCacheTest, ModificationsInvalidate) {
+  const auto first_output = scan()->get_output();
+
+  _table->append({2000, 1.0f});
+  const auto appended_output = scan()->get_output();
+  EXPECT_NE(appended_output, first_output);
+  EXPECT_EQ(appended_output->row_count(), 3u);
+
+  _table->compress_chunk(ChunkID{0});
+  const auto compressed_output = scan()->get_output();
+  EXPECT_NE(compressed_output, appended_output);
+  EXPECT_EQ(scan()->get_output(), compressed_output);
+
+  auto delete_operator = std::make_shared<Delete>(scan());
+  delete_operator->execute();
+  EXPECT_EQ(scan()->get_output()->row_count(), 0u);
+  EXPECT_EQ(ResultCache::get().size(), 1u);
+}
+
+TEST_F(OperatorsResultCacheTest, DropInvalidates) {
+  scan();
+  EXPECT_EQ(ResultCache::get().size(), 1u);
+
+  StorageManager::get().drop_table("int_float");
+  EXPECT_EQ(ResultCache::get().size(), 0u);
+  EXPECT_EQ(ResultCache::get().memory_usage(), 0u);
+
+  // a new table with the same name has another version
+  StorageManager::get().add_table("int_float", load_table("src/test/tables/int_float.tbl", 1));
+  EXPECT_EQ(scan()->get_output()->chunk_count(), 2u);
+}
+
+TEST_F(OperatorsResultCacheTest, MemoryBudget) {
+  auto& result_cache = ResultCache::get();
+  const auto memory_budget = result_cache.memory_budget();
+
+  scan();
+  const auto entry_memory_usage = result_cache.memory_usage();
+
+  // the least recently used entry is evicted
+  result_cache.set_memory_budget(entry_memory_usage);
+  auto other_scan =
+      std::make_shared<TableScan>(std::make_shared<GetTable>("int_float"), ColumnID{0}, ScanType::OpLessThan, 1234);
+  other_scan->execute();
+  EXPECT_EQ(result_cache.size(), 1u);
+  EXPECT_EQ(ResultCache::make_key(*other_scan)->plan, "TableScan #0 < 1234 (GetTable int_float)");
+  EXPECT_EQ(result_cache.lookup(*ResultCache::make_key(*other_scan)), other_scan->get_output());
+
+  result_cache.set_memory_budget(0);
+  EXPECT_EQ(result_cache.size(), 0u);
+  scan();
+  EXPECT_EQ(result_cache.size(), 0u);
+
+  result_cache.set_memory_budget(memory_budget);
+}
+
+TEST_F(OperatorsResultCacheTest, SharesStorageBudget) {
+  auto& result_cache = ResultCache::get();
+  scan();
+  const auto entry_memory_usage = result_cache.memory_usage();
+  ASSERT_GT(entry_memory_usage, 0u);
+
+  // the tables leave room for the entry
+  StorageManager::get().set_memory_budget(_table->estimate_memory_usage() + entry_memory_usage);
+  EXPECT_EQ(result_cache.size(), 1u);
+
+  // the tables use the whole budget, so that nothing is cached
+  StorageManager::get().set_memory_budget(_table->estimate_memory_usage());
+  EXPECT_EQ(result_cache.size(), 0u);
+  scan();
+  EXPECT_EQ(result_cache.size(), 0u);
+}
+
+}  // namespace opossum
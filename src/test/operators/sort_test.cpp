@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsSortTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<const Table> sort(const std::shared_ptr<const AbstractOperator>& in,
+                                    const std::vector<SortColumnDefinition>& sort_definitions,
+                                    const ChunkOffset output_chunk_size = 10) {
+    auto sort = std::make_shared<Sort>(in, sort_definitions, output_chunk_size);
+    sort->execute();
+    return sort->get_output();
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsSortTest, MultipleColumns) {
+  const auto output = sort(_table_wrapper, {{ColumnID{0}}, {ColumnID{1}, OrderByMode::Descending}});
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/sort_a_asc_b_desc_result.tbl", 10), true);
+}
+
+TEST_F(OperatorsSortTest, DescendingFloats) {
+  const auto output = sort(_table_wrapper, {{ColumnID{2}, OrderByMode::Descending}});
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/sort_c_desc_result.tbl", 10), true);
+}
+
+TEST_F(OperatorsSortTest, IsStable) {
+  const auto output = sort(_table_wrapper, {{ColumnID{0}}});
+  EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+            (std::vector<std::string>{"apple", "banana", "cherry", "apple", "banana", "apple"}));
+}
+
+TEST_F(OperatorsSortTest, ReferenceInput) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({1});
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+
+  const auto output = sort(scan, {{ColumnID{2}}}, 2);
+  EXPECT_EQ(output->chunk_count(), 2u);
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{-1.0f, 0.5f, 1.5f, 3.0f}));
+
+  // the output references the data table, not the output of the scan
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table);
+}
+
+TEST_F(OperatorsSortTest, SkipsDeletedRows) {
+  _table->get_chunk(ChunkID{1}).invalidate_rows({0, 1});
+  const auto output = sort(_table_wrapper, {{ColumnID{1}}, {ColumnID{0}}});
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{0}), (std::vector<int32_t>{1, 3, 3, 2}));
+}
+
+TEST_F(OperatorsSortTest, SkipsRowsDeletedAfterReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+  // the row 3 | apple | 0.5 is deleted after the scan referenced it
+  _table->get_chunk(ChunkID{0}).invalidate_rows({3});
+
+  const auto output = sort(scan, {{ColumnID{2}}});
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{-1.0f, 1.5f, 3.0f}));
+}
+
+TEST_F(OperatorsSortTest, LongStrings) {
+  // the strings only differ behind the prefix that is part of the normalized key
+  auto table = std::make_shared<Table>(2);
+  table->add_column("s", "string");
+  table->add_column("i", "int");
+  const auto prefix = std::string(40, 'x');
+  for (const auto& suffix : {"c", "a", "", "b", "a"}) {
+    table->append({prefix + suffix, static_cast<int32_t>(table->row_count())});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto output = sort(table_wrapper, {{ColumnID{0}, OrderByMode::Descending}, {ColumnID{1}}});
+  EXPECT_EQ(column_values<int32_t>(*output, ColumnID{1}), (std::vector<int32_t>{0, 3, 1, 4, 2}));
+}
+
+TEST_F(OperatorsSortTest, ManyRows) {
+  // large enough for the chunks to be merged in several ranges
+  auto table = std::make_shared<Table>(10'000);
+  table->add_column("l", "long");
+  table->add_column("d", "double");
+  auto expected_longs = std::vector<int64_t>{};
+  auto expected_doubles = std::vector<double>{};
+  for (auto index = int64_t{0}; index < 100'000; ++index) {
+    const auto value = (index * 7919) % 100'003 - 50'000;
+    table->append({value * 1'000'000, static_cast<double>(value) / 3});
+    expected_longs.push_back(value * 1'000'000);
+    expected_doubles.push_back(static_cast<double>(value) / 3);
+  }
+  table->compress_chunk(ChunkID{2});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::sort(expected_longs.begin(), expected_longs.end());
+  const auto sorted_by_long = sort(table_wrapper, {{ColumnID{0}}}, 30'000);
+  EXPECT_EQ(sorted_by_long->chunk_count(), 4u);
+  EXPECT_EQ(column_values<int64_t>(*sorted_by_long, ColumnID{0}), expected_longs);
+
+  std::sort(expected_doubles.begin(), expected_doubles.end(), std::greater<>{});
+  const auto sorted_by_double = sort(table_wrapper, {{ColumnID{1}, OrderByMode::Descending}});
+  EXPECT_EQ(column_values<double>(*sorted_by_double, ColumnID{1}), expected_doubles);
+}
+
+TEST_F(OperatorsSortTest, EmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  const auto output = sort(scan, {{ColumnID{1}}});
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).column_count(), 3u);
+}
+
+}  // namespace opossum
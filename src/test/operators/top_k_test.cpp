@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // mixes dictionary and value segments
+    _table = load_table("src/test/tables/sort_input.tbl", 4);
+    _table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<const Table> top_k(const std::shared_ptr<const AbstractOperator>& in,
+                                     const std::vector<SortColumnDefinition>& sort_definitions, const size_t k) {
+    auto top_k = std::make_shared<TopK>(in, sort_definitions, k);
+    top_k->execute();
+    return top_k->get_output();
+  }
+
+  // returns the values of a column in the order of the rows
+  template <typename T>
+  std::vector<T> column_values(const Table& table, const ColumnID column_id) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*table.get_chunk(chunk_id).get_segment(column_id),
+                         [&](const ChunkOffset, const T& value) { values.push_back(value); });
+    }
+    return values;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, MatchesSort) {
+  const auto sort_definitions =
+      std::vector<SortColumnDefinition>{{ColumnID{0}}, {ColumnID{1}, OrderByMode::Descending}};
+  auto sort = std::make_shared<Sort>(_table_wrapper, sort_definitions);
+  sort->execute();
+  const auto expected = column_values<std::string>(*sort->get_output(), ColumnID{1});
+
+  for (auto k = size_t{0}; k <= 7; ++k) {
+    const auto output = top_k(_table_wrapper, sort_definitions, k);
+    EXPECT_EQ(column_values<std::string>(*output, ColumnID{1}),
+              std::vector<std::string>(expected.cbegin(), expected.cbegin() + std::min(k, expected.size())));
+  }
+}
+
+TEST_F(OperatorsTopKTest, Descending) {
+  const auto output = top_k(_table_wrapper, {{ColumnID{2}, OrderByMode::Descending}}, 3);
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{3.0f, 2.5f, 1.5f}));
+}
+
+TEST_F(OperatorsTopKTest, ReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+
+  const auto output = top_k(scan, {{ColumnID{2}}}, 2);
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{-1.0f, 0.5f}));
+}
+
+TEST_F(OperatorsTopKTest, SkipsDeletedRows) {
+  _table->get_chunk(ChunkID{0}).invalidate_rows({2});
+  _table->get_chunk(ChunkID{1}).invalidate_rows({0});
+  const auto output = top_k(_table_wrapper, {{ColumnID{2}}}, 2);
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{0.5f, 1.5f}));
+}
+
+TEST_F(OperatorsTopKTest, SkipsRowsDeletedAfterReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+  // the row 3 | apple | 0.5 is deleted after the scan referenced it
+  _table->get_chunk(ChunkID{0}).invalidate_rows({3});
+
+  const auto output = top_k(scan, {{ColumnID{2}}}, 2);
+  EXPECT_EQ(column_values<float>(*output, ColumnID{2}), (std::vector<float>{-1.0f, 1.5f}));
+}
+
+TEST_F(OperatorsTopKTest, SkipsChunks) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("timestamp", "long");
+  for (auto timestamp = int64_t{0}; timestamp < 100'000; ++timestamp) {
+    table->append({timestamp});
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id + 1 < table->chunk_count(); ++chunk_id) {
+    table->compress_chunk(chunk_id);
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // the latest 100 rows are all in the last chunk, which is processed first
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Descending}};
+  auto top_k = std::make_shared<TopK>(table_wrapper, sort_definitions, 100);
+  top_k->execute();
+  const auto values = column_values<int64_t>(*top_k->get_output(), ColumnID{0});
+  ASSERT_EQ(values.size(), 100u);
+  EXPECT_EQ(values.front(), 99'999);
+  EXPECT_EQ(values.back(), 99'900);
+  EXPECT_GT(top_k->skipped_chunk_count(), 0u);
+}
+
+TEST_F(OperatorsTopKTest, EmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  const auto output = top_k(scan, {{ColumnID{1}}}, 10);
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).column_count(), 3u);
+}
+
+}  // namespace opossum
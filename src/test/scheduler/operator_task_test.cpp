@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/operator_task.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorTaskTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table_wrapper_a = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_a.tbl", 2));
+    _table_wrapper_b = std::make_shared<TableWrapper>(load_table("src/test/tables/join_input_b.tbl", 2));
+  }
+
+  // returns the task of the operator
+  static std::shared_ptr<AbstractTask> task_of(const std::vector<std::shared_ptr<AbstractTask>>& tasks,
+                                               const std::shared_ptr<const AbstractOperator>& op) {
+    const auto task = std::find_if(tasks.cbegin(), tasks.cend(), [&](const auto& task) {
+      return static_cast<const OperatorTask&>(*task).get_operator() == op;
+    });
+    return task == tasks.cend() ? nullptr : *task;
+  }
+
+  static bool is_predecessor(const std::shared_ptr<AbstractTask>& task, const std::shared_ptr<AbstractTask>& other) {
+    const auto& successors = task->successors();
+    return std::find(successors.cbegin(), successors.cend(), other) != successors.cend();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_a, _table_wrapper_b;
+};
+
+TEST_F(OperatorTaskTest, ExecutesInputs) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto scan_b = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::OpLessThan, 4);
+  auto join = std::make_shared<JoinHash>(scan_a, scan_b, JoinMode::Inner, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  EXPECT_NE(_table_wrapper_a->get_output(), nullptr);
+  EXPECT_NE(scan_b->get_output(), nullptr);
+  // 2 and 2 again match twice each, 3 matches once
+  EXPECT_EQ(join->get_output()->row_count(), 5u);
+}
+
+TEST_F(OperatorTaskTest, Dependencies) {
+  _table_wrapper_b->execute();
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto scan_b = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::OpLessThan, 4);
+  auto other_scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpLessThan, 3);
+  auto join = std::make_shared<JoinHash>(scan_a, scan_b, JoinMode::Semi, std::make_pair(ColumnID{0}, ColumnID{0}));
+
+  // the shared input gets one task, the executed one none
+  const auto tasks = OperatorTask::make_tasks({join, other_scan_a});
+  EXPECT_EQ(tasks.size(), 5u);
+  EXPECT_EQ(task_of(tasks, _table_wrapper_b), nullptr);
+  EXPECT_TRUE(is_predecessor(task_of(tasks, _table_wrapper_a), task_of(tasks, scan_a)));
+  EXPECT_TRUE(is_predecessor(task_of(tasks, _table_wrapper_a), task_of(tasks, other_scan_a)));
+  EXPECT_TRUE(is_predecessor(task_of(tasks, scan_a), task_of(tasks, join)));
+  EXPECT_TRUE(is_predecessor(task_of(tasks, scan_b), task_of(tasks, join)));
+
+  // the left scan receives a Bloom filter from the right input of the semi join
+  EXPECT_TRUE(is_predecessor(task_of(tasks, scan_b), task_of(tasks, scan_a)));
+}
+
+TEST_F(OperatorTaskTest, NoCyclicDependencies) {
+  // the scan is both inputs of the join, so that it cannot be executed after its right input
+  auto scan = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  auto join = std::make_shared<JoinHash>(scan, scan, JoinMode::Semi, std::make_pair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(OperatorTask::make_tasks({join}).size(), 3u);
+
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 4u);
+}
+
+}  // namespace opossum
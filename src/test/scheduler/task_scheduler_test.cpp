@@ -0,0 +1,98 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/task_scheduler.hpp"
+
+namespace opossum {
+
+class TaskSchedulerTest : public BaseTest {
+ protected:
+  // returns a task that appends the id to _order
+  std::shared_ptr<AbstractTask> make_task(const int id) {
+    return std::make_shared<JobTask>([this, id]() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _order.push_back(id);
+    });
+  }
+
+  std::mutex _mutex;
+  std::vector<int> _order;
+};
+
+TEST_F(TaskSchedulerTest, Dependencies) {
+  auto scheduler = TaskScheduler{4};
+  EXPECT_EQ(scheduler.worker_count(), 4u);
+
+  // a diamond: 0 before 1 and 2, both before 3
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{make_task(0), make_task(1), make_task(2), make_task(3)};
+  tasks[0]->set_as_predecessor_of(tasks[1]);
+  tasks[0]->set_as_predecessor_of(tasks[2]);
+  tasks[1]->set_as_predecessor_of(tasks[3]);
+  tasks[2]->set_as_predecessor_of(tasks[3]);
+  scheduler.schedule_and_wait({tasks[3], tasks[2], tasks[1], tasks[0]});
+
+  ASSERT_EQ(_order.size(), 4u);
+  EXPECT_EQ(_order.front(), 0);
+  EXPECT_EQ(_order.back(), 3);
+  for (const auto& task : tasks) EXPECT_TRUE(task->is_done());
+}
+
+TEST_F(TaskSchedulerTest, ManyTasks) {
+  auto scheduler = TaskScheduler{4};
+  auto counter = std::atomic<size_t>{0};
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto index = 0; index < 10'000; ++index) {
+    tasks.emplace_back(std::make_shared<JobTask>([&]() { ++counter; }));
+  }
+
+  // a chain runs in order next to the independent tasks
+  for (auto id = 0; id < 100; ++id) {
+    tasks.emplace_back(make_task(id));
+    if (id > 0) tasks[tasks.size() - 2]->set_as_predecessor_of(tasks.back());
+  }
+  scheduler.schedule_and_wait(tasks);
+
+  EXPECT_EQ(counter, 10'000u);
+  ASSERT_EQ(_order.size(), 100u);
+  for (auto id = 0; id < 100; ++id) EXPECT_EQ(_order[id], id);
+}
+
+TEST_F(TaskSchedulerTest, NestedTasks) {
+  // the task waits for other tasks, which the waiting worker runs itself
+  auto scheduler = TaskScheduler{1};
+  auto counter = std::atomic<size_t>{0};
+  auto outer_task = std::make_shared<JobTask>([&]() {
+    auto inner_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto index = 0; index < 10; ++index) {
+      inner_tasks.emplace_back(std::make_shared<JobTask>([&]() { ++counter; }));
+    }
+    scheduler.schedule_and_wait(inner_tasks);
+  });
+  scheduler.schedule_and_wait({outer_task});
+  EXPECT_EQ(counter, 10u);
+}
+
+TEST_F(TaskSchedulerTest, Exceptions) {
+  auto scheduler = TaskScheduler{2};
+  auto failing_task = std::make_shared<JobTask>([]() { throw std::logic_error("failed"); });
+  auto successor = make_task(0);
+  failing_task->set_as_predecessor_of(successor);
+  auto independent_task = make_task(1);
+
+  EXPECT_THROW(scheduler.schedule_and_wait({failing_task, successor, independent_task}), std::logic_error);
+  EXPECT_EQ(_order, std::vector<int>{1});
+  EXPECT_TRUE(successor->is_done());
+
+  // tasks are only scheduled once
+  EXPECT_THROW(scheduler.schedule_and_wait({independent_task}), std::logic_error);
+  EXPECT_THROW(independent_task->set_as_predecessor_of(make_task(2)), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/operators/delete.hpp"
+#include "../lib/operators/get_table.hpp"
+#include "../lib/operators/table_scan.hpp"
+#include "../lib/storage/background_compaction.hpp"
+#include "../lib/storage/storage_manager.hpp"
+#include "../lib/storage/table.hpp"
+
+namespace opossum {
+
+class StorageBackgroundCompactionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(10);
+    _table->add_column("a", "int");
+    for (auto value = 0; value < 30; ++value) _table->append({value});
+    StorageManager::get().add_table("compaction_table", _table);
+
+    _table->get_chunk(ChunkID{0}).invalidate_rows({0, 1, 2, 3, 4, 5});
+    _table->get_chunk(ChunkID{1}).invalidate_rows({0, 1});
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(StorageBackgroundCompactionTest, CompactsChunksAboveRatio) {
+  auto compaction = BackgroundCompaction{0.5};
+  EXPECT_EQ(compaction.compact(), 1u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}).size(), 4u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{1}).size(), 10u);
+  EXPECT_EQ(_table->approx_valid_row_count(), 22u);
+  EXPECT_EQ(compaction.compact(), 0u);
+}
+
+TEST_F(StorageBackgroundCompactionTest, CompactsInBackground) {
+  auto compaction = BackgroundCompaction{0.2, std::chrono::milliseconds{1}};
+  compaction.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  compaction.stop();
+
+  EXPECT_EQ(_table->row_count(), 22u);
+}
+
+TEST_F(StorageBackgroundCompactionTest, WaitsForReaders) {
+  _table->lock_for_reading();
+  auto compaction = std::thread{[&] { _table->compact_chunk(ChunkID{0}); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}).size(), 10u);
+  EXPECT_EQ(_table->layout_version(), 0u);
+
+  _table->unlock_for_reading();
+  compaction.join();
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}).size(), 4u);
+  EXPECT_EQ(_table->layout_version(), 1u);
+}
+
+TEST_F(StorageBackgroundCompactionTest, ToleratesConcurrentlyDroppedTables) {
+  auto compaction = BackgroundCompaction{0.2, std::chrono::milliseconds{0}};
+  compaction.start();
+  for (auto iteration = 0; iteration < 200; ++iteration) {
+    auto table = std::make_shared<Table>(10);
+    table->add_column("a", "int");
+    table->append({iteration});
+    StorageManager::get().add_table("dropped_table", table);
+    StorageManager::get().drop_table("dropped_table");
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  compaction.stop();
+
+  EXPECT_EQ(_table->row_count(), 22u);
+  EXPECT_FALSE(StorageManager::get().has_table("dropped_table"));
+}
+
+TEST_F(StorageBackgroundCompactionTest, RejectsPositionsFromBeforeCompaction) {
+  auto scan = std::make_shared<TableScan>(std::make_shared<GetTable>("compaction_table"), ColumnID{0},
+                                          ScanType::OpEquals, 15);
+  scan->execute();
+  _table->compact_chunk(ChunkID{1});
+
+  // row 15 moved from offset 5 to offset 3 of chunk 1, where row 17 is now
+  EXPECT_THROW(std::make_shared<Delete>(scan)->execute(), std::logic_error);
+  EXPECT_EQ(_table->approx_valid_row_count(), 22u);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1}).is_valid(ChunkOffset{3}));
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1}).is_valid(ChunkOffset{5}));
+}
+
+TEST_F(StorageBackgroundCompactionTest, InvalidRatio) {
+  EXPECT_THROW(BackgroundCompaction{0.0}, std::logic_error);
+}
+
+}  // namespace opossum
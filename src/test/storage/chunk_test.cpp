@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -58,6 +59,30 @@ TEST_F(StorageChunkTest, RetrieveSegment) {
   EXPECT_EQ(base_segment->size(), 4u);
 }
 
+TEST_F(StorageChunkTest, InvalidateRows) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  EXPECT_EQ(c.invalidation_bitmap(), nullptr);
+  EXPECT_EQ(c.invalid_row_count(), 0u);
+
+  c.invalidate_rows({0, 2});
+  const auto bitmap = c.invalidation_bitmap();
+  ASSERT_NE(bitmap, nullptr);
+  EXPECT_EQ(*bitmap, std::vector<uint64_t>{0b101});
+  EXPECT_FALSE(c.is_valid(0));
+  EXPECT_TRUE(c.is_valid(1));
+  EXPECT_EQ(c.invalid_row_count(), 2u);
+
+  // deletes do not modify bitmaps that were handed out before
+  c.invalidate_rows({1});
+  EXPECT_EQ(*bitmap, std::vector<uint64_t>{0b101});
+  EXPECT_EQ(c.invalid_row_count(), 3u);
+
+  // rows appended later are valid
+  c.append({2, "two"});
+  EXPECT_TRUE(c.is_valid(3));
+}
+
 TEST_F(StorageChunkTest, UnknownSegmentType) {
   // Exception will only be thrown in debug builds
   if (IS_DEBUG) {
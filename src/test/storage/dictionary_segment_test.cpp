@@ -66,6 +66,24 @@ TEST_F(StorageDictionarySegmentTest, MemoryConsumption) {
   EXPECT_EQ(dict_col->estimate_memory_usage(), expected_size_dict);
 }
 
+TEST_F(StorageDictionarySegmentTest, MemoryConsumptionIncludesStringPayloads) {
+  const auto long_string = std::string(100, 'x');
+  vc_str->append(long_string);
+  vc_str->append(long_string);
+  vc_str->append("short");
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("string", vc_str);
+
+  // two dictionary entries, one of them with a heap-allocated payload, and three 8 bit value ids
+  EXPECT_GE(col->estimate_memory_usage(), 2 * sizeof(std::string) + long_string.size() + 3 * sizeof(uint8_t));
+  EXPECT_EQ(col->encoding_type(), opossum::EncodingType::Dictionary);
+}
+
+TEST_F(StorageDictionarySegmentTest, CompressNonValueSegment) {
+  vc_int->append(1);
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("int", vc_int);
+  EXPECT_THROW((opossum::DictionarySegment<int>{col}), std::logic_error);
+}
+
 TEST_F(StorageDictionarySegmentTest, GetValues) {
   // Setup
   for (int i = 0; i <= 10; i += 2) vc_int->append(i);
@@ -0,0 +1,51 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/group_key_index.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageGroupKeyIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto value_segment = std::make_shared<ValueSegment<std::string>>();
+    for (const auto& value : {"Bill", "Steve", "Alexander", "Steve", "Hasso", "Bill"}) {
+      value_segment->append(value);
+    }
+    _segment = std::make_shared<DictionarySegment<std::string>>(value_segment);
+    _index = std::make_shared<GroupKeyIndex<std::string>>(*_segment);
+  }
+
+  std::shared_ptr<DictionarySegment<std::string>> _segment;
+  std::shared_ptr<GroupKeyIndex<std::string>> _index;
+};
+
+TEST_F(StorageGroupKeyIndexTest, GroupsOffsetsByValue) {
+  // offsets in the order of their values: Alexander, Bill, Bill, Hasso, Steve, Steve
+  EXPECT_EQ(std::vector<ChunkOffset>(_index->cbegin(), _index->cend()), (std::vector<ChunkOffset>{2, 0, 5, 4, 1, 3}));
+
+  const auto [begin, end] = _index->positions(ValueID{3});
+  EXPECT_EQ(std::vector<ChunkOffset>(begin, end), (std::vector<ChunkOffset>{1, 3}));
+}
+
+TEST_F(StorageGroupKeyIndexTest, LowerAndUpperBound) {
+  const auto bill = std::string{"Bill"};
+  EXPECT_EQ(std::vector<ChunkOffset>(_index->lower_bound(bill), _index->upper_bound(bill)),
+            (std::vector<ChunkOffset>{0, 5}));
+  EXPECT_EQ(_index->lower_bound(std::string{"Carl"}), _index->upper_bound(std::string{"Carl"}));
+  EXPECT_EQ(_index->lower_bound(AllTypeVariant{"Carl"}) - _index->cbegin(), 3);
+  EXPECT_EQ(_index->upper_bound(AllTypeVariant{"Zeus"}), _index->cend());
+}
+
+TEST_F(StorageGroupKeyIndexTest, MemoryUsage) {
+  // six offsets and five start offsets for four distinct values
+  EXPECT_EQ(_index->estimate_memory_usage(), 11 * sizeof(ChunkOffset));
+}
+
+}  // namespace opossum
@@ -0,0 +1,126 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/get_table.hpp"
+#include "operators/operator_statistics.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/meta_tables.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class StorageMetaTablesTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    OperatorStatistics::get().reset();
+
+    _table = std::make_shared<Table>(2);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    _table->append({1, "one"});
+    _table->append({2, "one"});
+    _table->append({3, "three"});
+    _table->compress_chunk(ChunkID{0});
+    StorageManager::get().add_table("t", _table);
+  }
+
+  void TearDown() override { OperatorStatistics::get().reset(); }
+
+  static std::shared_ptr<const Table> execute(const std::shared_ptr<AbstractOperator>& op) {
+    op->execute();
+    return op->get_output();
+  }
+
+  static AllTypeVariant value(const std::shared_ptr<const Table>& table, const size_t row, const ColumnID column_id) {
+    return (*table->get_chunk(ChunkID{0}).get_segment(column_id))[row];
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(StorageMetaTablesTest, StorageManagerProvidesMetaTables) {
+  auto& sm = StorageManager::get();
+  for (const auto& name : MetaTables::table_names()) {
+    EXPECT_TRUE(sm.has_table(name));
+    EXPECT_TRUE(MetaTables::is_meta_table(name));
+  }
+  EXPECT_FALSE(MetaTables::is_meta_table("t"));
+  EXPECT_EQ(sm.table_names(), std::vector<std::string>{"t"});
+
+  // meta tables are generated anew, so that they are neither stored nor cached
+  EXPECT_NE(sm.get_table("meta_tables"), sm.get_table("meta_tables"));
+  EXPECT_FALSE(GetTable{"meta_tables"}.is_cacheable());
+  EXPECT_THROW(sm.add_table("meta_tables", std::make_shared<Table>()), std::exception);
+  EXPECT_THROW(sm.drop_table("meta_tables"), std::exception);
+}
+
+TEST_F(StorageMetaTablesTest, DescribesTablesChunksAndSegments) {
+  const auto meta_tables = execute(std::make_shared<GetTable>("meta_tables"));
+  ASSERT_EQ(meta_tables->row_count(), 1u);
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{0}), AllTypeVariant{"t"});
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{1}), AllTypeVariant{2});
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{2}), AllTypeVariant{int64_t{3}});
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{3}), AllTypeVariant{2});
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{4}), AllTypeVariant{int64_t{2}});
+  EXPECT_EQ(value(meta_tables, 0, ColumnID{5}), AllTypeVariant{static_cast<int64_t>(_table->estimate_memory_usage())});
+
+  _table->get_chunk(ChunkID{1}).invalidate_rows({0});
+  const auto meta_chunks = execute(std::make_shared<GetTable>("meta_chunks"));
+  ASSERT_EQ(meta_chunks->row_count(), 2u);
+  EXPECT_EQ(value(meta_chunks, 1, ColumnID{1}), AllTypeVariant{1});
+  EXPECT_EQ(value(meta_chunks, 1, ColumnID{2}), AllTypeVariant{int64_t{1}});
+  EXPECT_EQ(value(meta_chunks, 1, ColumnID{3}), AllTypeVariant{int64_t{1}});
+
+  // table_name, chunk_id, column_id, column_name, column_type, encoding, width, distinct_count, memory_bytes
+  const auto meta_segments = execute(std::make_shared<GetTable>("meta_segments"));
+  ASSERT_EQ(meta_segments->row_count(), 4u);
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{2}), AllTypeVariant{1});
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{3}), AllTypeVariant{"b"});
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{4}), AllTypeVariant{"string"});
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{5}), AllTypeVariant{"Dictionary"});
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{6}), AllTypeVariant{1});
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{7}), AllTypeVariant{int64_t{1}});
+  const auto dictionary_bytes = _table->get_chunk(ChunkID{0}).get_segment(ColumnID{1})->estimate_memory_usage();
+  EXPECT_EQ(value(meta_segments, 1, ColumnID{8}), AllTypeVariant{static_cast<int64_t>(dictionary_bytes)});
+
+  EXPECT_EQ(value(meta_segments, 2, ColumnID{1}), AllTypeVariant{1});
+  EXPECT_EQ(value(meta_segments, 2, ColumnID{5}), AllTypeVariant{"Unencoded"});
+  EXPECT_EQ(value(meta_segments, 2, ColumnID{6}), AllTypeVariant{4});
+  EXPECT_EQ(value(meta_segments, 2, ColumnID{7}), AllTypeVariant{int64_t{1}});
+}
+
+TEST_F(StorageMetaTablesTest, AnalyzedWithOperators) {
+  // the memory of the dictionary-encoded segments, which grows once the second chunk is compressed as well
+  const auto dictionary_bytes = [] {
+    const auto scan = std::make_shared<TableScan>(std::make_shared<GetTable>("meta_segments"), ColumnID{5},
+                                                  ScanType::OpEquals, "Dictionary");
+    const auto sum = std::make_shared<Aggregate>(
+        scan, std::vector<AggregateColumnDefinition>{{ColumnID{8}, AggregateFunction::Sum}}, std::vector<ColumnID>{});
+    return value(execute(sum), 0, ColumnID{0});
+  };
+  EXPECT_EQ(dictionary_bytes(),
+            AllTypeVariant{static_cast<int64_t>(_table->get_chunk(ChunkID{0}).estimate_memory_usage())});
+  _table->compress_chunk(ChunkID{1});
+  EXPECT_EQ(dictionary_bytes(), AllTypeVariant{static_cast<int64_t>(_table->estimate_memory_usage())});
+
+  // operator_name, execution_count, cached_count, walltime_ns, cpu_time_ns, input_row_count, output_row_count
+  const auto meta_operators = execute(std::make_shared<GetTable>("meta_operators"));
+  ASSERT_EQ(meta_operators->row_count(), 3u);
+  EXPECT_EQ(value(meta_operators, 0, ColumnID{0}), AllTypeVariant{"Aggregate"});
+  EXPECT_EQ(value(meta_operators, 0, ColumnID{1}), AllTypeVariant{int64_t{2}});
+  EXPECT_EQ(value(meta_operators, 0, ColumnID{2}), AllTypeVariant{int64_t{0}});
+  EXPECT_EQ(value(meta_operators, 0, ColumnID{5}), AllTypeVariant{int64_t{6}});
+  EXPECT_EQ(value(meta_operators, 0, ColumnID{6}), AllTypeVariant{int64_t{2}});
+  EXPECT_EQ(value(meta_operators, 1, ColumnID{0}), AllTypeVariant{"GetTable"});
+  EXPECT_EQ(value(meta_operators, 1, ColumnID{1}), AllTypeVariant{int64_t{2}});
+  EXPECT_EQ(value(meta_operators, 2, ColumnID{0}), AllTypeVariant{"TableScan"});
+  EXPECT_EQ(value(meta_operators, 2, ColumnID{5}), AllTypeVariant{int64_t{8}});
+}
+
+}  // namespace opossum
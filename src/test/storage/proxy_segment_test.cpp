@@ -0,0 +1,101 @@
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/proxy_segment.hpp"
+#include "storage/spill_file.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageProxySegmentTest : public BaseTest {
+ protected:
+  void SetUp() override { _spill_file = std::make_shared<SpillFile>("proxy_segment_test.spill"); }
+
+  template <typename T>
+  std::shared_ptr<BaseSegment> make_dictionary_segment(const std::string& type, const std::vector<T>& values) {
+    auto value_segment = std::make_shared<ValueSegment<T>>();
+    for (const auto& value : values) value_segment->append(value);
+    return make_shared_by_data_type<BaseSegment, DictionarySegment>(type, value_segment);
+  }
+
+  std::shared_ptr<SpillFile> _spill_file;
+};
+
+TEST_F(StorageProxySegmentTest, EvictAndLoadInt) {
+  const auto segment = make_dictionary_segment<int32_t>("int", {3, 1, 4, 1, 5, 9, 2, 6});
+  const auto proxy = ProxySegment::evict(segment, "int", _spill_file);
+
+  EXPECT_EQ(proxy->encoding_type(), EncodingType::Proxy);
+  EXPECT_EQ(proxy->size(), 8u);
+  EXPECT_FALSE(proxy->is_loaded());
+  EXPECT_LT(proxy->estimate_memory_usage(), segment->estimate_memory_usage() + sizeof(ProxySegment));
+
+  const auto loaded = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(proxy->load());
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(proxy->is_loaded());
+  EXPECT_EQ(loaded->unique_values_count(), 7u);
+  for (ChunkOffset chunk_offset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+    EXPECT_EQ((*loaded)[chunk_offset], (*segment)[chunk_offset]);
+  }
+
+  proxy->unload();
+  EXPECT_FALSE(proxy->is_loaded());
+  EXPECT_EQ((*proxy)[7], AllTypeVariant{6});
+  EXPECT_THROW(proxy->append(1), std::logic_error);
+}
+
+TEST_F(StorageProxySegmentTest, EvictAndLoadString) {
+  const auto long_string = std::string(5000, 'x');
+  const auto segment = make_dictionary_segment<std::string>("string", {"Bill", long_string, "", "Bill", "Steve"});
+  const auto proxy = ProxySegment::evict(segment, "string", _spill_file);
+
+  // the second segment does not start at a page boundary of the spill file
+  const auto second_segment = make_dictionary_segment<std::string>("string", {"Hasso", "Alexander"});
+  const auto second_proxy = ProxySegment::evict(second_segment, "string", _spill_file);
+
+  EXPECT_EQ((*proxy)[1], AllTypeVariant{long_string});
+  EXPECT_EQ((*proxy)[2], AllTypeVariant{""});
+  EXPECT_EQ((*proxy)[4], AllTypeVariant{"Steve"});
+  EXPECT_EQ((*second_proxy)[0], AllTypeVariant{"Hasso"});
+  EXPECT_EQ((*second_proxy)[1], AllTypeVariant{"Alexander"});
+}
+
+TEST_F(StorageProxySegmentTest, EvictWideAttributeVector) {
+  auto values = std::vector<int64_t>{};
+  for (auto value = int64_t{0}; value < 300; ++value) values.emplace_back(value * 7);
+  const auto segment = make_dictionary_segment<int64_t>("long", values);
+  const auto proxy = ProxySegment::evict(segment, "long", _spill_file);
+
+  const auto loaded = std::dynamic_pointer_cast<DictionarySegment<int64_t>>(proxy->load());
+  EXPECT_EQ(loaded->attribute_vector()->width(), 2u);
+  EXPECT_EQ(loaded->get(299), 299 * 7);
+}
+
+TEST_F(StorageProxySegmentTest, OnlyDictionarySegmentsCanBeEvicted) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  value_segment->append(1);
+  EXPECT_THROW(ProxySegment::evict(value_segment, "int", _spill_file), std::logic_error);
+}
+
+TEST_F(StorageProxySegmentTest, ChunkResolvesProxies) {
+  const auto segment = make_dictionary_segment<int32_t>("int", {1, 2, 3});
+  auto chunk = Chunk{};
+  chunk.add_segment(segment);
+  EXPECT_FALSE(chunk.reset_access_flag());
+
+  chunk.replace_segment(ColumnID{0}, ProxySegment::evict(segment, "int", _spill_file));
+  EXPECT_EQ(chunk.get_stored_segment(ColumnID{0})->encoding_type(), EncodingType::Proxy);
+  EXPECT_FALSE(chunk.reset_access_flag());
+
+  EXPECT_EQ(chunk.get_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_TRUE(chunk.reset_access_flag());
+  EXPECT_FALSE(chunk.reset_access_flag());
+}
+
+}  // namespace opossum
@@ -1,10 +1,16 @@
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
 
+#include "../lib/operators/get_table.hpp"
+#include "../lib/operators/table_scan.hpp"
+#include "../lib/storage/proxy_segment.hpp"
 #include "../lib/storage/storage_manager.hpp"
 #include "../lib/storage/table.hpp"
+#include "../lib/utils/huge_page_memory_resource.hpp"
 
 namespace opossum {
 
@@ -27,11 +33,18 @@ TEST_F(StorageStorageManagerTest, GetTable) {
   EXPECT_THROW(sm.get_table("third_table"), std::exception);
 }
 
-TEST_F(StorageStorageManagerTest, PrintTableNames) {
+TEST_F(StorageStorageManagerTest, PrintTables) {
   auto& sm = StorageManager::get();
+  auto table = sm.get_table("second_table");
+  table->add_column("a", "int");
+  for (auto value = 0; value < 5; ++value) table->append({value});
+
   std::stringstream ss;
   sm.print(ss);
-  EXPECT_EQ(ss.str(), "first_table\nsecond_table\n");
+  EXPECT_EQ(ss.str(), "first_table: 0 columns, 0 rows, 1 chunks, " +
+                          std::to_string(sm.get_table("first_table")->estimate_memory_usage()) +
+                          " bytes\nsecond_table: 1 columns, 5 rows, 2 chunks, " +
+                          std::to_string(table->estimate_memory_usage()) + " bytes\n");
 }
 
 TEST_F(StorageStorageManagerTest, AddAlreadExisitingTable) {
@@ -58,6 +71,230 @@ TEST_F(StorageStorageManagerTest, DoesNotHaveTable) {
   EXPECT_EQ(sm.has_table("third_table"), false);
 }
 
+TEST_F(StorageStorageManagerTest, MemoryReport) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(2);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  table->append({1, "one"});
+  table->append({2, "two"});
+  table->append({3, std::string(100, 'x')});
+  table->compress_chunk(ChunkID{0});
+  sm.add_table("memory_table", table);
+
+  const auto report = sm.memory_report();
+  ASSERT_EQ(report.segments().size(), 4u);
+  EXPECT_EQ(report.total_bytes(), table->estimate_memory_usage());
+  EXPECT_EQ(report.bytes_by_table().at("memory_table"), table->estimate_memory_usage());
+  EXPECT_EQ(report.bytes_by_table().count("first_table"), 0u);
+
+  const auto bytes_by_chunk = report.bytes_by_chunk("memory_table");
+  EXPECT_EQ(bytes_by_chunk.at(ChunkID{0}), table->get_chunk(ChunkID{0}).estimate_memory_usage());
+  EXPECT_EQ(bytes_by_chunk.at(ChunkID{1}), table->get_chunk(ChunkID{1}).estimate_memory_usage());
+
+  const auto bytes_by_column = report.bytes_by_column("memory_table");
+  EXPECT_GT(bytes_by_column.at("b"), 100u);
+
+  const auto bytes_by_encoding = report.bytes_by_encoding();
+  EXPECT_EQ(bytes_by_encoding.at(EncodingType::Dictionary), table->get_chunk(ChunkID{0}).estimate_memory_usage());
+  EXPECT_EQ(bytes_by_encoding.at(EncodingType::Unencoded), table->get_chunk(ChunkID{1}).estimate_memory_usage());
+}
+
+TEST_F(StorageStorageManagerTest, MemoryReportShowsHugePages) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>();
+  table->set_use_huge_pages(true);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  // column a needs more than 2 MB
+  for (auto value = 0; value < 600'000; ++value) table->append({value, 0});
+  sm.add_table("huge_page_table", table);
+
+  const auto report = sm.memory_report();
+  ASSERT_EQ(report.segments().size(), 2u);
+  EXPECT_EQ(report.segments()[0].huge_page_backed, HugePageMemoryResource::is_available());
+  EXPECT_EQ(report.segments()[1].huge_page_backed, HugePageMemoryResource::is_available());
+  EXPECT_EQ(report.huge_page_bytes(), HugePageMemoryResource::is_available() ? report.total_bytes() : 0u);
+
+  // after compression, the value ids of column b fit into less than 1 MB
+  table->compress_chunk(ChunkID{0});
+  const auto compressed_report = sm.memory_report();
+  EXPECT_EQ(compressed_report.segments()[0].huge_page_backed, HugePageMemoryResource::is_available());
+  EXPECT_FALSE(compressed_report.segments()[1].huge_page_backed);
+}
+
+TEST_F(StorageStorageManagerTest, MemoryBudgetCompressesFullChunks) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(4);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 10; ++value) table->append({value % 2});
+  sm.add_table("budget_table", table);
+  EXPECT_FALSE(sm.memory_budget());
+  EXPECT_EQ(table->estimate_memory_usage(), 40u);
+
+  // compressing the first chunk (16 bytes) into two dictionary entries and four 8 bit value ids (12 bytes) suffices
+  sm.set_memory_budget(39);
+  EXPECT_EQ(sm.memory_budget(), 39u);
+  EXPECT_EQ(table->estimate_memory_usage(), 36u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_EQ(table->get_chunk(ChunkID{1}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Unencoded);
+
+  // the last chunk is not full and stays mutable, so the budget cannot be met
+  EXPECT_TRUE(sm.enforce_memory_budget());
+  sm.set_memory_budget(20);
+  EXPECT_FALSE(sm.enforce_memory_budget());
+  EXPECT_EQ(table->get_chunk(ChunkID{1}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_EQ(table->get_chunk(ChunkID{2}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Unencoded);
+  table->append({10});
+  EXPECT_EQ(table->row_count(), 11u);
+}
+
+TEST_F(StorageStorageManagerTest, MemoryBudgetIsEnforcedAfterPlansThatGrewTables) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(4);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 3; ++value) table->append({value % 2});
+  sm.add_table("budget_table", table);
+  sm.set_memory_budget(20);
+  EXPECT_FALSE(sm.memory_budget_status().exceeded);
+  EXPECT_EQ(sm.memory_budget_status().memory_usage, 12u);
+
+  // appending does not compress the chunk that became full, as operators might read it
+  for (auto value = 3; value < 6; ++value) table->append({value % 2});
+  EXPECT_EQ(table->estimate_memory_usage(), 24u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Unencoded);
+
+  // instead, the budget is enforced after the next plan
+  std::make_shared<GetTable>("budget_table")->execute();
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_EQ(table->estimate_memory_usage(), 20u);
+  EXPECT_FALSE(sm.memory_budget_status().exceeded);
+
+  // an overflow is reported instead of printed
+  sm.set_memory_budget(10);
+  EXPECT_FALSE(sm.enforce_memory_budget());
+  EXPECT_TRUE(sm.memory_budget_status().exceeded);
+  EXPECT_EQ(sm.memory_budget_status().memory_usage, 20u);
+}
+
+TEST_F(StorageStorageManagerTest, TieringEvictsColdChunks) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 300; ++value) table->append({value});
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) table->compress_chunk(chunk_id);
+  sm.add_table("tiered_table", table);
+  sm.enable_tiering("storage_manager_test.spill");
+
+  const auto encoding = [&](const uint32_t chunk_id) {
+    return table->get_chunk(ChunkID{chunk_id}).get_stored_segment(ColumnID{0})->encoding_type();
+  };
+
+  // every chunk uses 100 * 4 bytes for the dictionary and 100 * 1 byte for the attribute vector
+  EXPECT_EQ(table->estimate_memory_usage(), 1500u);
+
+  // chunk 0 was accessed and gets a second chance, so chunk 1 is evicted first
+  table->get_chunk(ChunkID{0}).get_segment(ColumnID{0});
+  sm.set_memory_budget(1400);
+  EXPECT_EQ(encoding(0), EncodingType::Dictionary);
+  EXPECT_EQ(encoding(1), EncodingType::Proxy);
+  EXPECT_EQ(encoding(2), EncodingType::Dictionary);
+  EXPECT_LE(table->estimate_memory_usage(), 1400u);
+  EXPECT_EQ(sm.memory_report().bytes_by_encoding().count(EncodingType::Proxy), 1u);
+
+  // evicted chunks are faulted back in transparently
+  const auto segment = table->get_chunk(ChunkID{1}).get_segment(ColumnID{0});
+  EXPECT_EQ((*segment)[2], AllTypeVariant{102});
+  EXPECT_GT(table->estimate_memory_usage(), 1400u);
+
+  // the clock hand continues after chunk 1 and evicts chunk 2
+  EXPECT_TRUE(sm.enforce_memory_budget());
+  EXPECT_EQ(encoding(0), EncodingType::Dictionary);
+  EXPECT_EQ(encoding(2), EncodingType::Proxy);
+
+  // chunk 0 lost its second chance, chunk 1 was accessed again and is unloaded only in the second round
+  sm.set_memory_budget(1);
+  EXPECT_EQ(encoding(0), EncodingType::Proxy);
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto stored_segment = table->get_chunk(chunk_id).get_stored_segment(ColumnID{0});
+    const auto proxy = std::dynamic_pointer_cast<ProxySegment>(stored_segment);
+    ASSERT_TRUE(proxy);
+    EXPECT_FALSE(proxy->is_loaded());
+  }
+  EXPECT_FALSE(sm.enforce_memory_budget());
+
+  for (auto value = 0; value < 300; ++value) {
+    const auto& chunk = table->get_chunk(ChunkID{static_cast<uint32_t>(value / 100)});
+    EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[value % 100], AllTypeVariant{value});
+  }
+}
+
+TEST_F(StorageStorageManagerTest, TieringWaitsForReaders) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 100; ++value) table->append({value});
+  table->compress_chunk(ChunkID{0});
+  sm.add_table("tiered_table", table);
+  sm.enable_tiering("storage_manager_test.spill");
+
+  table->lock_for_reading();
+  auto eviction = std::thread{[&] { sm.set_memory_budget(1); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_stored_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+
+  table->unlock_for_reading();
+  eviction.join();
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_stored_segment(ColumnID{0})->encoding_type(), EncodingType::Proxy);
+}
+
+TEST_F(StorageStorageManagerTest, TieringDropsAndRebuildsIndexes) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 200; ++value) table->append({value});
+  table->create_index(ColumnID{0});
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) table->compress_chunk(chunk_id);
+  sm.add_table("tiered_table", table);
+  sm.enable_tiering("storage_manager_test.spill");
+
+  // the index keeps the dictionary alive, so that it has to be dropped for the eviction to free memory
+  table->get_chunk(ChunkID{0}).get_segment(ColumnID{0});
+  sm.set_memory_budget(table->estimate_memory_usage() - 1);
+  const auto stored_segment = table->get_chunk(ChunkID{1}).get_stored_segment(ColumnID{0});
+  const auto proxy = std::dynamic_pointer_cast<ProxySegment>(stored_segment);
+  ASSERT_TRUE(proxy);
+  EXPECT_LT(table->estimate_memory_usage(), *sm.memory_budget());
+  EXPECT_TRUE(table->get_chunk(ChunkID{0}).get_index(ColumnID{0}));
+
+  // the index is rebuilt when the evicted segment is loaded
+  const auto index = table->get_chunk(ChunkID{1}).get_index(ColumnID{0});
+  ASSERT_TRUE(index);
+  EXPECT_TRUE(proxy->is_loaded());
+  EXPECT_EQ(*index->lower_bound(AllTypeVariant{150}), ChunkOffset{50});
+  EXPECT_GT(table->estimate_memory_usage(), *sm.memory_budget());
+}
+
+TEST_F(StorageStorageManagerTest, TieringEvictsSegmentsThatPlansLoaded) {
+  auto& sm = StorageManager::get();
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 300; ++value) table->append({value});
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) table->compress_chunk(chunk_id);
+  sm.add_table("tiered_table", table);
+  sm.enable_tiering("storage_manager_test.spill");
+  sm.set_memory_budget(1400);
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).get_stored_segment(ColumnID{0})->encoding_type(), EncodingType::Proxy);
+
+  // the scan loads the evicted chunk, which is evicted again once the scan is done
+  auto get_table = std::make_shared<GetTable>("tiered_table");
+  auto scan = std::make_shared<TableScan>(get_table, ColumnID{0}, ScanType::OpEquals, 2);
+  scan->execute();
+  EXPECT_EQ(scan->get_output()->row_count(), 1u);
+  EXPECT_LE(table->estimate_memory_usage(), 1400u);
+  EXPECT_FALSE(sm.memory_budget_status().exceeded);
+}
+
 TEST_F(StorageStorageManagerTest, HasTable) {
   auto& sm = StorageManager::get();
   EXPECT_EQ(sm.has_table("first_table"), true);
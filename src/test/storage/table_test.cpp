@@ -8,6 +8,8 @@
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
+#include "../lib/storage/base_index.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
 #include "../lib/storage/table.hpp"
 
 namespace opossum {
@@ -79,6 +81,99 @@ TEST_F(StorageTableTest, CompressTable) {
   EXPECT_EQ(old_size, new_size);
 }
 
+TEST_F(StorageTableTest, EstimateMemoryUsage) {
+  EXPECT_EQ(t.estimate_memory_usage(), 0u);
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  EXPECT_EQ(t.estimate_memory_usage(), 3 * (sizeof(int32_t) + sizeof(std::string)));
+  EXPECT_EQ(t.estimate_memory_usage(),
+            t.get_chunk(ChunkID{0}).estimate_memory_usage() + t.get_chunk(ChunkID{1}).estimate_memory_usage());
+}
+
+TEST_F(StorageTableTest, SegmentsAllocateFromChunkArena) {
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  t.compress_chunk(ChunkID{0});
+
+  const auto& chunk_0 = t.get_chunk(ChunkID{0});
+  const auto dictionary_segment =
+      std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk_0.get_segment(ColumnID{0}));
+  EXPECT_EQ(dictionary_segment->dictionary()->get_allocator().resource(), chunk_0.memory_resource().get());
+
+  const auto& chunk_1 = t.get_chunk(ChunkID{1});
+  const auto value_segment = std::dynamic_pointer_cast<ValueSegment<std::string>>(chunk_1.get_segment(ColumnID{1}));
+  EXPECT_EQ(value_segment->values().get_allocator().resource(), chunk_1.memory_resource().get());
+  EXPECT_NE(chunk_0.memory_resource(), chunk_1.memory_resource());
+}
+
+TEST_F(StorageTableTest, HugePageConfiguration) {
+  EXPECT_FALSE(Table::uses_huge_pages_by_default());
+  EXPECT_FALSE(t.uses_huge_pages());
+
+  t.set_use_huge_pages(true);
+  EXPECT_TRUE(t.uses_huge_pages());
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).column_count(), 2u);
+
+  Table::set_use_huge_pages_by_default(true);
+  auto other_table = Table{2};
+  other_table.set_use_huge_pages(false);
+  EXPECT_TRUE(Table{2}.uses_huge_pages());
+  EXPECT_FALSE(other_table.uses_huge_pages());
+  Table::set_use_huge_pages_by_default(false);
+  EXPECT_FALSE(Table{2}.uses_huge_pages());
+}
+
+TEST_F(StorageTableTest, CompactChunk) {
+  for (auto value = 0; value < 5; ++value) t.append({value, std::to_string(value)});
+  t.get_chunk(ChunkID{0}).invalidate_rows({0});
+  t.get_chunk(ChunkID{2}).invalidate_rows({0});
+  EXPECT_EQ(t.approx_valid_row_count(), 3u);
+
+  t.compact_chunk(ChunkID{0});
+  const auto& chunk_0 = t.get_chunk(ChunkID{0});
+  EXPECT_EQ(chunk_0.size(), 1u);
+  EXPECT_EQ(chunk_0.invalid_row_count(), 0u);
+  EXPECT_EQ(chunk_0.get_segment(ColumnID{0})->encoding_type(), EncodingType::Dictionary);
+  EXPECT_EQ((*chunk_0.get_segment(ColumnID{1}))[0], AllTypeVariant{"1"});
+  EXPECT_EQ(t.row_count(), 4u);
+
+  // compacting the last chunk starts a new one, so that rows can still be appended
+  t.compact_chunk(ChunkID{2});
+  EXPECT_EQ(t.get_chunk(ChunkID{2}).size(), 0u);
+  t.append({5, "5"});
+  EXPECT_EQ(t.chunk_count(), 4u);
+  EXPECT_EQ(t.row_count(), 4u);
+  EXPECT_EQ(t.approx_valid_row_count(), 4u);
+}
+
+TEST_F(StorageTableTest, CreateIndex) {
+  for (auto value = 0; value < 5; ++value) t.append({value % 2, std::to_string(value)});
+  t.compress_chunk(ChunkID{0});
+  t.create_index(ColumnID{0});
+  EXPECT_TRUE(t.is_indexed(ColumnID{0}));
+  EXPECT_FALSE(t.is_indexed(ColumnID{1}));
+
+  // only dictionary-encoded chunks are indexed, including those compressed later
+  const auto index = t.get_chunk(ChunkID{0}).get_index(ColumnID{0});
+  ASSERT_TRUE(index);
+  EXPECT_EQ(*index->lower_bound(1), 1u);
+  EXPECT_FALSE(t.get_chunk(ChunkID{1}).get_index(ColumnID{0}));
+  EXPECT_FALSE(t.get_chunk(ChunkID{0}).get_index(ColumnID{1}));
+  t.compress_chunk(ChunkID{1});
+  EXPECT_TRUE(t.get_chunk(ChunkID{1}).get_index(ColumnID{0}));
+
+  t.get_chunk(ChunkID{1}).invalidate_rows({0});
+  t.compact_chunk(ChunkID{1});
+  EXPECT_EQ(*t.get_chunk(ChunkID{1}).get_index(ColumnID{0})->cbegin(), 0u);
+
+  const auto memory_usage = t.get_chunk(ChunkID{0}).estimate_memory_usage();
+  EXPECT_EQ(memory_usage - t.get_chunk(ChunkID{0}).get_segment(ColumnID{0})->estimate_memory_usage() -
+                t.get_chunk(ChunkID{0}).get_segment(ColumnID{1})->estimate_memory_usage(),
+            index->estimate_memory_usage());
+}
+
 TEST_F(StorageTableTest, CompressTableNonExisting) { EXPECT_ANY_THROW(t.compress_chunk((ChunkID)1)); }
 // TODO make sure that empty chunks are not an issue
 
@@ -54,4 +54,13 @@ TEST_F(StorageValueSegmentTest, MemoryUsage) {
   EXPECT_EQ(int_value_segment.estimate_memory_usage(), size_t{8});
 }
 
+TEST_F(StorageValueSegmentTest, MemoryUsageIncludesStringPayloads) {
+  string_value_segment.append("short");
+  EXPECT_EQ(string_value_segment.estimate_memory_usage(), sizeof(std::string));
+
+  const auto long_string = std::string(100, 'x');
+  string_value_segment.append(long_string);
+  EXPECT_GE(string_value_segment.estimate_memory_usage(), 2 * sizeof(std::string) + long_string.size());
+}
+
 }  // namespace opossum
@@ -0,0 +1,76 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+#include "utils/arena.hpp"
+
+namespace opossum {
+
+class ArenaTest : public BaseTest {};
+
+TEST_F(ArenaTest, AllocatesFromArena) {
+  auto arena = std::make_shared<Arena>();
+  auto values = pmr_vector<int32_t>(PolymorphicAllocator<int32_t>{arena.get()});
+  for (auto value = 0; value < 1000; ++value) values.push_back(value);
+
+  EXPECT_EQ(values.get_allocator().resource(), arena.get());
+  EXPECT_EQ(values[999], 999);
+  EXPECT_TRUE(arena->is_equal(*arena));
+  EXPECT_FALSE(arena->is_equal(Arena{}));
+}
+
+TEST_F(ArenaTest, ConcurrentAllocations) {
+  auto arena = std::make_shared<Arena>();
+  auto threads = std::vector<std::thread>{};
+  auto pos_lists = std::vector<std::shared_ptr<PosList>>(8);
+  for (auto thread_id = size_t{0}; thread_id < pos_lists.size(); ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      pos_lists[thread_id] = make_pos_list(arena);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 10'000; ++chunk_offset) {
+        pos_lists[thread_id]->emplace_back(RowID{ChunkID{static_cast<uint32_t>(thread_id)}, chunk_offset});
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(arena->thread_buffer_count(), 8u);
+
+  for (auto thread_id = size_t{0}; thread_id < pos_lists.size(); ++thread_id) {
+    ASSERT_EQ(pos_lists[thread_id]->size(), 10'000u);
+    EXPECT_EQ((*pos_lists[thread_id])[1234], (RowID{ChunkID{static_cast<uint32_t>(thread_id)}, 1234}));
+  }
+}
+
+TEST_F(ArenaTest, PosListKeepsArenaAlive) {
+  auto arena = std::make_shared<Arena>();
+  const auto weak_arena = std::weak_ptr<Arena>{arena};
+
+  auto pos_list = make_pos_list(arena);
+  EXPECT_EQ(pos_list->get_allocator().resource(), arena.get());
+  arena = nullptr;
+  EXPECT_FALSE(weak_arena.expired());
+
+  pos_list->emplace_back(RowID{ChunkID{0}, 0});
+  pos_list = nullptr;
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST_F(ArenaTest, SegmentKeepsArenaAlive) {
+  auto arena = std::make_shared<Arena>();
+  const auto weak_arena = std::weak_ptr<Arena>{arena};
+
+  auto segment = std::make_shared<ValueSegment<int32_t>>(PolymorphicAllocator<int32_t>{arena.get()});
+  auto bound_segment = keep_memory_resource_alive(std::move(segment), std::shared_ptr<MemoryResource>{arena});
+  arena = nullptr;
+
+  bound_segment->append(17);
+  EXPECT_EQ(bound_segment->values().get_allocator().resource(), weak_arena.lock().get());
+  bound_segment = nullptr;
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+}  // namespace opossum
@@ -0,0 +1,41 @@
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "utils/bloom_filter.hpp"
+
+namespace opossum {
+
+class BloomFilterTest : public BaseTest {};
+
+TEST_F(BloomFilterTest, ContainsInsertedHashes) {
+  auto bloom_filter = BloomFilter{1'000};
+  for (auto value = int64_t{0}; value < 1'000; ++value) bloom_filter.insert(bloom_filter_hash(value * 7));
+  for (auto value = int64_t{0}; value < 1'000; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(bloom_filter_hash(value * 7)));
+  }
+
+  bloom_filter.insert(bloom_filter_hash(std::string{"apple"}));
+  EXPECT_TRUE(bloom_filter.contains(bloom_filter_hash(std::string{"apple"})));
+}
+
+TEST_F(BloomFilterTest, FalsePositiveRate) {
+  auto bloom_filter = BloomFilter{10'000};
+  EXPECT_EQ(bloom_filter.block_count(), 625u);
+  for (auto value = 0; value < 10'000; ++value) bloom_filter.insert(bloom_filter_hash(value));
+
+  auto false_positive_count = 0;
+  for (auto value = 10'000; value < 110'000; ++value) {
+    false_positive_count += bloom_filter.contains(bloom_filter_hash(value));
+  }
+  EXPECT_LT(false_positive_count, 1'000);
+}
+
+TEST_F(BloomFilterTest, Empty) {
+  const auto bloom_filter = BloomFilter{0};
+  EXPECT_EQ(bloom_filter.block_count(), 1u);
+  EXPECT_FALSE(bloom_filter.contains(bloom_filter_hash(42)));
+}
+
+}  // namespace opossum
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/get_table.hpp"
+#include "operators/plan_printer.hpp"
+#include "operators/result_cache.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/storage_manager.hpp"
+#include "utils/hardware_counters.hpp"
+#include "utils/load_table.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+// The counters are usually not permitted in containers and CI, so that these tests only check the values if the
+// counters are available.
+class HardwareCountersTest : public BaseTest {
+ protected:
+  void TearDown() override { HardwareCounters::set_enabled(false); }
+};
+
+TEST_F(HardwareCountersTest, CountsCallingThreadAndJobs) {
+  auto values = HardwareCounterValues{};
+  auto available = false;
+  {
+    const auto counters = HardwareCounters{};
+    EXPECT_EQ(HardwareCounters::current(), &counters);
+    available = counters.is_available();
+
+    auto sum = std::atomic<uint64_t>{0};
+    parallel_for(8, [&](const size_t index) {
+      EXPECT_NE(HardwareCounters::current(), nullptr);
+      for (auto iteration = uint64_t{0}; iteration < 100'000; ++iteration) sum += iteration * index;
+    });
+    EXPECT_GT(sum.load(), 0u);
+    values = counters.read();
+  }
+  EXPECT_EQ(HardwareCounters::current(), nullptr);
+
+  if (!available) {
+    EXPECT_EQ(values.cycles, 0u);
+    EXPECT_EQ(values.instructions, 0u);
+    EXPECT_EQ(values.ipc(), 0.0);
+    return;
+  }
+  EXPECT_GT(values.cycles, 0u);
+  EXPECT_GT(values.instructions, 800'000u);
+  EXPECT_GT(values.ipc(), 0.0);
+}
+
+TEST_F(HardwareCountersTest, OperatorPerformanceData) {
+  StorageManager::get().add_table("int_float", load_table("src/test/tables/int_float.tbl", 2));
+  auto scan = std::make_shared<TableScan>(std::make_shared<GetTable>("int_float"), ColumnID{0},
+                                          ScanType::OpGreaterThanEquals, 1234);
+
+  // disabled by default
+  scan->execute();
+  EXPECT_FALSE(scan->performance_data().hardware_counters);
+
+  // enabled, but only measured if available, while the output of the first scan is not reused
+  ResultCache::get().clear();
+  HardwareCounters::set_enabled(true);
+  auto rescan = std::make_shared<TableScan>(std::make_shared<GetTable>("int_float"), ColumnID{0},
+                                            ScanType::OpGreaterThanEquals, 1234);
+  rescan->execute();
+  auto out = std::stringstream{};
+  PlanPrinter::print(rescan, out);
+
+  if (!HardwareCounters{}.is_available()) {
+    EXPECT_FALSE(rescan->performance_data().hardware_counters);
+    EXPECT_EQ(out.str().find("IPC"), std::string::npos);
+    return;
+  }
+  ASSERT_TRUE(rescan->performance_data().hardware_counters);
+  EXPECT_GT(rescan->performance_data().hardware_counters->instructions, 0u);
+  EXPECT_NE(out.str().find(", IPC "), std::string::npos);
+  EXPECT_NE(out.str().find(", LLC misses/row "), std::string::npos);
+}
+
+}  // namespace opossum
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <numeric>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "utils/huge_page_memory_resource.hpp"
+
+namespace opossum {
+
+class HugePageMemoryResourceTest : public BaseTest {
+ protected:
+  HugePageMemoryResource& _resource = HugePageMemoryResource::get();
+};
+
+TEST_F(HugePageMemoryResourceTest, LargeAllocationsAreAligned) {
+  const auto bytes = HugePageMemoryResource::HUGE_PAGE_SIZE + 100;
+  auto* const pointer = _resource.allocate(bytes, alignof(int32_t));
+  const auto huge_page_bytes = _resource.huge_page_bytes();
+
+  // the allocation falls back to the default resource if transparent huge pages are disabled
+  EXPECT_EQ(_resource.is_huge_page_backed(pointer), HugePageMemoryResource::is_available());
+  if (HugePageMemoryResource::is_available()) {
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(pointer) % HugePageMemoryResource::HUGE_PAGE_SIZE, 0u);
+    EXPECT_TRUE(_resource.is_huge_page_backed(static_cast<char*>(pointer) + bytes - 1));
+    EXPECT_GE(huge_page_bytes, 2 * HugePageMemoryResource::HUGE_PAGE_SIZE);
+  }
+
+  auto* const values = static_cast<int32_t*>(pointer);
+  std::iota(values, values + bytes / sizeof(int32_t), 0);
+  EXPECT_EQ(values[1000], 1000);
+
+  _resource.deallocate(pointer, bytes, alignof(int32_t));
+  EXPECT_FALSE(_resource.is_huge_page_backed(pointer));
+}
+
+TEST_F(HugePageMemoryResourceTest, SmallAllocationsUseDefaultResource) {
+  auto* const pointer = _resource.allocate(64, alignof(int32_t));
+  EXPECT_FALSE(_resource.is_huge_page_backed(pointer));
+  _resource.deallocate(pointer, 64, alignof(int32_t));
+}
+
+TEST_F(HugePageMemoryResourceTest, VectorUsesHugePages) {
+  auto values = pmr_vector<int32_t>(PolymorphicAllocator<int32_t>{&_resource});
+  values.resize(HugePageMemoryResource::HUGE_PAGE_SIZE);
+  EXPECT_EQ(_resource.is_huge_page_backed(values.data()), HugePageMemoryResource::is_available());
+  EXPECT_EQ(values.back(), 0);
+}
+
+}  // namespace opossum
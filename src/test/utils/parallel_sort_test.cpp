@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "utils/parallel_sort.hpp"
+
+namespace opossum {
+
+class ParallelSortTest : public BaseTest {};
+
+TEST_F(ParallelSortTest, SortsRuns) {
+  auto runs = std::vector<std::vector<int32_t>>(7);
+  auto expected = std::vector<int32_t>{};
+  for (auto value = int32_t{0}; value < 50'000; ++value) {
+    const auto shuffled_value = (value * 7919) % 50'000;
+    runs[value % runs.size()].push_back(shuffled_value);
+    expected.push_back(shuffled_value);
+  }
+  runs.emplace_back();
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(parallel_sort(std::move(runs), std::less<>{}), expected);
+}
+
+TEST_F(ParallelSortTest, IsStable) {
+  // pairs are compared by their first element only, the second one is the position in the input
+  using Entry = std::pair<int32_t, int32_t>;
+  auto runs = std::vector<std::vector<Entry>>(4);
+  for (auto position = int32_t{0}; position < 20'000; ++position) {
+    runs[position / 5'000].emplace_back(position % 10, position);
+  }
+
+  const auto sorted = parallel_sort(std::move(runs), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.first < rhs.first;
+  });
+  ASSERT_EQ(sorted.size(), 20'000u);
+  EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+}
+
+TEST_F(ParallelSortTest, EmptyRuns) {
+  EXPECT_TRUE(parallel_sort(std::vector<std::vector<int32_t>>{}, std::less<>{}).empty());
+  EXPECT_TRUE(parallel_sort(std::vector<std::vector<int32_t>>(3), std::less<>{}).empty());
+}
+
+}  // namespace opossum
@@ -0,0 +1,86 @@
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/value_segment.hpp"
+#include "utils/parallel_for.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+class PerformanceWarningTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    PerformanceWarningRegistry::get().reset();
+    _segment->append(4);
+    _segment->append(2);
+  }
+
+  void TearDown() override { PerformanceWarningRegistry::get().reset(); }
+
+  std::shared_ptr<ValueSegment<int32_t>> _segment = std::make_shared<ValueSegment<int32_t>>();
+};
+
+TEST_F(PerformanceWarningTest, CountsHitsPerCallSite) {
+  auto& registry = PerformanceWarningRegistry::get();
+  EXPECT_EQ(registry.hit_count("operator[] used"), 0u);
+
+  (*_segment)[0];
+  (*_segment)[1];
+  auto thread = std::thread{[&] { (*_segment)[0]; }};
+  thread.join();
+  {
+    PerformanceWarningDisabler pwd;
+    (*_segment)[0];
+  }
+
+  EXPECT_EQ(registry.hit_count("operator[] used"), 3u);
+  EXPECT_EQ(registry.hit_count("unknown warning"), 0u);
+
+  const auto snapshot = registry.snapshot();
+  ASSERT_EQ(snapshot.size(), 1u);
+  EXPECT_EQ(snapshot[0].text, "operator[] used");
+  EXPECT_NE(snapshot[0].location.find("storage/value_segment.cpp:"), std::string::npos);
+  EXPECT_EQ(snapshot[0].operator_name, "");
+  EXPECT_EQ(snapshot[0].count, 3u);
+
+  registry.reset();
+  EXPECT_TRUE(registry.snapshot().empty());
+}
+
+TEST_F(PerformanceWarningTest, AttributesHitsToOperators) {
+  auto& registry = PerformanceWarningRegistry::get();
+  {
+    const auto warning_scope = PerformanceWarningScope{registry.register_operator("Scan \"A\"")};
+    EXPECT_EQ(PerformanceWarningRegistry::current_operator(), registry.register_operator("Scan \"A\""));
+    // jobs on other threads are attributed to the operator as well
+    parallel_for(4, [&](const size_t index) { (*_segment)[index % 2]; });
+  }
+  EXPECT_EQ(PerformanceWarningRegistry::current_operator(), 0u);
+  (*_segment)[0];
+
+  const auto snapshot = registry.snapshot();
+  ASSERT_EQ(snapshot.size(), 2u);
+  EXPECT_EQ(snapshot[0].operator_name, "");
+  EXPECT_EQ(snapshot[0].count, 1u);
+  EXPECT_EQ(snapshot[1].operator_name, "Scan \"A\"");
+  EXPECT_EQ(snapshot[1].count, 4u);
+
+  auto out = std::stringstream{};
+  registry.write_snapshot(out);
+  const auto location = snapshot[0].location;
+  EXPECT_EQ(out.str(),
+            "# HELP performance_warning_hits How often slow paths were hit, per call site and operator.\n"
+            "# TYPE performance_warning_hits counter\n"
+            "performance_warning_hits{warning=\"operator[] used\",location=\"" +
+                location +
+                "\",operator=\"\"} 1\n"
+                "performance_warning_hits{warning=\"operator[] used\",location=\"" +
+                location + "\",operator=\"Scan \\\"A\\\"\"} 4\n");
+}
+
+}  // namespace opossum
@@ -0,0 +1,127 @@
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/storage_manager.hpp"
+#include "utils/load_table.hpp"
+#include "utils/tracer.hpp"
+
+namespace opossum {
+
+class TracerTest : public BaseTest {
+ protected:
+  void SetUp() override { Tracer::get().clear(); }
+
+  void TearDown() override {
+    Tracer::get().disable();
+    Tracer::get().clear();
+  }
+
+  static std::string chrome_trace() {
+    auto out = std::stringstream{};
+    Tracer::get().write_chrome_trace(out);
+    return out.str();
+  }
+
+  static size_t occurrences(const std::string& string, const std::string& pattern) {
+    auto count = size_t{0};
+    auto position = string.find(pattern);
+    while (position != std::string::npos) {
+      ++count;
+      position = string.find(pattern, position + 1);
+    }
+    return count;
+  }
+};
+
+TEST_F(TracerTest, DisabledRecordsNothing) {
+  EXPECT_FALSE(Tracer::is_enabled());
+  { const auto trace_scope = TraceScope{"test", [] { return std::string{"never built"}; }}; }
+  load_table("src/test/tables/int_float.tbl", 2);
+  EXPECT_EQ(Tracer::get().event_count(), 0u);
+  EXPECT_EQ(chrome_trace(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+TEST_F(TracerTest, RecordsOperatorsJobsCompressionAndLoading) {
+  Tracer::get().enable();
+  const auto table = load_table("src/test/tables/int_float.tbl", 2);
+  table->compress_chunk(ChunkID{0});
+  StorageManager::get().add_table("int_float", table);
+  auto scan = std::make_shared<TableScan>(std::make_shared<GetTable>("int_float"), ColumnID{0},
+                                          ScanType::OpGreaterThanEquals, 1234);
+  scan->execute();
+  Tracer::get().disable();
+
+  const auto trace = chrome_trace();
+  EXPECT_EQ(trace.find("{\"traceEvents\":[\n{\"name\":"), 0u);
+  EXPECT_NE(trace.find("{\"name\":\"load_table src/test/tables/int_float.tbl\",\"cat\":\"loader\",\"ph\":\"X\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"append rows\",\"cat\":\"loader\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"compress chunk 0\",\"cat\":\"compression\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_EQ(occurrences(trace, "{\"name\":\"compress segment\""), 2u);
+  EXPECT_NE(trace.find("{\"name\":\"TableScan #0 >= 1234\",\"cat\":\"operator\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"GetTable int_float\",\"cat\":\"operator\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_EQ(occurrences(trace, "\"cat\":\"job\",\"ph\":\"X\""), 2u);
+
+  // every span is one complete event with its duration
+  EXPECT_EQ(occurrences(trace, "\"ph\":\"X\""), Tracer::get().event_count());
+  EXPECT_EQ(occurrences(trace, "\"dur\":"), Tracer::get().event_count());
+}
+
+TEST_F(TracerTest, RingBufferKeepsNewestEvents) {
+  // the buffer of the calling thread may have been created before, so that the events are recorded by a new thread
+  Tracer::get().enable(4);
+  auto thread = std::thread{[] {
+    for (auto index = 0; index < 5; ++index) {
+      const auto trace_scope = TraceScope{"test", [&] { return "span \"" + std::to_string(index) + "\""; }};
+    }
+  }};
+  thread.join();
+  Tracer::get().disable();
+
+  EXPECT_EQ(Tracer::get().event_count(), 4u);
+  const auto trace = chrome_trace();
+  EXPECT_EQ(trace.find("span \\\"0\\\""), std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"span \\\"1\\\"\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"span \\\"4\\\"\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_LT(trace.find("span \\\"1\\\""), trace.find("span \\\"4\\\""));
+}
+
+TEST_F(TracerTest, RingBufferKeepsWholeNestedSpans) {
+  Tracer::get().enable(3);
+  auto thread = std::thread{[] {
+    for (auto index = 0; index < 2; ++index) {
+      const auto outer_scope = TraceScope{"test", "outer"};
+      const auto inner_scope = TraceScope{"test", "inner"};
+    }
+  }};
+  thread.join();
+  Tracer::get().disable();
+
+  // the oldest span, i.e., the first inner one, is overwritten, but the kept spans still have their durations
+  const auto trace = chrome_trace();
+  EXPECT_EQ(occurrences(trace, "\"name\":\"outer\""), 2u);
+  EXPECT_EQ(occurrences(trace, "\"name\":\"inner\""), 1u);
+  EXPECT_EQ(occurrences(trace, "\"dur\":"), 3u);
+}
+
+TEST_F(TracerTest, KeepsFormattingOfStream) {
+  Tracer::get().enable();
+  { const auto trace_scope = TraceScope{"test", "span"}; }
+  Tracer::get().disable();
+
+  auto out = std::stringstream{};
+  out << std::setprecision(2) << std::setfill('*');
+  Tracer::get().write_chrome_trace(out);
+  out << std::setw(6) << 1.2345;
+  EXPECT_EQ(out.str().substr(out.str().size() - 6), "***1.2");
+}
+
+}  // namespace opossum